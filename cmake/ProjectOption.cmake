@@ -10,6 +10,8 @@ include(CompilerWarning)
 include(Coverage)
 include(Utility)
 
+option(ENABLE_NATIVE_ARCH "Compile for the CPU of the build machine (-march=native)" ON)
+
 function (configure_project_target)
   cmake_parse_arguments("" "" "TARGET;CXX_STD" "" ${ARGN})
 
@@ -39,7 +41,12 @@ function (configure_project_target)
     INTERFACE $<$<AND:$<CXX_COMPILER_ID:MSVC>,$<NOT:$<VERSION_LESS:$<CXX_COMPILER_VERSION>,19.14>>>:/external:W0 /external:anglebrackets>
               # vs 16.10 (19.29.30037) no longer need the /experimental:external flag to use the /external:*
               $<$<AND:$<CXX_COMPILER_ID:MSVC>,$<VERSION_LESS:$<CXX_COMPILER_VERSION>,19.29.30037>>:/experimental:external>)
-  target_compile_options(${_TARGET} INTERFACE $<$<OR:$<CXX_COMPILER_ID:GNU>,${MATCH_CLANG_COMPILER_ID_GENEX}>:-march=native>)
+
+  # off, the binaries run on any CPU of the architecture, the simd kernels (include/simd.hpp) still pick the best
+  # instruction set at run time
+  if (${ENABLE_NATIVE_ARCH})
+    target_compile_options(${_TARGET} INTERFACE $<$<OR:$<CXX_COMPILER_ID:GNU>,${MATCH_CLANG_COMPILER_ID_GENEX}>:-march=native>)
+  endif ()
 endfunction ()
 
 function (configure_project_option)
@@ -0,0 +1,33 @@
+#ifndef ALLOCATIONS_HPP_
+#define ALLOCATIONS_HPP_
+
+#include <cstddef>
+
+// Heap accounting of the benchmarks. It replaces the global operator new / delete, hence is opt-in: configure with
+// -DENABLE_ALLOCATION_COUNTING=ON to link src/bench/allocation_counter.cpp into the bench_<year>_dayN binaries. The
+// functions below are only defined then, guard their calls with COUNTS_ALLOCATIONS
+namespace aoc::bench {
+
+#if defined(AOC_COUNT_ALLOCATIONS)
+inline constexpr bool COUNTS_ALLOCATIONS = true;
+#else
+inline constexpr bool COUNTS_ALLOCATIONS = false;
+#endif
+
+// heap usage since the last reset_allocation_stats
+struct AllocationStats {
+  std::size_t allocations_     = 0;  // calls to operator new
+  std::size_t allocated_bytes_ = 0;  // bytes asked for by all of them
+  std::size_t peak_live_bytes_ = 0;  // largest amount allocated at once, on top of what was live at the reset
+  std::size_t peak_rss_bytes_  = 0;  // peak resident set size of the process, 0 when unknown
+};
+
+// starts counting from 0, also resets the peak resident set size when the OS allows it (Linux >= 4.0), otherwise the
+// peak is the one of the whole process
+void reset_allocation_stats() noexcept;
+
+[[nodiscard]] AllocationStats allocation_stats() noexcept;
+
+}  // namespace aoc::bench
+
+#endif
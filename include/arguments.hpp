@@ -0,0 +1,116 @@
+#ifndef ARGUMENTS_HPP_
+#define ARGUMENTS_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <fmt/format.h>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace aoc {
+
+// Command line shared by everything that runs solutions
+//
+//    --year <year>       only run the days of this year
+//    --day <day>         only run this day
+//    --part <part>       only run this part, "1", "2" or the name of an alternative implementation
+//    --input <path|->    read the input from path ("-" for stdin) instead of the default one, the selection must match
+//                        a single day
+//    --input-dir <dir>   read the input of every selected day from <dir>/<year>/day<day>.txt
+//    --threads <n>       threads of the pool the days run their parallel work on (see thread_pool.hpp), the hardware
+//                        concurrency by default
+//
+// without --input / --input-dir, a day reads the input that is next to its source (INPUT_FILE)
+struct Arguments {
+  std::optional<int> year_;
+  std::optional<int> day_;
+  std::optional<std::string_view> part_;
+  std::optional<std::string_view> input_;
+  std::optional<std::string_view> input_dir_;
+  std::optional<int> threads_;
+
+  [[nodiscard]] bool reads_stdin() const noexcept { return this->input_ == "-"; }
+};
+
+inline constexpr std::string_view ARGUMENTS_USAGE =
+  "[--year <year>] [--day <day>] [--part <part>] [--input <path|->] [--input-dir <dir>] [--threads <n>]";
+
+namespace detail {
+
+[[nodiscard]] inline std::optional<int> to_int(std::string_view const t_str) noexcept {
+  int ret_val = 0;
+  auto const* const end = t_str.data() + t_str.size();
+  if (auto const [ptr, ec] = std::from_chars(t_str.data(), end, ret_val); ec != std::errc() or ptr != end) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+}  // namespace detail
+
+// returns std::nullopt when an option is unknown, misses its value or when --input and --input-dir are both given
+[[nodiscard]] inline std::optional<Arguments> parse_arguments(std::span<char* const> const t_args) {
+  using namespace std::string_view_literals;
+
+  Arguments ret_val;
+  for (std::size_t i = 1; i < t_args.size(); ++i) {
+    auto const arg = std::string_view{t_args[i]};
+    if (i + 1 == t_args.size()) {
+      return std::nullopt;
+    }
+
+    auto const value = std::string_view{t_args[++i]};
+    if (arg == "--year"sv) {
+      ret_val.year_ = detail::to_int(value);
+      if (not ret_val.year_) {
+        return std::nullopt;
+      }
+    } else if (arg == "--day"sv) {
+      ret_val.day_ = detail::to_int(value);
+      if (not ret_val.day_) {
+        return std::nullopt;
+      }
+    } else if (arg == "--part"sv) {
+      ret_val.part_ = value;
+    } else if (arg == "--input"sv) {
+      ret_val.input_ = value;
+    } else if (arg == "--input-dir"sv) {
+      ret_val.input_dir_ = value;
+    } else if (arg == "--threads"sv) {
+      ret_val.threads_ = detail::to_int(value);
+      if (not ret_val.threads_ or *ret_val.threads_ < 1) {
+        return std::nullopt;
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  if (ret_val.input_ and ret_val.input_dir_) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+// the file a day reads its input from ("-" for stdin), t_default is the path compiled into the day
+[[nodiscard]] inline std::string input_path(Arguments const& t_args, int const t_year, int const t_day,
+                                            std::string_view const t_default) {
+  if (t_args.input_) {
+    return std::string{*t_args.input_};
+  }
+
+  if (t_args.input_dir_) {
+    return fmt::format("{}/{}/day{}.txt", *t_args.input_dir_, t_year, t_day);
+  }
+
+  return std::string{t_default};
+}
+
+}  // namespace aoc
+
+#endif
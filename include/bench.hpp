@@ -0,0 +1,406 @@
+#ifndef BENCH_HPP_
+#define BENCH_HPP_
+
+#include "allocations.hpp"
+#include "json.hpp"
+#include "metrics.hpp"
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace aoc::bench {
+
+struct Config {
+  std::size_t warmup_  = 3;   // runs before measuring, to warm up caches and the branch predictor
+  std::size_t repeats_ = 20;  // measured runs
+};
+
+// statistics over the measured runs, robust to the occasional run disturbed by the OS
+struct Stats {
+  double median_ns_ = 0;
+  double mad_ns_    = 0;  // median absolute deviation from the median
+  double min_ns_    = 0;
+  double cycles_    = 0;  // median cycles per run, 0 when there is no cycle counter
+
+  std::vector<double> samples_ns_;  // every measured run, in order, for significance tests
+};
+
+// Reference cycles (the TSC on x86), they tick at a constant rate whatever the core frequency is, hence are only an
+// approximation of core cycles. 0 on architectures without one
+[[nodiscard]] inline std::uint64_t read_cycle_counter() noexcept {
+#if defined(__x86_64__) or defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// keeps the compiler from optimizing away a result that is never used
+template <typename T>
+void do_not_optimize(T const& t_value) noexcept {
+#if defined(__GNUC__)
+  asm volatile("" : : "g"(&t_value) : "memory");
+#else
+  static_cast<void>(t_value);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+namespace detail {
+
+[[nodiscard]] inline double median(std::vector<double> t_samples) {
+  if (t_samples.empty()) {
+    return 0;
+  }
+
+  auto const mid = t_samples.begin() + static_cast<std::ptrdiff_t>(t_samples.size() / 2);
+  std::nth_element(t_samples.begin(), mid, t_samples.end());
+  if (t_samples.size() % 2 == 1) {
+    return *mid;
+  }
+
+  return (*mid + *std::max_element(t_samples.begin(), mid)) / 2;
+}
+
+}  // namespace detail
+
+[[nodiscard]] inline Stats summarize(std::span<double const> const t_ns, std::span<double const> const t_cycles) {
+  if (t_ns.empty()) {
+    return {};
+  }
+
+  auto const median = detail::median({t_ns.begin(), t_ns.end()});
+
+  std::vector<double> deviations;
+  deviations.reserve(t_ns.size());
+  std::ranges::transform(t_ns, std::back_inserter(deviations),
+                         [=](double const t_sample) { return std::abs(t_sample - median); });
+
+  return Stats{.median_ns_  = median,
+               .mad_ns_     = detail::median(std::move(deviations)),
+               .min_ns_     = std::ranges::min(t_ns),
+               .cycles_     = detail::median({t_cycles.begin(), t_cycles.end()}),
+               .samples_ns_ = {t_ns.begin(), t_ns.end()}};
+}
+
+// runs t_fn t_config.warmup_ times, then measures t_config.repeats_ runs of it
+template <std::invocable Fn>
+[[nodiscard]] Stats measure(Fn&& t_fn, Config const& t_config) {
+  using Clock = std::chrono::steady_clock;
+  using Ns    = std::chrono::duration<double, std::nano>;
+
+  for (std::size_t i = 0; i < t_config.warmup_; ++i) {
+    do_not_optimize(std::invoke(t_fn));
+  }
+
+  std::vector<double> ns;
+  std::vector<double> cycles;
+  ns.reserve(t_config.repeats_);
+  cycles.reserve(t_config.repeats_);
+  for (std::size_t i = 0; i < t_config.repeats_; ++i) {
+    auto const start_time   = Clock::now();
+    auto const start_cycles = read_cycle_counter();
+    do_not_optimize(std::invoke(t_fn));
+    auto const end_cycles = read_cycle_counter();
+    auto const end_time   = Clock::now();
+
+    ns.push_back(Ns{end_time - start_time}.count());
+    cycles.push_back(static_cast<double>(end_cycles - start_cycles));
+  }
+
+  return summarize(ns, cycles);
+}
+
+// heap usage of one more run of t_fn, std::nullopt unless the allocations are counted (see allocations.hpp)
+template <std::invocable Fn>
+[[nodiscard]] std::optional<AllocationStats> measure_memory([[maybe_unused]] Fn&& t_fn) {
+  if constexpr (COUNTS_ALLOCATIONS) {
+    reset_allocation_stats();
+    do_not_optimize(std::invoke(t_fn));
+    return allocation_stats();
+  } else {
+    return std::nullopt;
+  }
+}
+
+// Hardware counts of t_config.repeats_ more runs of t_fn, the median of every event. std::nullopt when t_counters
+// can't count anything, t_fn isn't even run then
+template <std::invocable Fn>
+[[nodiscard]] std::optional<HardwareCounts> measure_counters(PerfCounters& t_counters, Fn&& t_fn,
+                                                             Config const& t_config) {
+  if (not t_counters.available()) {
+    return std::nullopt;
+  }
+
+  std::array<std::vector<double>, HARDWARE_EVENTS.size()> samples;
+  for (std::size_t i = 0; i < t_config.repeats_; ++i) {
+    t_counters.start();
+    do_not_optimize(std::invoke(t_fn));
+    auto const counts = t_counters.stop();
+
+    for (std::size_t j = 0; j < HARDWARE_EVENTS.size(); ++j) {
+      if (auto const& count = counts.*HARDWARE_EVENTS[j].count_; count) {
+        samples[j].push_back(*count);
+      }
+    }
+  }
+
+  HardwareCounts ret_val;
+  for (std::size_t j = 0; j < HARDWARE_EVENTS.size(); ++j) {
+    if (not samples[j].empty()) {
+      ret_val.*HARDWARE_EVENTS[j].count_ = detail::median(std::move(samples[j]));
+    }
+  }
+
+  return ret_val;
+}
+
+using Metrics = std::vector<std::pair<std::string, double>>;
+
+// what the searches of one more run of t_fn record (see metrics.hpp), std::nullopt unless the metrics are enabled
+template <std::invocable Fn>
+[[nodiscard]] std::optional<Metrics> measure_metrics([[maybe_unused]] Fn&& t_fn) {
+  if constexpr (metrics::ENABLED) {
+    metrics::registry().reset();
+    do_not_optimize(std::invoke(t_fn));
+    return metrics::registry().snapshot();
+  } else {
+    return std::nullopt;
+  }
+}
+
+struct Measurement {
+  std::string name_;  // "parse" or the name of a part
+  Stats stats_;
+  std::optional<AllocationStats> memory_;   // heap usage of one run, only when the allocations are counted
+  std::optional<HardwareCounts> counters_;  // only when the hardware counters are available
+  std::optional<Metrics> metrics_;          // only when the metrics are enabled
+};
+
+struct DayReport {
+  int year_;
+  int day_;
+  std::string input_;
+  std::size_t input_bytes_ = 0;
+  std::optional<std::size_t> size_;  // size of the generated input, only when it is one (see input_gen.hpp)
+  std::vector<Measurement> measurements_;
+};
+
+struct Run {
+  Config config_;
+  std::vector<DayReport> days_;
+};
+
+namespace detail {
+
+[[nodiscard]] inline std::string json_escape(std::string_view const t_str) {
+  std::string ret_val;
+  ret_val.reserve(t_str.size());
+  for (auto const chr : t_str) {
+    if (chr == '"' or chr == '\\') {
+      ret_val.push_back('\\');
+      ret_val.push_back(chr);
+    } else if (static_cast<unsigned char>(chr) < 0x20) {
+      ret_val += fmt::format("\\u{:04x}", static_cast<int>(chr));
+    } else {
+      ret_val.push_back(chr);
+    }
+  }
+
+  return ret_val;
+}
+
+}  // namespace detail
+
+// cycles spent per byte of input, null when there is no cycle counter or no input
+[[nodiscard]] inline std::string cycles_per_byte(Stats const& t_stats, std::size_t const t_bytes) {
+  if (t_stats.cycles_ == 0 or t_bytes == 0) {
+    return "null";
+  }
+
+  return fmt::format("{:.4f}", t_stats.cycles_ / static_cast<double>(t_bytes));
+}
+
+// {"config": {...}, "days": [{"year": 2022, "day": 1, ..., "measurements": [{"name": "parse", ...}, ...]}, ...]}, the
+// days run on a generated input also have its "size", the measurements with hardware counters a "counters" object and
+// those with metrics a "metrics" one
+[[nodiscard]] inline std::string to_json(std::span<DayReport const> const t_reports, Config const& t_config) {
+  std::string ret_val =
+    fmt::format(R"({{"config": {{"warmup": {}, "repeats": {}}}, "days": [)", t_config.warmup_, t_config.repeats_);
+
+  for (std::size_t i = 0; i < t_reports.size(); ++i) {
+    auto const& report = t_reports[i];
+    ret_val += fmt::format(R"({}{{"year": {}, "day": {}, "input": "{}", "input_bytes": {}, )", i == 0 ? "" : ", ",
+                           report.year_, report.day_, detail::json_escape(report.input_), report.input_bytes_);
+    if (report.size_) {
+      ret_val += fmt::format(R"("size": {}, )", *report.size_);
+    }
+
+    ret_val += R"("measurements": [)";
+
+    for (std::size_t j = 0; j < report.measurements_.size(); ++j) {
+      auto const& [name, stats, memory, counters, metrics] = report.measurements_[j];
+      ret_val += fmt::format(R"({}{{"name": "{}", "median_ns": {:.1f}, "mad_ns": {:.1f}, "min_ns": {:.1f}, )",
+                             j == 0 ? "" : ", ", detail::json_escape(name), stats.median_ns_, stats.mad_ns_,
+                             stats.min_ns_);
+      ret_val += fmt::format(R"("cycles": {:.0f}, "cycles_per_byte": {}, "samples_ns": [{:.1f}])", stats.cycles_,
+                             cycles_per_byte(stats, report.input_bytes_), fmt::join(stats.samples_ns_, ", "));
+      if (memory) {
+        ret_val += fmt::format(R"(, "allocations": {}, "allocated_bytes": {}, "peak_live_bytes": {}, )",
+                               memory->allocations_, memory->allocated_bytes_, memory->peak_live_bytes_);
+        ret_val += fmt::format(R"("peak_rss_bytes": {})", memory->peak_rss_bytes_);
+      }
+
+      if (counters) {
+        ret_val += R"(, "counters": {)";
+        for (std::size_t k = 0; k < HARDWARE_EVENTS.size(); ++k) {
+          auto const& count = (*counters).*HARDWARE_EVENTS[k].count_;
+          ret_val += fmt::format(R"({}"{}": {})", k == 0 ? "" : ", ", HARDWARE_EVENTS[k].name_,
+                                 count ? fmt::format("{:.0f}", *count) : "null");
+        }
+
+        ret_val += "}";
+      }
+
+      if (metrics) {
+        ret_val += R"(, "metrics": {)";
+        for (std::size_t k = 0; k < metrics->size(); ++k) {
+          ret_val += fmt::format(R"({}"{}": {})", k == 0 ? "" : ", ", detail::json_escape((*metrics)[k].first),
+                                 (*metrics)[k].second);
+        }
+
+        ret_val += "}";
+      }
+
+      ret_val += "}";
+    }
+
+    ret_val += "]}";
+  }
+
+  ret_val += "]}\n";
+  return ret_val;
+}
+
+// reads back what to_json wrote, std::nullopt if t_json isn't such a document
+[[nodiscard]] inline std::optional<Run> from_json(std::string_view const t_json) {
+  auto const document = json::parse(t_json);
+  if (not document) {
+    return std::nullopt;
+  }
+
+  auto const* const config = document->find("config");
+  auto const* const days   = document->find("days");
+  if (config == nullptr or days == nullptr or days->get_if<json::Value::Array>() == nullptr) {
+    return std::nullopt;
+  }
+
+  Run ret_val{.config_ = {.warmup_  = static_cast<std::size_t>(config->number("warmup").value_or(0)),
+                          .repeats_ = static_cast<std::size_t>(config->number("repeats").value_or(0))},
+              .days_   = {}};
+
+  for (auto const& day : *days->get_if<json::Value::Array>()) {
+    auto const year         = day.number("year");
+    auto const day_num      = day.number("day");
+    auto const* const input = day.find("input");
+    auto const* const list  = day.find("measurements");
+    if (not year or not day_num or input == nullptr or input->get_if<std::string>() == nullptr or list == nullptr or
+        list->get_if<json::Value::Array>() == nullptr) {
+      return std::nullopt;
+    }
+
+    auto const size = day.number("size");
+    auto& report    = ret_val.days_.emplace_back(
+      DayReport{.year_         = static_cast<int>(*year),
+                .day_          = static_cast<int>(*day_num),
+                .input_        = *input->get_if<std::string>(),
+                .input_bytes_  = static_cast<std::size_t>(day.number("input_bytes").value_or(0)),
+                .size_         = size ? std::optional{static_cast<std::size_t>(*size)} : std::nullopt,
+                .measurements_ = {}});
+
+    for (auto const& measurement : *list->get_if<json::Value::Array>()) {
+      auto const* const name = measurement.find("name");
+      auto const median      = measurement.number("median_ns");
+      if (name == nullptr or name->get_if<std::string>() == nullptr or not median) {
+        return std::nullopt;
+      }
+
+      Stats stats{.median_ns_  = *median,
+                  .mad_ns_     = measurement.number("mad_ns").value_or(0),
+                  .min_ns_     = measurement.number("min_ns").value_or(*median),
+                  .cycles_     = measurement.number("cycles").value_or(0),
+                  .samples_ns_ = {}};
+      if (auto const* const samples = measurement.find("samples_ns");
+          samples != nullptr and samples->get_if<json::Value::Array>() != nullptr) {
+        for (auto const& sample : *samples->get_if<json::Value::Array>()) {
+          if (auto const* const sample_ns = sample.get_if<double>(); sample_ns != nullptr) {
+            stats.samples_ns_.push_back(*sample_ns);
+          }
+        }
+      }
+
+      std::optional<AllocationStats> memory;
+      if (auto const allocations = measurement.number("allocations"); allocations) {
+        auto const to_size = [&](std::string_view const t_key) {
+          return static_cast<std::size_t>(measurement.number(t_key).value_or(0));
+        };
+
+        memory = AllocationStats{.allocations_     = static_cast<std::size_t>(*allocations),
+                                 .allocated_bytes_ = to_size("allocated_bytes"),
+                                 .peak_live_bytes_ = to_size("peak_live_bytes"),
+                                 .peak_rss_bytes_  = to_size("peak_rss_bytes")};
+      }
+
+      std::optional<HardwareCounts> counters;
+      if (auto const* const counts = measurement.find("counters"); counts != nullptr) {
+        counters.emplace();
+        for (auto const& event : HARDWARE_EVENTS) {
+          (*counters).*event.count_ = counts->number(event.name_);
+        }
+      }
+
+      std::optional<Metrics> metrics;
+      if (auto const* const values = measurement.find("metrics");
+          values != nullptr and values->get_if<json::Value::Object>() != nullptr) {
+        metrics.emplace();
+        for (auto const& [key, value] : *values->get_if<json::Value::Object>()) {
+          if (auto const* const number = value.get_if<double>(); number != nullptr) {
+            metrics->emplace_back(key, *number);
+          }
+        }
+      }
+
+      report.measurements_.push_back(Measurement{.name_     = *name->get_if<std::string>(),
+                                                 .stats_    = std::move(stats),
+                                                 .memory_   = memory,
+                                                 .counters_ = counters,
+                                                 .metrics_  = std::move(metrics)});
+    }
+  }
+
+  return ret_val;
+}
+
+}  // namespace aoc::bench
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef BFS_HPP_
+#define BFS_HPP_
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// One bit per node of a graph, the nodes are numbered [0, size)
+class VisitedSet {
+  static constexpr std::size_t WORD_BITS = 64;
+
+  std::vector<std::uint64_t> words_;
+
+ public:
+  VisitedSet() = default;
+  explicit VisitedSet(std::size_t const t_size) : words_((t_size + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+  [[nodiscard]] bool contains(std::size_t const t_node) const noexcept {
+    return ((this->words_[t_node / WORD_BITS] >> (t_node % WORD_BITS)) & 1U) != 0;
+  }
+
+  // returns whether t_node wasn't in the set yet
+  bool insert(std::size_t const t_node) noexcept {
+    auto& word     = this->words_[t_node / WORD_BITS];
+    auto const bit = std::uint64_t{1} << (t_node % WORD_BITS);
+    if ((word & bit) != 0) {
+      return false;
+    }
+
+    word |= bit;
+    return true;
+  }
+
+  // insert, from several threads at once. Only one of the threads inserting the same node gets true
+  bool insert_concurrent(std::size_t const t_node) noexcept {
+    std::atomic_ref word{this->words_[t_node / WORD_BITS]};
+    auto const bit = std::uint64_t{1} << (t_node % WORD_BITS);
+    if ((word.load(std::memory_order_relaxed) & bit) != 0) {  // most of the neighbours were visited already
+      return false;
+    }
+
+    return (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+  }
+
+  void erase(std::size_t const t_node) noexcept {
+    this->words_[t_node / WORD_BITS] &= ~(std::uint64_t{1} << (t_node % WORD_BITS));
+  }
+
+  void clear() noexcept { std::ranges::fill(this->words_, 0); }
+
+  // 64 nodes a word, node i is bit i % 64 of word i / 64
+  [[nodiscard]] std::span<std::uint64_t> words() noexcept { return this->words_; }
+  [[nodiscard]] std::span<std::uint64_t const> words() const noexcept { return this->words_; }
+};
+
+// Level synchronous breadth first search over a graph of t_node_count nodes numbered [0, t_node_count), e.g. the flat
+// indices of a Grid2D. The graph is implicit: t_neighbors(node) is a range of the nodes next to it and t_edge(from, to)
+// tells whether the search goes along that edge (the border of the grid, a wall, a height out of reach...):
+//
+//    aoc::Bfs bfs{map.cells().size(), std::array{start}};
+//    auto const steps = bfs.find([&](std::size_t const t_idx) { return map.neighbors4(t_idx); },
+//                                [&](std::size_t, std::size_t const t_to) { return map[t_to] != '#'; },
+//                                [&](std::size_t const t_idx) { return t_idx == end; });
+//
+// The whole frontier of a level is expanded at once into the next one, a node is visited once and the frontier is all
+// the nodes at that distance of the sources (every source is at level 0). With Revisit::EVERY_LEVEL a node is only
+// visited once per level instead, for the graphs that change from a level to the next (e.g. the time steps of a maze
+// whose walls move), the frontier is then every node reachable in exactly that many steps.
+//
+// With Execution::PARALLEL the large frontiers are expanded on the thread pool, t_neighbors and t_edge are then called
+// from several threads at once. It expands them top down (every node of the frontier tries its neighbours) while the
+// frontier is small compared to the nodes left, bottom up (every node left looks for a neighbour in the frontier) once
+// it is large, which then looks at far fewer edges. Going bottom up, the neighbours have to be symmetric (the edges
+// themselves can go one way only) and those out of [0, t_node_count) are skipped, the padding of a grid can have some
+class Bfs {
+ public:
+  enum class Revisit { NEVER, EVERY_LEVEL };
+  enum class Execution { SEQUENTIAL, PARALLEL };
+
+  static constexpr std::size_t UNREACHED = std::numeric_limits<std::size_t>::max();
+
+ private:
+  static constexpr std::size_t WORD_BITS = 64;
+
+  // smaller frontiers aren't worth handing to the pool
+  static constexpr std::size_t PARALLEL_FRONTIER = 4096;
+
+  // Beamer's heuristic, with the nodes standing for their edges (the graphs here all have a few edges per node): bottom
+  // up once the frontier is more than 1 / ALPHA of the nodes left, top down again once it is less than 1 / BETA of all
+  // the nodes
+  static constexpr std::size_t ALPHA = 14;
+  static constexpr std::size_t BETA  = 24;
+
+  std::size_t node_count_;
+  VisitedSet visited_;  // or the nodes of the frontier with Revisit::EVERY_LEVEL
+  std::size_t visited_count_ = 0;
+  std::vector<std::size_t> frontier_;
+  std::vector<std::size_t> next_;
+  std::size_t level_ = 0;
+  Revisit revisit_;
+  Execution execution_;
+
+  // for the parallel expansions: the next frontier found by every chunk, and the frontier as a set for bottom up
+  std::vector<std::vector<std::size_t>> chunk_next_;
+  VisitedSet frontier_set_;
+  bool bottom_up_ = false;
+
+  template <typename Neighbors, typename Edge>
+  void top_down(Neighbors const& t_neighbors, Edge const& t_edge) {
+    for (auto const node : this->frontier_) {
+      for (auto const neighbor : t_neighbors(node)) {
+        if (t_edge(node, neighbor) and this->visited_.insert(neighbor)) {
+          this->next_.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  // t_fn(begin, end, next) for t_count items split into chunks, every chunk fills a next of its own, they are appended
+  // to next_ afterward
+  template <typename Fn>
+  void for_each_chunk(std::size_t const t_count, Fn const& t_fn) {
+    auto const chunks = std::min(t_count, thread_pool().size() * 4);
+    this->chunk_next_.resize(chunks);
+
+    thread_pool().run(chunks, [&](std::size_t const t_chunk) {
+      auto& next = this->chunk_next_[t_chunk];
+      next.clear();
+      t_fn(t_count * t_chunk / chunks, t_count * (t_chunk + 1) / chunks, next);
+    });
+
+    for (auto const& next : this->chunk_next_) {
+      this->next_.insert(this->next_.end(), next.begin(), next.end());
+    }
+  }
+
+  template <typename Neighbors, typename Edge>
+  void top_down_parallel(Neighbors const& t_neighbors, Edge const& t_edge) {
+    auto const frontier = std::span<std::size_t const>{this->frontier_};
+    this->for_each_chunk(frontier.size(), [&](std::size_t const t_begin, std::size_t const t_end, auto& t_next) {
+      for (auto const node : frontier.subspan(t_begin, t_end - t_begin)) {
+        for (auto const neighbor : t_neighbors(node)) {
+          if (t_edge(node, neighbor) and this->visited_.insert_concurrent(neighbor)) {
+            t_next.push_back(neighbor);
+          }
+        }
+      }
+    });
+  }
+
+  // every chunk owns whole words of visited_, they are written without any atomic
+  template <typename Neighbors, typename Edge>
+  void bottom_up_parallel(Neighbors const& t_neighbors, Edge const& t_edge) {
+    if (this->frontier_set_.words().empty()) {
+      this->frontier_set_ = VisitedSet{this->node_count_};
+    }
+
+    this->frontier_set_.clear();
+    for (auto const node : this->frontier_) {
+      this->frontier_set_.insert(node);
+    }
+
+    auto const words = this->visited_.words();
+    this->for_each_chunk(words.size(), [&](std::size_t const t_begin, std::size_t const t_end, auto& t_next) {
+      for (auto w = t_begin; w < t_end; ++w) {
+        auto word = words[w];
+        for (auto left = ~word; left != 0; left &= left - 1) {
+          auto const node = w * WORD_BITS + static_cast<std::size_t>(std::countr_zero(left));
+          if (node >= this->node_count_) {
+            break;
+          }
+
+          for (auto const neighbor : t_neighbors(node)) {
+            if (neighbor < this->node_count_ and this->frontier_set_.contains(neighbor) and t_edge(neighbor, node)) {
+              word |= std::uint64_t{1} << (node % WORD_BITS);
+              t_next.push_back(node);
+              break;
+            }
+          }
+        }
+
+        words[w] = word;
+      }
+    });
+  }
+
+  [[nodiscard]] bool go_bottom_up() noexcept {
+    if (this->bottom_up_) {
+      this->bottom_up_ = this->frontier_.size() * BETA >= this->node_count_;
+    } else {
+      this->bottom_up_ = this->frontier_.size() * ALPHA > this->node_count_ - this->visited_count_;
+    }
+
+    return this->bottom_up_;
+  }
+
+ public:
+  template <typename Sources>
+  Bfs(std::size_t const t_node_count, Sources const& t_sources, Revisit const t_revisit = Revisit::NEVER,
+      Execution const t_execution = Execution::SEQUENTIAL)
+    : node_count_{t_node_count}, visited_{t_node_count}, revisit_{t_revisit}, execution_{t_execution} {
+    for (auto const source : t_sources) {
+      if (this->visited_.insert(source)) {
+        this->frontier_.push_back(source);
+      }
+    }
+
+    this->visited_count_ = this->frontier_.size();
+  }
+
+  [[nodiscard]] std::size_t level() const noexcept { return this->level_; }
+  [[nodiscard]] std::span<std::size_t const> frontier() const noexcept { return this->frontier_; }
+  [[nodiscard]] bool done() const noexcept { return this->frontier_.empty(); }
+
+  // whether t_node was reached, or is in the frontier with Revisit::EVERY_LEVEL
+  [[nodiscard]] bool visited(std::size_t const t_node) const noexcept { return this->visited_.contains(t_node); }
+
+  // the frontier of the next level
+  template <typename Neighbors, typename Edge>
+  void expand(Neighbors const& t_neighbors, Edge const& t_edge) {
+    if (this->revisit_ == Revisit::EVERY_LEVEL) {
+      for (auto const node : this->frontier_) {
+        this->visited_.erase(node);
+      }
+    }
+
+    this->next_.clear();
+    if (this->execution_ == Execution::SEQUENTIAL or this->frontier_.size() < PARALLEL_FRONTIER) {
+      this->top_down(t_neighbors, t_edge);
+    } else if (this->revisit_ == Revisit::NEVER and this->go_bottom_up()) {
+      this->bottom_up_parallel(t_neighbors, t_edge);
+    } else {
+      this->top_down_parallel(t_neighbors, t_edge);
+    }
+
+    this->frontier_.swap(this->next_);
+    this->visited_count_ += this->frontier_.size();
+    ++this->level_;
+  }
+
+  // the level of the first node t_is_target accepts, nullopt if none can be reached
+  template <typename Neighbors, typename Edge, typename IsTarget>
+  [[nodiscard]] std::optional<std::size_t> find(Neighbors const& t_neighbors, Edge const& t_edge,
+                                                IsTarget const& t_is_target) {
+    while (not this->done()) {
+      for (auto const node : this->frontier_) {
+        if (t_is_target(node)) {
+          return this->level_;
+        }
+      }
+
+      this->expand(t_neighbors, t_edge);
+    }
+
+    return std::nullopt;
+  }
+
+  // searches the whole graph, e.g. for the nodes visited afterward. Only with Revisit::NEVER, like distances
+  template <typename Neighbors, typename Edge>
+  void run(Neighbors const& t_neighbors, Edge const& t_edge) {
+    while (not this->done()) {
+      this->expand(t_neighbors, t_edge);
+    }
+  }
+
+  // the level of every node (UNREACHED for those that can't be reached), searches the whole graph. Only with
+  // Revisit::NEVER, a search that revisits the nodes may never end
+  template <typename Neighbors, typename Edge>
+  [[nodiscard]] std::vector<std::size_t> distances(Neighbors const& t_neighbors, Edge const& t_edge) {
+    std::vector<std::size_t> ret_val(this->node_count_, UNREACHED);
+    while (not this->done()) {
+      for (auto const node : this->frontier_) {
+        ret_val[node] = this->level_;
+      }
+
+      this->expand(t_neighbors, t_edge);
+    }
+
+    return ret_val;
+  }
+};
+
+}  // namespace aoc
+
+#endif
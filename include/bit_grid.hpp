@@ -0,0 +1,161 @@
+#ifndef BIT_GRID_HPP_
+#define BIT_GRID_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace aoc {
+
+// Grid of width x height cells of one bit, each row is a whole number of 64 bit words and cell (x, y) is bit x % 64 of
+// word x / 64 of row y. A whole grid is shifted, combined with another one or counted a word at a time, 64 cells per
+// instruction, which suits the cellular automaton like updates where every cell looks at its neighbours:
+//
+//    auto const crowded = elves & (elves.shifted(1, 0) | elves.shifted(-1, 0));  // an elf left or right of an elf
+//
+// The grids combined must have the same size. The bits past the width in the last word of a row are always 0
+class BitGrid {
+  static constexpr std::size_t WORD_BITS = 64;
+
+  std::size_t width_         = 0;
+  std::size_t height_        = 0;
+  std::size_t words_per_row_ = 0;
+  std::vector<std::uint64_t> words_;
+
+  // bit i of t_to is bit i - t_dx of t_from, the bits shifted in are 0
+  static void shift_row(std::span<std::uint64_t const> const t_from, std::span<std::uint64_t> const t_to,
+                        std::ptrdiff_t const t_dx) noexcept {
+    auto const word_bits  = static_cast<std::ptrdiff_t>(WORD_BITS);
+    auto const word_shift = t_dx >= 0 ? t_dx / word_bits : -((word_bits - 1 - t_dx) / word_bits);  // rounded down
+    auto const bit_shift  = static_cast<unsigned>(t_dx - word_shift * word_bits);
+
+    auto const word = [&](std::ptrdiff_t const t_idx) -> std::uint64_t {
+      return t_idx >= 0 and t_idx < std::ssize(t_from) ? t_from[static_cast<std::size_t>(t_idx)] : 0;
+    };
+
+    for (std::size_t i = 0; i < t_to.size(); ++i) {
+      auto const from = static_cast<std::ptrdiff_t>(i) - word_shift;
+      t_to[i]         = word(from) << bit_shift;
+      if (bit_shift != 0) {
+        t_to[i] |= word(from - 1) >> (WORD_BITS - bit_shift);
+      }
+    }
+  }
+
+  void clear_past_width() noexcept {
+    if (auto const used = this->width_ % WORD_BITS; used != 0) {
+      auto const mask = (std::uint64_t{1} << used) - 1;
+      for (std::size_t y = 0; y < this->height_; ++y) {
+        this->row(y).back() &= mask;
+      }
+    }
+  }
+
+ public:
+  BitGrid() = default;
+
+  BitGrid(std::size_t const t_width, std::size_t const t_height)
+    : width_{t_width},
+      height_{t_height},
+      words_per_row_{(t_width + WORD_BITS - 1) / WORD_BITS},
+      words_(this->words_per_row_ * t_height, 0) {}
+
+  [[nodiscard]] std::size_t width() const noexcept { return this->width_; }
+  [[nodiscard]] std::size_t height() const noexcept { return this->height_; }
+
+  [[nodiscard]] bool test(std::size_t const t_x, std::size_t const t_y) const noexcept {
+    return ((this->row(t_y)[t_x / WORD_BITS] >> (t_x % WORD_BITS)) & 1U) != 0;
+  }
+
+  void set(std::size_t const t_x, std::size_t const t_y) noexcept {
+    this->row(t_y)[t_x / WORD_BITS] |= std::uint64_t{1} << (t_x % WORD_BITS);
+  }
+
+  void reset(std::size_t const t_x, std::size_t const t_y) noexcept {
+    this->row(t_y)[t_x / WORD_BITS] &= ~(std::uint64_t{1} << (t_x % WORD_BITS));
+  }
+
+  [[nodiscard]] std::span<std::uint64_t> row(std::size_t const t_y) noexcept {
+    return std::span{this->words_}.subspan(t_y * this->words_per_row_, this->words_per_row_);
+  }
+
+  [[nodiscard]] std::span<std::uint64_t const> row(std::size_t const t_y) const noexcept {
+    return std::span{this->words_}.subspan(t_y * this->words_per_row_, this->words_per_row_);
+  }
+
+  // the cells moved by (t_dx, t_dy) into a t_width x t_height grid, those moved out of it are lost
+  [[nodiscard]] BitGrid resized(std::size_t const t_width, std::size_t const t_height, std::ptrdiff_t const t_dx,
+                                std::ptrdiff_t const t_dy) const {
+    BitGrid ret_val{t_width, t_height};
+    for (std::size_t y = 0; y < t_height; ++y) {
+      if (auto const from = static_cast<std::ptrdiff_t>(y) - t_dy;
+          from >= 0 and from < static_cast<std::ptrdiff_t>(this->height_)) {
+        shift_row(this->row(static_cast<std::size_t>(from)), ret_val.row(y), t_dx);
+      }
+    }
+
+    ret_val.clear_past_width();
+    return ret_val;
+  }
+
+  // cell (x, y) of the result is cell (x - t_dx, y - t_dy), e.g. shifted(0, 1) tells which cells have one above them
+  [[nodiscard]] BitGrid shifted(std::ptrdiff_t const t_dx, std::ptrdiff_t const t_dy) const {
+    return this->resized(this->width_, this->height_, t_dx, t_dy);
+  }
+
+  BitGrid& operator&=(BitGrid const& t_other) noexcept {
+    std::ranges::transform(this->words_, t_other.words_, this->words_.begin(), std::bit_and<>{});
+    return *this;
+  }
+
+  BitGrid& operator|=(BitGrid const& t_other) noexcept {
+    std::ranges::transform(this->words_, t_other.words_, this->words_.begin(), std::bit_or<>{});
+    return *this;
+  }
+
+  [[nodiscard]] friend BitGrid operator&(BitGrid t_lhs, BitGrid const& t_rhs) noexcept { return t_lhs &= t_rhs; }
+  [[nodiscard]] friend BitGrid operator|(BitGrid t_lhs, BitGrid const& t_rhs) noexcept { return t_lhs |= t_rhs; }
+
+  // the cells of t_lhs that aren't in t_rhs
+  [[nodiscard]] friend BitGrid and_not(BitGrid t_lhs, BitGrid const& t_rhs) noexcept {
+    std::ranges::transform(t_lhs.words_, t_rhs.words_, t_lhs.words_.begin(),
+                           [](std::uint64_t const t_word, std::uint64_t const t_not) { return t_word & ~t_not; });
+    return t_lhs;
+  }
+
+  [[nodiscard]] std::size_t count() const noexcept {
+    std::size_t ret_val = 0;
+    for (auto const word : this->words_) {
+      ret_val += static_cast<std::size_t>(std::popcount(word));
+    }
+
+    return ret_val;
+  }
+
+  [[nodiscard]] bool any() const noexcept {
+    return std::ranges::any_of(this->words_, [](std::uint64_t const t_word) { return t_word != 0; });
+  }
+
+  // t_fn(x, y) for every cell set, row by row
+  void for_each_set(auto&& t_fn) const {
+    for (std::size_t y = 0; y < this->height_; ++y) {
+      auto const words = this->row(y);
+      for (std::size_t i = 0; i < words.size(); ++i) {
+        for (auto word = words[i]; word != 0; word &= word - 1) {
+          t_fn(i * WORD_BITS + static_cast<std::size_t>(std::countr_zero(word)), y);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] bool operator==(BitGrid const&) const = default;
+};
+
+}  // namespace aoc
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef CYCLE_HPP_
+#define CYCLE_HPP_
+
+#include "flat_hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+
+// Cycle detection for the simulations that end up repeating themselves (the rocks of 2022 day 17, the blizzards of
+// day 24): the states 0, 1, 2... of the simulation are state mu + lambda == state mu from some mu on, and whatever the
+// simulation adds up every step (a height, a score) grows by the same amount every lambda steps. Step a billion is then
+// found from the first mu + lambda of them:
+//
+//    aoc::CycleDetector<State, StateHash> detector;
+//    std::vector<long long> heights;
+//    for (;;) {
+//      heights.push_back(height);
+//      if (auto const cycle = detector.push(state)) {
+//        return aoc::extrapolate(heights, *cycle, 1'000'000'000'000);
+//      }
+//      ...  // next step
+//    }
+//
+// CycleDetector keeps every state it is given in a FlatHashMap, a step costs a lookup whatever the number of steps so
+// far. A state too large to be kept can be replaced by its fingerprint, detect_cycle (Brent's algorithm) keeps only two
+// of them but needs the next state to be a pure function of the current one
+namespace aoc {
+
+struct Cycle {
+  std::size_t start_;   // mu, the first step of the cycle
+  std::size_t length_;  // lambda
+
+  // the step among the first start_ + length_ that step t_step is the same as
+  [[nodiscard]] constexpr std::uint64_t index(std::uint64_t const t_step) const noexcept {
+    return t_step < this->start_ ? t_step : this->start_ + (t_step - this->start_) % this->length_;
+  }
+};
+
+template <typename State, typename HashFn = Hash<State>>
+class CycleDetector {
+  FlatHashMap<State, std::size_t, HashFn> seen_;  // every state so far, to its step
+  std::size_t steps_ = 0;
+
+ public:
+  // the number of states pushed so far, the step of the next one
+  [[nodiscard]] std::size_t size() const noexcept { return this->steps_; }
+
+  // records the state of the next step, the cycle once that state was seen at an earlier step
+  [[nodiscard]] std::optional<Cycle> push(State const& t_state) {
+    auto const [iter, inserted] = this->seen_.try_emplace(t_state, this->steps_);
+    ++this->steps_;
+    if (inserted) {
+      return std::nullopt;
+    }
+
+    return Cycle{.start_ = iter->second, .length_ = this->steps_ - 1 - iter->second};
+  }
+};
+
+// Brent's algorithm: the cycle of t_start, t_next(t_start), t_next(t_next(t_start))... Only a couple of states are
+// alive at a time and they are compared with ==, t_next is called about 3 (mu + lambda) times
+template <typename State, typename Next>
+[[nodiscard]] Cycle detect_cycle(State const& t_start, Next const& t_next) {
+  // the length first: the tortoise waits at every power of 2 for the hare to come back to it
+  std::size_t power  = 1;
+  std::size_t length = 1;
+  State tortoise     = t_start;
+  State hare         = t_next(t_start);
+  while (tortoise != hare) {
+    if (power == length) {
+      tortoise = hare;
+      power *= 2;
+      length = 0;
+    }
+
+    hare = t_next(hare);
+    ++length;
+  }
+
+  // then the start: a hare length steps ahead meets the tortoise at the first step of the cycle
+  tortoise = t_start;
+  hare     = t_start;
+  for (std::size_t i = 0; i < length; ++i) {
+    hare = t_next(hare);
+  }
+
+  std::size_t start = 0;
+  while (tortoise != hare) {
+    tortoise = t_next(tortoise);
+    hare     = t_next(hare);
+    ++start;
+  }
+
+  return Cycle{.start_ = start, .length_ = length};
+}
+
+// the value at step t_step of a quantity that grows by the same amount every cycle, t_values being its value at the
+// steps [0, t_cycle.start_ + t_cycle.length_] at least (the steps pushed to the CycleDetector, up to the one that
+// closed the cycle)
+template <std::ranges::random_access_range Values>
+[[nodiscard]] auto extrapolate(Values const& t_values, Cycle const t_cycle, std::uint64_t const t_step) {
+  using T = std::ranges::range_value_t<Values>;
+
+  if (t_step < std::ranges::size(t_values)) {
+    return T{t_values[t_step]};
+  }
+
+  auto const cycles    = static_cast<T>((t_step - t_cycle.start_) / t_cycle.length_);
+  auto const per_cycle = t_values[t_cycle.start_ + t_cycle.length_] - t_values[t_cycle.start_];
+  return T{t_values[t_cycle.index(t_step)] + per_cycle * cycles};
+}
+
+// a 64 bit fingerprint of a range of values (anything Hash takes), order included, for the states too large to be kept
+// by a CycleDetector. Two of them colliding is unlikely well beyond the number of steps of any simulation here
+template <std::ranges::input_range Range>
+[[nodiscard]] std::uint64_t fingerprint(Range const& t_values) {
+  std::uint64_t ret_val = 0;
+  for (auto const& value : t_values) {
+    ret_val = mix(ret_val ^ Hash<std::ranges::range_value_t<Range>>{}(value));
+  }
+
+  return ret_val;
+}
+
+}  // namespace aoc
+
+#endif
@@ -0,0 +1,423 @@
+#ifndef FLAT_HASH_HPP_
+#define FLAT_HASH_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Open addressing hash set and map, the slots are one flat array next to an array of control bytes, a byte per slot
+// telling whether it is empty or, if not, 7 bits of the hash of its key. A lookup checks the control bytes of a group
+// of 16 slots at once (one SSE2 compare, part of every x86-64 CPU, hence no run time dispatch as in simd.hpp) and only
+// compares the keys whose 7 bits match, so it mostly reads one or two cache lines instead of walking the nodes of a
+// std::map or std::set:
+//
+//    aoc::FlatHashSet<std::pair<int, int>> visited;  // the coordinates are packed into one word, see aoc::pack
+//    if (visited.insert(coor).second) { ... }
+//
+// The keys and the values must be default constructible, a slot that isn't used holds a default constructed one. The
+// order of iteration is unspecified, an insertion can move every element (no reference stays valid)
+namespace aoc {
+
+// every bit of t_key changes about half of the bits of the hash (the finalizer of splitmix64), the coordinates of a
+// grid differ in a few low bits only
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t t_key) noexcept {
+  t_key ^= t_key >> 30U;
+  t_key *= std::uint64_t{0xbf58476d1ce4e5b9};
+  t_key ^= t_key >> 27U;
+  t_key *= std::uint64_t{0x94d049bb133111eb};
+  return t_key ^ (t_key >> 31U);
+}
+
+// two coordinates in one word, 32 bits each
+[[nodiscard]] constexpr std::uint64_t pack(std::integral auto const t_x, std::integral auto const t_y) noexcept {
+  return (static_cast<std::uint64_t>(t_x) << 32U) | (static_cast<std::uint64_t>(t_y) & std::uint64_t{0xffff'ffff});
+}
+
+// three coordinates in one word, 21 bits each
+[[nodiscard]] constexpr std::uint64_t pack(std::integral auto const t_x, std::integral auto const t_y,
+                                           std::integral auto const t_z) noexcept {
+  constexpr auto mask = (std::uint64_t{1} << 21U) - 1;
+  return ((static_cast<std::uint64_t>(t_x) & mask) << 42U) | ((static_cast<std::uint64_t>(t_y) & mask) << 21U) |
+         (static_cast<std::uint64_t>(t_z) & mask);
+}
+
+// the integers and the pairs of integers are packed then mixed, anything else mixes its std::hash
+template <typename Key>
+struct Hash {
+  [[nodiscard]] std::uint64_t operator()(Key const& t_key) const noexcept {
+    if constexpr (std::integral<Key>) {
+      return mix(static_cast<std::uint64_t>(t_key));
+    } else if constexpr (requires {
+                           requires std::integral<decltype(t_key.first)>;
+                           requires std::integral<decltype(t_key.second)>;
+                         }) {
+      return mix(pack(t_key.first, t_key.second));
+    } else {
+      return mix(std::hash<Key>{}(t_key));
+    }
+  }
+};
+
+namespace detail {
+
+// the control byte of a slot: empty, erased, or the low 7 bits of the hash of its key
+inline constexpr std::int8_t CTRL_EMPTY   = -128;
+inline constexpr std::int8_t CTRL_DELETED = -2;
+
+inline constexpr std::size_t GROUP_WIDTH = 16;
+
+// bit i is set when byte i of the group of t_ctrl is t_byte
+[[nodiscard]] inline std::uint32_t match_byte(std::int8_t const* const t_ctrl, std::int8_t const t_byte) noexcept {
+#if defined(__SSE2__)
+  auto const group = _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_ctrl));
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(t_byte))));
+#else
+  std::uint32_t ret_val = 0;
+  for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+    ret_val |= static_cast<std::uint32_t>(t_ctrl[i] == t_byte) << i;
+  }
+
+  return ret_val;
+#endif
+}
+
+// bit i is set when slot i of the group of t_ctrl is empty or erased, the only negative control bytes
+[[nodiscard]] inline std::uint32_t match_free(std::int8_t const* const t_ctrl) noexcept {
+#if defined(__SSE2__)
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(t_ctrl))));
+#else
+  std::uint32_t ret_val = 0;
+  for (std::size_t i = 0; i < GROUP_WIDTH; ++i) {
+    ret_val |= static_cast<std::uint32_t>(t_ctrl[i] < 0) << i;
+  }
+
+  return ret_val;
+#endif
+}
+
+// the table behind FlatHashSet (the slots are the keys) and FlatHashMap (the slots are pairs of a key and its value)
+template <typename Key, typename Slot, typename HashFn, typename KeyEqual>
+class FlatTable {
+  std::vector<std::int8_t> ctrl_;
+  std::vector<Slot> slots_;
+  std::size_t size_        = 0;
+  std::size_t growth_left_ = 0;  // empty slots that can still be used before the table is 7/8 full
+  [[no_unique_address]] HashFn hash_;
+  [[no_unique_address]] KeyEqual equal_;
+
+  [[nodiscard]] static Key const& key_of(Slot const& t_slot) noexcept {
+    if constexpr (std::is_same_v<Slot, Key>) {
+      return t_slot;
+    } else {
+      return t_slot.first;
+    }
+  }
+
+  // the groups t_hash probes, one after the other: 0, 1, 3, 6, ... groups away from the first one, which visits every
+  // group of a table whose number of groups is a power of 2
+  [[nodiscard]] std::size_t first_group(std::uint64_t const t_hash) const noexcept {
+    return (t_hash >> 7U) & (this->slots_.size() / GROUP_WIDTH - 1);
+  }
+
+  [[nodiscard]] std::size_t next_group(std::size_t const t_group, std::size_t const t_step) const noexcept {
+    return (t_group + t_step) & (this->slots_.size() / GROUP_WIDTH - 1);
+  }
+
+  [[nodiscard]] static std::int8_t h2(std::uint64_t const t_hash) noexcept {
+    return static_cast<std::int8_t>(t_hash & 0x7fU);
+  }
+
+  [[nodiscard]] std::size_t find_index(Key const& t_key, std::uint64_t const t_hash) const noexcept {
+    if (this->slots_.empty()) {
+      return NPOS;
+    }
+
+    for (std::size_t group = this->first_group(t_hash), step = 1;; group = this->next_group(group, step++)) {
+      auto const* const ctrl = this->ctrl_.data() + group * GROUP_WIDTH;
+      for (auto match = match_byte(ctrl, h2(t_hash)); match != 0; match &= match - 1) {
+        auto const idx = group * GROUP_WIDTH + static_cast<std::size_t>(std::countr_zero(match));
+        if (this->equal_(key_of(this->slots_[idx]), t_key)) {
+          return idx;
+        }
+      }
+
+      if (match_byte(ctrl, CTRL_EMPTY) != 0) {
+        return NPOS;
+      }
+    }
+  }
+
+  // the first empty or erased slot t_hash probes, the table has one
+  [[nodiscard]] std::size_t find_free(std::uint64_t const t_hash) const noexcept {
+    for (std::size_t group = this->first_group(t_hash), step = 1;; group = this->next_group(group, step++)) {
+      if (auto const free = match_free(this->ctrl_.data() + group * GROUP_WIDTH); free != 0) {
+        return group * GROUP_WIDTH + static_cast<std::size_t>(std::countr_zero(free));
+      }
+    }
+  }
+
+  void rehash(std::size_t const t_capacity) {
+    auto old_ctrl      = std::exchange(this->ctrl_, std::vector<std::int8_t>(t_capacity, CTRL_EMPTY));
+    auto old_slots     = std::exchange(this->slots_, std::vector<Slot>(t_capacity));
+    this->growth_left_ = t_capacity - t_capacity / 8 - this->size_;
+
+    for (std::size_t i = 0; i < old_slots.size(); ++i) {
+      if (old_ctrl[i] >= 0) {
+        auto const hash   = this->hash_(key_of(old_slots[i]));
+        auto const idx    = this->find_free(hash);
+        this->ctrl_[idx]  = h2(hash);
+        this->slots_[idx] = std::move(old_slots[i]);
+      }
+    }
+  }
+
+ protected:
+  static constexpr std::size_t NPOS = ~std::size_t{0};
+
+  // the slot of t_key, added with t_make_slot() if it isn't in the table yet (the second is true then)
+  template <typename MakeSlot>
+  std::pair<std::size_t, bool> find_or_add(Key const& t_key, MakeSlot&& t_make_slot) {
+    auto const hash = this->hash_(t_key);
+    if (auto const idx = this->find_index(t_key, hash); idx != NPOS) {
+      return {idx, false};
+    }
+
+    // full, unless the erased slots are most of it: rehashing at the same size frees them
+    if (auto const capacity = this->slots_.size(); this->growth_left_ == 0) {
+      this->rehash(std::max(GROUP_WIDTH, this->size_ < capacity / 2 ? capacity : capacity * 2));
+    }
+
+    auto const idx = this->find_free(hash);
+    if (this->ctrl_[idx] == CTRL_EMPTY) {
+      --this->growth_left_;
+    }
+
+    this->ctrl_[idx]  = h2(hash);
+    this->slots_[idx] = std::forward<MakeSlot>(t_make_slot)();
+    ++this->size_;
+    return {idx, true};
+  }
+
+  [[nodiscard]] Slot& slot(std::size_t const t_idx) noexcept { return this->slots_[t_idx]; }
+  [[nodiscard]] Slot const& slot(std::size_t const t_idx) const noexcept { return this->slots_[t_idx]; }
+
+  [[nodiscard]] std::size_t index_of(Key const& t_key) const noexcept {
+    return this->find_index(t_key, this->hash_(t_key));
+  }
+
+ public:
+  template <bool Const>
+  class Iterator {
+    using Table = std::conditional_t<Const, FlatTable const, FlatTable>;
+
+    Table* table_    = nullptr;
+    std::size_t idx_ = 0;
+
+    void skip_free() noexcept {
+      while (this->idx_ < this->table_->slots_.size() and this->table_->ctrl_[this->idx_] < 0) {
+        ++this->idx_;
+      }
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Slot;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::conditional_t<Const, Slot const&, Slot&>;
+    using pointer           = std::conditional_t<Const, Slot const*, Slot*>;
+
+    Iterator() = default;
+    Iterator(Table* const t_table, std::size_t const t_idx) noexcept : table_{t_table}, idx_{t_idx} {
+      this->skip_free();
+    }
+
+    // from an iterator to a const one
+    template <bool OtherConst>
+      requires(Const and not OtherConst)
+    Iterator(Iterator<OtherConst> const& t_other) noexcept : table_{t_other.table_}, idx_{t_other.idx_} {}
+
+    [[nodiscard]] reference operator*() const noexcept { return this->table_->slots_[this->idx_]; }
+    [[nodiscard]] pointer operator->() const noexcept { return &this->table_->slots_[this->idx_]; }
+
+    Iterator& operator++() noexcept {
+      ++this->idx_;
+      this->skip_free();
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      auto ret_val = *this;
+      ++*this;
+      return ret_val;
+    }
+
+    [[nodiscard]] bool operator==(Iterator const& t_other) const noexcept { return this->idx_ == t_other.idx_; }
+
+    friend Iterator<true>;
+  };
+
+  using key_type       = Key;
+  using value_type     = Slot;
+  using size_type      = std::size_t;
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatTable() = default;
+
+  [[nodiscard]] std::size_t size() const noexcept { return this->size_; }
+  [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+
+  [[nodiscard]] iterator begin() noexcept { return iterator{this, 0}; }
+  [[nodiscard]] iterator end() noexcept { return iterator{this, this->slots_.size()}; }
+  [[nodiscard]] const_iterator begin() const noexcept { return const_iterator{this, 0}; }
+  [[nodiscard]] const_iterator end() const noexcept { return const_iterator{this, this->slots_.size()}; }
+
+  // room for t_count elements without growing
+  void reserve(std::size_t const t_count) {
+    if (auto const capacity = std::max(GROUP_WIDTH, std::bit_ceil(t_count + t_count / 7 + 1));
+        capacity > this->slots_.size()) {
+      this->rehash(capacity);
+    }
+  }
+
+  void clear() noexcept {
+    std::ranges::fill(this->ctrl_, CTRL_EMPTY);
+    std::ranges::fill(this->slots_, Slot{});
+    this->size_        = 0;
+    this->growth_left_ = this->slots_.size() - this->slots_.size() / 8;
+  }
+
+  [[nodiscard]] bool contains(Key const& t_key) const noexcept { return this->index_of(t_key) != NPOS; }
+
+  [[nodiscard]] iterator find(Key const& t_key) noexcept {
+    auto const idx = this->index_of(t_key);
+    return idx == NPOS ? this->end() : iterator{this, idx};
+  }
+
+  [[nodiscard]] const_iterator find(Key const& t_key) const noexcept {
+    auto const idx = this->index_of(t_key);
+    return idx == NPOS ? this->end() : const_iterator{this, idx};
+  }
+
+  // the slot is marked as erased, not empty, the lookups of the keys that probed past it keep going
+  std::size_t erase(Key const& t_key) {
+    auto const idx = this->index_of(t_key);
+    if (idx == NPOS) {
+      return 0;
+    }
+
+    this->ctrl_[idx]  = CTRL_DELETED;
+    this->slots_[idx] = Slot{};
+    --this->size_;
+    return 1;
+  }
+};
+
+}  // namespace detail
+
+template <typename Key, typename HashFn = Hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public detail::FlatTable<Key, Key, HashFn, KeyEqual> {
+  using Base = detail::FlatTable<Key, Key, HashFn, KeyEqual>;
+
+ public:
+  using typename Base::iterator;
+
+  FlatHashSet() = default;
+
+  template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+  FlatHashSet(It t_first, Sentinel const t_last) {
+    this->insert(std::move(t_first), t_last);
+  }
+
+  std::pair<iterator, bool> insert(Key const& t_key) {
+    auto const [idx, inserted] = this->find_or_add(t_key, [&] { return t_key; });
+    return {iterator{this, idx}, inserted};
+  }
+
+  template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+  void insert(It t_first, Sentinel const t_last) {
+    for (; t_first != t_last; ++t_first) {
+      this->insert(*t_first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... t_args) {
+    return this->insert(Key(std::forward<Args>(t_args)...));
+  }
+};
+
+template <typename Key, typename Value, typename HashFn = Hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public detail::FlatTable<Key, std::pair<Key, Value>, HashFn, KeyEqual> {
+  using Base = detail::FlatTable<Key, std::pair<Key, Value>, HashFn, KeyEqual>;
+
+ public:
+  using typename Base::iterator;
+  using mapped_type = Value;
+
+  FlatHashMap() = default;
+
+  FlatHashMap(std::initializer_list<std::pair<Key, Value>> const t_kvs) {
+    this->reserve(t_kvs.size());
+    for (auto const& kv : t_kvs) {
+      this->insert(kv);
+    }
+  }
+
+  // the value of t_key, made from t_args if it isn't in the map yet (the second is true then)
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key const& t_key, Args&&... t_args) {
+    auto const [idx, inserted] = this->find_or_add(t_key, [&] {
+      return std::pair<Key, Value>{std::piecewise_construct, std::forward_as_tuple(t_key),
+                                   std::forward_as_tuple(std::forward<Args>(t_args)...)};
+    });
+    return {iterator{this, idx}, inserted};
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Key const& t_key, Args&&... t_args) {
+    return this->try_emplace(t_key, std::forward<Args>(t_args)...);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<Key, Value> const& t_kv) {
+    return this->try_emplace(t_kv.first, t_kv.second);
+  }
+
+  [[nodiscard]] Value& operator[](Key const& t_key) { return this->try_emplace(t_key).first->second; }
+
+  [[nodiscard]] Value& at(Key const& t_key) {
+    auto const idx = this->index_of(t_key);
+    if (idx == Base::NPOS) {
+      throw std::out_of_range("aoc::FlatHashMap::at");
+    }
+
+    return this->slot(idx).second;
+  }
+
+  [[nodiscard]] Value const& at(Key const& t_key) const {
+    auto const idx = this->index_of(t_key);
+    if (idx == Base::NPOS) {
+      throw std::out_of_range("aoc::FlatHashMap::at");
+    }
+
+    return this->slot(idx).second;
+  }
+};
+
+}  // namespace aoc
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef GRID_HPP_
+#define GRID_HPP_
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <range/v3/view/stride.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Dense row major grid of width x height cells, surrounded by a border of padding cells holding a sentinel. A search
+// can then step to a neighbour without checking the bounds first, as long as the sentinel is a cell it never enters (a
+// wall, a height out of reach...):
+//
+//    auto const map = aoc::Grid2D<char>::from_lines(t_input.lines(), 1, '#');
+//    for (auto const neighbor : map.neighbors4(map.index(x, y))) {
+//      if (map[neighbor] != '#') { ... }
+//    }
+//
+// A cell is addressed either by its coordinates, map[x, y] with x in [-padding, width + padding) and y likewise, or by
+// its flat index (see index), the neighbours of a flat index are a fixed offset away. T can't be bool, the rows are
+// spans of cells (use char instead)
+template <typename T>
+class Grid2D {
+  std::size_t width_   = 0;
+  std::size_t height_  = 0;
+  std::size_t padding_ = 0;
+  std::size_t stride_  = 0;  // from one row to the next, the padding included
+  std::vector<T> cells_;
+
+  // the cells of t_cells (cells_, const or not) from the top of column t_x to its bottom, none without a row or without
+  // any cell (e.g. a grid from no line, or from empty lines and no padding)
+  template <typename Cells>
+  [[nodiscard]] Cells column_cells(Cells const t_cells, std::size_t const t_x) const noexcept {
+    if (this->height_ == 0 or this->stride_ == 0) {
+      return {};
+    }
+
+    return t_cells.subspan(this->index(t_x, 0), (this->height_ - 1) * this->stride_ + 1);
+  }
+
+  // a stride of at least 1 for views::stride, a grid of stride 0 has no cell to step over anyway
+  [[nodiscard]] std::ptrdiff_t column_step() const noexcept {
+    return static_cast<std::ptrdiff_t>(std::max(this->stride_, std::size_t{1}));
+  }
+
+ public:
+  Grid2D() = default;
+
+  Grid2D(std::size_t const t_width, std::size_t const t_height, T const& t_fill = T{}, std::size_t const t_padding = 0,
+         T const& t_sentinel = T{})
+    : width_{t_width},
+      height_{t_height},
+      padding_{t_padding},
+      stride_{t_width + 2 * t_padding},
+      cells_(this->stride_ * (t_height + 2 * t_padding), t_sentinel) {
+    for (std::size_t y = 0; y < t_height; ++y) {
+      std::ranges::fill(this->row(y), t_fill);
+    }
+  }
+
+  // One row per line (e.g. the lines of a MappedInput, copied straight into the grid), the lines shorter than the
+  // longest one are completed with t_sentinel. t_transform turns a character into a cell
+  template <typename Lines, typename Transform = std::identity>
+  [[nodiscard]] static Grid2D from_lines(Lines const& t_lines, std::size_t const t_padding = 0,
+                                         T const& t_sentinel = T{}, Transform const& t_transform = {}) {
+    std::size_t width = 0;
+    for (auto const& line : t_lines) {
+      width = std::max(width, std::ranges::size(line));
+    }
+
+    Grid2D ret_val{width, std::ranges::size(t_lines), t_sentinel, t_padding, t_sentinel};
+    std::size_t y = 0;
+    for (auto const& line : t_lines) {
+      std::ranges::transform(line, ret_val.row(y++).begin(), std::ref(t_transform));
+    }
+
+    return ret_val;
+  }
+
+  [[nodiscard]] std::size_t width() const noexcept { return this->width_; }
+  [[nodiscard]] std::size_t height() const noexcept { return this->height_; }
+  [[nodiscard]] std::size_t padding() const noexcept { return this->padding_; }
+  [[nodiscard]] std::size_t stride() const noexcept { return this->stride_; }
+
+  // whether (t_x, t_y) is in the grid, not in its border
+  [[nodiscard]] bool contains(std::integral auto const t_x, std::integral auto const t_y) const noexcept {
+    return std::cmp_greater_equal(t_x, 0) and std::cmp_less(t_x, this->width_) and std::cmp_greater_equal(t_y, 0) and
+           std::cmp_less(t_y, this->height_);
+  }
+
+  // flat index of (t_x, t_y), the coordinates can be negative down to -padding
+  [[nodiscard]] std::size_t index(std::integral auto const t_x, std::integral auto const t_y) const noexcept {
+    auto const padding = static_cast<std::ptrdiff_t>(this->padding_);
+    auto const y       = static_cast<std::ptrdiff_t>(t_y) + padding;
+    auto const x       = static_cast<std::ptrdiff_t>(t_x) + padding;
+    return static_cast<std::size_t>(y * static_cast<std::ptrdiff_t>(this->stride_) + x);
+  }
+
+  // coordinates of a flat index, the reverse of index
+  [[nodiscard]] std::pair<std::ptrdiff_t, std::ptrdiff_t> coordinates(std::size_t const t_idx) const noexcept {
+    auto const padding = static_cast<std::ptrdiff_t>(this->padding_);
+    return {static_cast<std::ptrdiff_t>(t_idx % this->stride_) - padding,
+            static_cast<std::ptrdiff_t>(t_idx / this->stride_) - padding};
+  }
+
+  // right, left, down and up of a flat index. Unsigned arithmetic wraps around, adding an offset works both ways
+  [[nodiscard]] std::array<std::size_t, 4> offsets4() const noexcept {
+    return {1, ~std::size_t{0}, this->stride_, std::size_t{0} - this->stride_};
+  }
+
+  // offsets4, then the diagonals
+  [[nodiscard]] std::array<std::size_t, 8> offsets8() const noexcept {
+    auto const down = this->stride_;
+    auto const up   = std::size_t{0} - this->stride_;
+    return {1, ~std::size_t{0}, down, up, down + 1, down - 1, up + 1, up - 1};
+  }
+
+  [[nodiscard]] std::array<std::size_t, 4> neighbors4(std::size_t const t_idx) const noexcept {
+    return {t_idx + 1, t_idx - 1, t_idx + this->stride_, t_idx - this->stride_};
+  }
+
+  [[nodiscard]] T& operator[](std::size_t const t_idx) noexcept { return this->cells_[t_idx]; }
+  [[nodiscard]] T const& operator[](std::size_t const t_idx) const noexcept { return this->cells_[t_idx]; }
+
+  [[nodiscard]] T& operator[](std::integral auto const t_x, std::integral auto const t_y) noexcept {
+    return this->cells_[this->index(t_x, t_y)];
+  }
+
+  [[nodiscard]] T const& operator[](std::integral auto const t_x, std::integral auto const t_y) const noexcept {
+    return this->cells_[this->index(t_x, t_y)];
+  }
+
+  // the cells of row t_y, without the border
+  [[nodiscard]] std::span<T> row(std::size_t const t_y) noexcept {
+    return std::span{this->cells_}.subspan(this->index(0, t_y), this->width_);
+  }
+
+  [[nodiscard]] std::span<T const> row(std::size_t const t_y) const noexcept {
+    return std::span{this->cells_}.subspan(this->index(0, t_y), this->width_);
+  }
+
+  // the cells of column t_x, without the border, a stride apart
+  [[nodiscard]] auto column(std::size_t const t_x) noexcept {
+    auto const cells = this->column_cells(std::span{this->cells_}, t_x);
+    return cells | ranges::views::stride(this->column_step());
+  }
+
+  [[nodiscard]] auto column(std::size_t const t_x) const noexcept {
+    auto const cells = this->column_cells(std::span{this->cells_}, t_x);
+    return cells | ranges::views::stride(this->column_step());
+  }
+
+  // every cell, the border included, in the order of their flat index
+  [[nodiscard]] std::span<T> cells() noexcept { return this->cells_; }
+  [[nodiscard]] std::span<T const> cells() const noexcept { return this->cells_; }
+
+  [[nodiscard]] bool operator==(Grid2D const&) const = default;
+};
+
+}  // namespace aoc
+
+#endif
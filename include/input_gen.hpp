@@ -0,0 +1,110 @@
+#ifndef INPUT_GEN_HPP_
+#define INPUT_GEN_HPP_
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace aoc::gen {
+
+// xoshiro256** seeded with splitmix64. The standard engines are fine, but the distributions are implementation defined,
+// the same seed has to give the same input on every standard library so that benchmark baselines stay comparable
+class Rng {
+  std::array<std::uint64_t, 4> state_{};
+
+ public:
+  explicit constexpr Rng(std::uint64_t t_seed) noexcept {
+    for (auto& state : this->state_) {
+      t_seed += 0x9E3779B97F4A7C15ULL;
+      auto mixed = t_seed;
+      mixed      = (mixed ^ (mixed >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+      mixed      = (mixed ^ (mixed >> 27U)) * 0x94D049BB133111EBULL;
+      state      = mixed ^ (mixed >> 31U);
+    }
+  }
+
+  constexpr std::uint64_t operator()() noexcept {
+    auto& [s0, s1, s2, s3] = this->state_;
+
+    auto const ret_val = std::rotl(s1 * 5, 7) * 9;
+    auto const shifted = s1 << 17U;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= shifted;
+    s3 = std::rotl(s3, 45);
+
+    return ret_val;
+  }
+
+  // uniform in [t_min, t_max], the modulo bias is negligible for the ranges used here
+  template <std::integral T>
+  constexpr T uniform(T const t_min, T const t_max) noexcept {
+    auto const range = static_cast<std::uint64_t>(t_max) - static_cast<std::uint64_t>(t_min) + 1;
+    return range == 0 ? static_cast<T>((*this)()) : static_cast<T>(t_min + static_cast<T>((*this)() % range));
+  }
+
+  // true with probability t_probability
+  constexpr bool chance(double const t_probability) noexcept {
+    constexpr auto to_unit = 0x1.0p-53;  // the 53 high bits, as a double in [0, 1)
+    return static_cast<double>((*this)() >> 11U) * to_unit < t_probability;
+  }
+
+  template <typename T, std::size_t Extent>
+  constexpr T& pick(std::span<T, Extent> const t_choices) noexcept {
+    return t_choices[this->uniform<std::size_t>(0, t_choices.size() - 1)];
+  }
+
+  constexpr char pick(std::string_view const t_choices) noexcept {
+    return t_choices[this->uniform<std::size_t>(0, t_choices.size() - 1)];
+  }
+
+  // Fisher-Yates, std::shuffle isn't reproducible across standard libraries either
+  template <typename T, std::size_t Extent>
+  constexpr void shuffle(std::span<T, Extent> const t_values) noexcept {
+    for (std::size_t i = t_values.size(); i > 1; --i) {
+      std::swap(t_values[i - 1], t_values[this->uniform<std::size_t>(0, i - 1)]);
+    }
+  }
+};
+
+struct Params {
+  std::size_t size_;        // the main scale of the input, what it means depends on the day (see Generator)
+  std::uint64_t seed_ = 0;  // same seed and parameters, same input
+  std::size_t width_  = 0;  // second dimension of grid inputs, 0 for the day's default
+  double density_     = 0;  // fill ratio of sparse inputs, 0 for the day's default
+};
+
+// Generates a valid input of a day, i.e. one that the solution can solve (e.g. the height map of 2022 day 12 always has
+// a path from S to E). Sizes are clamped to what the solution supports, e.g. 2022 day 16 keys valves by bit in a 64 bit
+// word hence never has more than 64 valves
+struct Generator {
+  int year_;
+  int day_;
+  std::string_view size_;  // what Params::size_ is, e.g. "number of sensors"
+  std::string (*generate_)(Params const&);
+};
+
+// every generator, sorted by year then day
+[[nodiscard]] std::span<Generator const> generators() noexcept;
+
+// nullptr if the day has no generator
+[[nodiscard]] Generator const* find_generator(int t_year, int t_day) noexcept;
+
+// writes the input to <t_dir>/<year>/day<day>.txt, the layout the runner reads with --input-dir, and returns that path.
+// Throws std::system_error when the file can't be written
+std::filesystem::path write_input(Generator const& t_generator, Params const& t_params,
+                                  std::filesystem::path const& t_dir);
+
+}  // namespace aoc::gen
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef JOB_SCHEDULER_HPP_
+#define JOB_SCHEDULER_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace aoc {
+
+// Runs independent jobs on a fixed number of threads, the most expensive of the ready jobs first (longest processing
+// time first: the long jobs start early and the short ones fill the gaps, the whole run then takes about as long as
+// its longest chain of jobs). A running job can schedule more, e.g. the parts of a day once its input is parsed:
+//
+//    JobScheduler scheduler{jobs};
+//    scheduler.schedule(parse_cost, [&](JobScheduler& t_scheduler) {
+//      auto const parsed = parse();
+//      t_scheduler.schedule(part_cost, [=](JobScheduler&) { solve(parsed); });
+//    });
+//    scheduler.run();
+//
+// The jobs run on threads of their own, outside of the thread pool (thread_pool.hpp), their parallel calls go to the
+// pool as usual
+class JobScheduler {
+ public:
+  using Job = std::function<void(JobScheduler&)>;
+
+ private:
+  struct Entry {
+    double cost_;
+    std::size_t order_;  // the jobs of the same cost run in the order they were scheduled
+    Job job_;
+
+    [[nodiscard]] bool operator<(Entry const& t_entry) const noexcept {
+      return this->cost_ != t_entry.cost_ ? this->cost_ < t_entry.cost_ : this->order_ > t_entry.order_;
+    }
+  };
+
+  std::size_t jobs_;
+  bool pin_;
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::vector<Entry> queue_;  // a max heap on the cost
+  std::size_t scheduled_ = 0;
+  std::size_t running_   = 0;
+  std::exception_ptr error_;  // the first exception thrown by a job
+
+  // to a core of its own when there are enough of them, best effort
+  static void pin_to_core([[maybe_unused]] std::size_t const t_core) noexcept {
+#if defined(__linux__)
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(t_core % std::max(std::thread::hardware_concurrency(), 1U), &cores);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(cores), &cores);
+#endif
+  }
+
+  void work(std::size_t const t_thread) {
+    if (this->pin_) {
+      pin_to_core(t_thread);
+    }
+
+    std::unique_lock lock{this->mutex_};
+    for (;;) {
+      this->ready_.wait(lock, [&] { return not this->queue_.empty() or this->running_ == 0; });
+      if (this->queue_.empty()) {
+        return;  // nothing running either, hence nothing left to schedule
+      }
+
+      std::ranges::pop_heap(this->queue_, std::less<>{});
+      auto job = std::move(this->queue_.back().job_);
+      this->queue_.pop_back();
+      ++this->running_;
+
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        job(*this);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      if (error and not this->error_) {
+        this->error_ = error;
+      }
+
+      if (--this->running_ == 0 and this->queue_.empty()) {
+        this->ready_.notify_all();
+      }
+    }
+  }
+
+ public:
+  // t_pin pins the threads to the cores 0, 1, ... so that the jobs don't migrate while they run
+  explicit JobScheduler(std::size_t const t_jobs, bool const t_pin = false) noexcept
+    : jobs_{std::max<std::size_t>(t_jobs, 1)}, pin_{t_pin} {}
+
+  // thread safe, from the jobs as well. t_cost only orders the jobs, in any unit as long as it is always the same
+  void schedule(double const t_cost, Job t_job) {
+    {
+      std::scoped_lock const lock{this->mutex_};
+      this->queue_.push_back(Entry{.cost_ = t_cost, .order_ = this->scheduled_++, .job_ = std::move(t_job)});
+      std::ranges::push_heap(this->queue_, std::less<>{});
+    }
+
+    this->ready_.notify_one();
+  }
+
+  // runs the jobs until none is left, the first exception thrown by a job is rethrown here once they are all done
+  void run() {
+    {
+      std::vector<std::jthread> threads;
+      for (std::size_t i = 0; i < this->jobs_; ++i) {
+        threads.emplace_back([this, i] { this->work(i); });
+      }
+    }
+
+    if (this->error_) {
+      std::rethrow_exception(this->error_);
+    }
+  }
+};
+
+}  // namespace aoc
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef JSON_HPP_
+#define JSON_HPP_
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace aoc::json {
+
+// Minimal json document, enough to read back what the tools of this repo write (bench.hpp). Objects keep their members
+// in order, duplicated keys are kept as well (find returns the first one)
+struct Value {
+  using Array  = std::vector<Value>;
+  using Object = std::vector<std::pair<std::string, Value>>;
+
+  std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value_;
+
+  template <typename T>
+  [[nodiscard]] T const* get_if() const noexcept {
+    return std::get_if<T>(&this->value_);
+  }
+
+  // member of an object, nullptr if this isn't an object or if there is no such member
+  [[nodiscard]] Value const* find(std::string_view const t_key) const noexcept {
+    auto const* const object = this->get_if<Object>();
+    if (object == nullptr) {
+      return nullptr;
+    }
+
+    for (auto const& [key, value] : *object) {
+      if (key == t_key) {
+        return &value;
+      }
+    }
+
+    return nullptr;
+  }
+
+  [[nodiscard]] std::optional<double> number(std::string_view const t_key) const noexcept {
+    auto const* const member = this->find(t_key);
+    auto const* const number = member == nullptr ? nullptr : member->get_if<double>();
+    return number == nullptr ? std::nullopt : std::optional{*number};
+  }
+};
+
+namespace detail {
+
+class Parser {
+  std::string_view str_;
+  std::size_t pos_ = 0;
+
+  void skip_whitespace() noexcept {
+    while (this->pos_ < this->str_.size() and std::isspace(static_cast<unsigned char>(this->str_[this->pos_])) != 0) {
+      ++this->pos_;
+    }
+  }
+
+  [[nodiscard]] bool consume(char const t_chr) noexcept {
+    this->skip_whitespace();
+    if (this->pos_ < this->str_.size() and this->str_[this->pos_] == t_chr) {
+      ++this->pos_;
+      return true;
+    }
+
+    return false;
+  }
+
+  [[nodiscard]] bool consume(std::string_view const t_literal) noexcept {
+    if (this->str_.substr(this->pos_).starts_with(t_literal)) {
+      this->pos_ += t_literal.size();
+      return true;
+    }
+
+    return false;
+  }
+
+  // only \uXXXX of the ascii range is supported, which is all that is ever written
+  [[nodiscard]] std::optional<std::string> parse_string() {
+    if (not this->consume('"')) {
+      return std::nullopt;
+    }
+
+    std::string ret_val;
+    while (this->pos_ < this->str_.size()) {
+      auto const chr = this->str_[this->pos_++];
+      if (chr == '"') {
+        return ret_val;
+      }
+
+      if (chr != '\\') {
+        ret_val.push_back(chr);
+        continue;
+      }
+
+      if (this->pos_ == this->str_.size()) {
+        return std::nullopt;
+      }
+
+      switch (auto const escaped = this->str_[this->pos_++]; escaped) {
+        case 'n':
+          ret_val.push_back('\n');
+          break;
+        case 't':
+          ret_val.push_back('\t');
+          break;
+        case 'r':
+          ret_val.push_back('\r');
+          break;
+        case 'b':
+          ret_val.push_back('\b');
+          break;
+        case 'f':
+          ret_val.push_back('\f');
+          break;
+        case 'u': {
+          unsigned code_point   = 0;
+          auto const hex        = this->str_.substr(this->pos_, 4);
+          auto const* const end = hex.data() + hex.size();
+          if (auto const [ptr, ec] = std::from_chars(hex.data(), end, code_point, 16);
+              hex.size() != 4 or ec != std::errc() or ptr != end or code_point > 0x7F) {
+            return std::nullopt;
+          }
+
+          ret_val.push_back(static_cast<char>(code_point));
+          this->pos_ += 4;
+          break;
+        }
+        default:
+          ret_val.push_back(escaped);
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  [[nodiscard]] std::optional<Value> parse_number() {
+    double number         = 0;
+    auto const rest       = this->str_.substr(this->pos_);
+    auto const [ptr, err] = std::from_chars(rest.data(), rest.data() + rest.size(), number);
+    if (err != std::errc()) {
+      return std::nullopt;
+    }
+
+    this->pos_ += static_cast<std::size_t>(ptr - rest.data());
+    return Value{number};
+  }
+
+  [[nodiscard]] std::optional<Value> parse_array() {
+    Value::Array ret_val;
+    if (this->consume(']')) {
+      return Value{std::move(ret_val)};
+    }
+
+    do {
+      auto element = this->parse_value();
+      if (not element) {
+        return std::nullopt;
+      }
+
+      ret_val.push_back(std::move(*element));
+    } while (this->consume(','));
+
+    return this->consume(']') ? std::optional{Value{std::move(ret_val)}} : std::nullopt;
+  }
+
+  [[nodiscard]] std::optional<Value> parse_object() {
+    Value::Object ret_val;
+    if (this->consume('}')) {
+      return Value{std::move(ret_val)};
+    }
+
+    do {
+      auto key = this->parse_string();
+      if (not key or not this->consume(':')) {
+        return std::nullopt;
+      }
+
+      auto value = this->parse_value();
+      if (not value) {
+        return std::nullopt;
+      }
+
+      ret_val.emplace_back(std::move(*key), std::move(*value));
+    } while (this->consume(','));
+
+    return this->consume('}') ? std::optional{Value{std::move(ret_val)}} : std::nullopt;
+  }
+
+ public:
+  explicit Parser(std::string_view const t_str) noexcept : str_{t_str} {}
+
+  [[nodiscard]] std::optional<Value> parse_value() {
+    this->skip_whitespace();
+    if (this->pos_ == this->str_.size()) {
+      return std::nullopt;
+    }
+
+    switch (this->str_[this->pos_]) {
+      case '{':
+        ++this->pos_;
+        return this->parse_object();
+      case '[':
+        ++this->pos_;
+        return this->parse_array();
+      case '"': {
+        auto str = this->parse_string();
+        return str ? std::optional{Value{std::move(*str)}} : std::nullopt;
+      }
+      default:
+        break;
+    }
+
+    if (this->consume("null")) {
+      return Value{nullptr};
+    }
+
+    if (this->consume("true")) {
+      return Value{true};
+    }
+
+    if (this->consume("false")) {
+      return Value{false};
+    }
+
+    return this->parse_number();
+  }
+
+  [[nodiscard]] bool at_end() noexcept {
+    this->skip_whitespace();
+    return this->pos_ == this->str_.size();
+  }
+};
+
+}  // namespace detail
+
+// std::nullopt if t_str isn't a single well formed json value
+[[nodiscard]] inline std::optional<Value> parse(std::string_view const t_str) {
+  detail::Parser parser{t_str};
+  auto ret_val = parser.parse_value();
+  return ret_val and parser.at_end() ? std::move(ret_val) : std::nullopt;
+}
+
+}  // namespace aoc::json
+
+#endif
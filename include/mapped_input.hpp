@@ -0,0 +1,167 @@
+#ifndef MAPPED_INPUT_HPP_
+#define MAPPED_INPUT_HPP_
+
+#include "simd.hpp"
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Read only view of a whole input file, the file is mmap-ed and the lines are indexed once as string_views into the
+// mapping, so nothing is copied per line. Behaves like a random access range of lines (same lines as
+// ranges::getlines, the trailing newline doesn't produce an empty line), e.g.
+//
+//    auto const numbers = t_input | transform([](std::string_view t_line) { ... }) | to_vector;
+//
+// Lines are only valid as long as the MappedInput is alive, a parsed result has to own what it keeps
+class MappedInput {
+  void* mapping_           = nullptr;
+  std::size_t mapped_size_ = 0;
+  std::vector<char> buffer_;  // content when it can't be mapped (e.g. stdin), moving it keeps the data in place
+
+  std::string_view content_;
+  std::vector<std::string_view> lines_;
+
+  MappedInput() = default;
+
+  // the newlines are found BLOCK characters at a time by the simd kernels (see simd.hpp), a line then costs a few bit
+  // operations instead of a call to memchr
+  void index_lines() {
+    static constexpr std::size_t BLOCK = 4096;
+
+    std::array<std::uint64_t, simd::mask_words(BLOCK)> masks{};
+    std::size_t line_begin = 0;
+    for (std::size_t block_begin = 0; block_begin < this->content_.size(); block_begin += BLOCK) {
+      auto const block = this->content_.substr(block_begin, BLOCK);
+      simd::classify(block, simd::ByteClass::one('\n'), masks);
+
+      for (std::size_t word = 0; word < simd::mask_words(block.size()); ++word) {
+        for (auto bits = masks[word]; bits != 0; bits &= bits - 1) {
+          auto const newline = block_begin + word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+          this->lines_.push_back(this->content_.substr(line_begin, newline - line_begin));
+          line_begin = newline + 1;
+        }
+      }
+    }
+
+    if (line_begin < this->content_.size()) {
+      this->lines_.push_back(this->content_.substr(line_begin));
+    }
+  }
+
+  void read_buffer(std::istream& t_in) {
+    this->buffer_.assign(std::istreambuf_iterator<char>(t_in), std::istreambuf_iterator<char>());
+    this->content_ = std::string_view{this->buffer_.data(), this->buffer_.size()};
+  }
+
+  void unmap() noexcept {
+    if (this->mapping_ != nullptr) {
+      ::munmap(this->mapping_, this->mapped_size_);
+      this->mapping_ = nullptr;
+    }
+  }
+
+ public:
+  // throws std::system_error when the file can't be opened or mapped. What isn't a regular file (a fifo, /dev/stdin,
+  // <(cmd)) has no size to map and is read into a buffer as by read
+  explicit MappedInput(std::string const& t_path) {
+    // only stat-ed, opening a fifo a second time would wait for a writer that may be gone already
+    struct stat file_stat {};
+    if (::stat(t_path.c_str(), &file_stat) == -1) {
+      throw std::system_error(errno, std::generic_category(), t_path);
+    }
+
+    if (not S_ISREG(file_stat.st_mode)) {
+      std::ifstream in{t_path, std::ios::binary};
+      if (not in) {
+        throw std::system_error(errno, std::generic_category(), t_path);
+      }
+
+      this->read_buffer(in);
+      this->index_lines();
+      return;
+    }
+
+    auto const fd = ::open(t_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), t_path);
+    }
+
+    if (::fstat(fd, &file_stat) == -1) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), t_path);
+    }
+
+    // mapping an empty file fails, there is nothing to index anyway
+    if (auto const size = static_cast<std::size_t>(file_stat.st_size); size != 0) {
+      auto* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), t_path);
+      }
+
+      ::madvise(mapping, size, MADV_SEQUENTIAL);
+      this->mapping_     = mapping;
+      this->mapped_size_ = size;
+      this->content_     = std::string_view{static_cast<char const*>(mapping), size};
+    }
+
+    ::close(fd);
+    this->index_lines();
+  }
+
+  // streams (stdin) can't be mapped, the content is read into a buffer owned by the MappedInput instead
+  [[nodiscard]] static MappedInput read(std::istream& t_in) {
+    MappedInput ret_val;
+    ret_val.read_buffer(t_in);
+    ret_val.index_lines();
+    return ret_val;
+  }
+
+  MappedInput(MappedInput const&)            = delete;
+  MappedInput& operator=(MappedInput const&) = delete;
+
+  MappedInput(MappedInput&& t_other) noexcept
+    : mapping_{std::exchange(t_other.mapping_, nullptr)},
+      mapped_size_{std::exchange(t_other.mapped_size_, 0)},
+      buffer_{std::move(t_other.buffer_)},
+      content_{std::exchange(t_other.content_, {})},
+      lines_{std::move(t_other.lines_)} {}
+
+  MappedInput& operator=(MappedInput&&) = delete;
+
+  ~MappedInput() { this->unmap(); }
+
+  [[nodiscard]] std::string_view content() const noexcept { return this->content_; }
+  [[nodiscard]] std::span<std::string_view const> lines() const noexcept { return this->lines_; }
+
+  [[nodiscard]] std::size_t size() const noexcept { return this->lines_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return this->lines_.empty(); }
+  [[nodiscard]] std::string_view operator[](std::size_t const t_idx) const noexcept { return this->lines_[t_idx]; }
+
+  [[nodiscard]] auto begin() const noexcept { return this->lines_.cbegin(); }
+  [[nodiscard]] auto end() const noexcept { return this->lines_.cend(); }
+};
+
+}  // namespace aoc
+
+#endif
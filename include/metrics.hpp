@@ -0,0 +1,221 @@
+#ifndef METRICS_HPP_
+#define METRICS_HPP_
+
+// Counters and histograms of how much work the searches do (states expanded, pruned by each rule, memo hits, recursion
+// depth...), to judge a pruning change by the work it removes rather than by noisy timings
+//
+//    void search(State const& t_state) {
+//      AOC_METRIC_DEPTH("day19.depth");          // histogram of the recursion depth
+//      if (is_dominated(t_state)) {
+//        AOC_METRIC_COUNT("day19.pruned.dominated");
+//        return;
+//      }
+//
+//      AOC_METRIC_COUNT("day19.expanded");
+//      AOC_METRIC_RECORD("day19.branches", n);  // histogram of any value
+//      ...
+//    }
+//
+// The macros compile to nothing unless AOC_ENABLE_METRICS is defined (configure with -DENABLE_METRICS=ON), the
+// benchmarks then report the metrics of one run of every part. A metric is looked up once per call site, after that
+// recording it is a relaxed atomic add, hence works from any thread
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aoc::metrics {
+
+#if defined(AOC_ENABLE_METRICS)
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+class Counter {
+  std::atomic<std::uint64_t> value_ = 0;
+
+ public:
+  void add(std::uint64_t const t_value = 1) noexcept { this->value_.fetch_add(t_value, std::memory_order_relaxed); }
+
+  void reset() noexcept { this->value_.store(0, std::memory_order_relaxed); }
+
+  [[nodiscard]] std::uint64_t value() const noexcept { return this->value_.load(std::memory_order_relaxed); }
+};
+
+// values in power of two buckets: bucket 0 holds 0, bucket i the values of [2^(i - 1), 2^i)
+class Histogram {
+  std::array<std::atomic<std::uint64_t>, 65> buckets_{};
+  std::atomic<std::uint64_t> count_ = 0;
+  std::atomic<std::uint64_t> sum_   = 0;
+  std::atomic<std::uint64_t> max_   = 0;
+
+ public:
+  void record(std::uint64_t const t_value) noexcept {
+    this->buckets_[static_cast<std::size_t>(64 - std::countl_zero(t_value))].fetch_add(1, std::memory_order_relaxed);
+    this->count_.fetch_add(1, std::memory_order_relaxed);
+    this->sum_.fetch_add(t_value, std::memory_order_relaxed);
+
+    auto max = this->max_.load(std::memory_order_relaxed);
+    while (t_value > max and not this->max_.compare_exchange_weak(max, t_value, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() noexcept {
+    for (auto& bucket : this->buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+
+    this->count_.store(0, std::memory_order_relaxed);
+    this->sum_.store(0, std::memory_order_relaxed);
+    this->max_.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return this->count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::uint64_t max() const noexcept { return this->max_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] double mean() const noexcept {
+    auto const count = this->count();
+    auto const sum   = this->sum_.load(std::memory_order_relaxed);
+    return count == 0 ? 0 : static_cast<double>(sum) / static_cast<double>(count);
+  }
+
+  // upper bound of the bucket holding the t_quantile (e.g. 0.99) of the values, exact up to a factor of 2
+  [[nodiscard]] std::uint64_t quantile(double const t_quantile) const noexcept {
+    auto const rank    = static_cast<std::uint64_t>(t_quantile * static_cast<double>(this->count()));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < this->buckets_.size(); ++i) {
+      seen += this->buckets_[i].load(std::memory_order_relaxed);
+      if (seen > rank) {
+        return i == 0 ? 0 : std::min(this->max(), (std::uint64_t{1} << (i - 1)) * 2 - 1);
+      }
+    }
+
+    return this->max();
+  }
+};
+
+// every metric recorded so far by name, the maps never move their values hence the call sites keep references
+class Registry {
+  std::mutex mutex_;
+  std::map<std::string, Counter, std::less<>> counters_;
+  std::map<std::string, Histogram, std::less<>> histograms_;
+
+  template <typename Metric>
+  [[nodiscard]] Metric& find_or_add(std::map<std::string, Metric, std::less<>>& t_metrics, std::string_view t_name) {
+    std::scoped_lock const lock{this->mutex_};
+    if (auto const iter = t_metrics.find(t_name); iter != t_metrics.end()) {
+      return iter->second;
+    }
+
+    return t_metrics.try_emplace(std::string{t_name}).first->second;
+  }
+
+ public:
+  [[nodiscard]] Counter& counter(std::string_view const t_name) { return this->find_or_add(this->counters_, t_name); }
+
+  [[nodiscard]] Histogram& histogram(std::string_view const t_name) {
+    return this->find_or_add(this->histograms_, t_name);
+  }
+
+  void reset() {
+    std::scoped_lock const lock{this->mutex_};
+    std::ranges::for_each(this->counters_, [](auto& t_entry) { t_entry.second.reset(); });
+    std::ranges::for_each(this->histograms_, [](auto& t_entry) { t_entry.second.reset(); });
+  }
+
+  // by name, a histogram as <name>.count, .mean, .p50, .p99 and .max. The metrics that weren't recorded since the last
+  // reset are left out
+  [[nodiscard]] std::vector<std::pair<std::string, double>> snapshot() {
+    std::scoped_lock const lock{this->mutex_};
+
+    std::vector<std::pair<std::string, double>> ret_val;
+    for (auto const& [name, counter] : this->counters_) {
+      if (counter.value() != 0) {
+        ret_val.emplace_back(name, static_cast<double>(counter.value()));
+      }
+    }
+
+    for (auto const& [name, histogram] : this->histograms_) {
+      if (histogram.count() != 0) {
+        ret_val.emplace_back(fmt::format("{}.count", name), static_cast<double>(histogram.count()));
+        ret_val.emplace_back(fmt::format("{}.mean", name), histogram.mean());
+        ret_val.emplace_back(fmt::format("{}.p50", name), static_cast<double>(histogram.quantile(0.5)));
+        ret_val.emplace_back(fmt::format("{}.p99", name), static_cast<double>(histogram.quantile(0.99)));
+        ret_val.emplace_back(fmt::format("{}.max", name), static_cast<double>(histogram.max()));
+      }
+    }
+
+    std::ranges::sort(ret_val);
+    return ret_val;
+  }
+};
+
+[[nodiscard]] inline Registry& registry() {
+  static Registry ret_val;
+  return ret_val;
+}
+
+// records the depth of the recursion it is in, use it through AOC_METRIC_DEPTH
+class DepthScope {
+  std::size_t& depth_;
+
+ public:
+  DepthScope(Histogram& t_histogram, std::size_t& t_depth) noexcept : depth_{t_depth} {
+    t_histogram.record(++this->depth_);
+  }
+
+  DepthScope(DepthScope const&)            = delete;
+  DepthScope& operator=(DepthScope const&) = delete;
+
+  ~DepthScope() { --this->depth_; }
+};
+
+}  // namespace aoc::metrics
+
+#if defined(AOC_ENABLE_METRICS)
+
+#define AOC_METRICS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define AOC_METRICS_CONCAT(lhs, rhs)      AOC_METRICS_CONCAT_IMPL(lhs, rhs)
+
+#define AOC_METRIC_ADD(NAME, VALUE)                                           \
+  do {                                                                        \
+    static auto& aoc_metric_counter = aoc::metrics::registry().counter(NAME); \
+    aoc_metric_counter.add(static_cast<std::uint64_t>(VALUE));                \
+  } while (false)
+
+#define AOC_METRIC_COUNT(NAME) AOC_METRIC_ADD(NAME, 1)
+
+#define AOC_METRIC_RECORD(NAME, VALUE)                                            \
+  do {                                                                            \
+    static auto& aoc_metric_histogram = aoc::metrics::registry().histogram(NAME); \
+    aoc_metric_histogram.record(static_cast<std::uint64_t>(VALUE));               \
+  } while (false)
+
+// a histogram of the recursion depth of the enclosing function, counted from its outermost call on every thread
+#define AOC_METRIC_DEPTH(NAME)                                                                                       \
+  static auto& AOC_METRICS_CONCAT(aoc_metric_depth_histogram_, __LINE__) = aoc::metrics::registry().histogram(NAME); \
+  static thread_local std::size_t AOC_METRICS_CONCAT(aoc_metric_depth_, __LINE__) = 0;                               \
+  aoc::metrics::DepthScope const AOC_METRICS_CONCAT(aoc_metric_depth_scope_, __LINE__)(                              \
+    AOC_METRICS_CONCAT(aoc_metric_depth_histogram_, __LINE__), AOC_METRICS_CONCAT(aoc_metric_depth_, __LINE__))
+
+#else
+
+#define AOC_METRIC_ADD(NAME, VALUE)    static_cast<void>(0)
+#define AOC_METRIC_COUNT(NAME)         static_cast<void>(0)
+#define AOC_METRIC_RECORD(NAME, VALUE) static_cast<void>(0)
+#define AOC_METRIC_DEPTH(NAME)         static_cast<void>(0)
+
+#endif
+
+#endif
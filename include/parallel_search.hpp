@@ -0,0 +1,133 @@
+#ifndef PARALLEL_SEARCH_HPP_
+#define PARALLEL_SEARCH_HPP_
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+// The best value any thread of a search found so far, e.g. the bound of a branch and bound. Compare orders the values
+// from the worst to the best, the highest value wins by default:
+//
+//    SharedBest<int> most_geodes{0};
+//    if (upper_bound(t_node) <= most_geodes.get()) {
+//      return;  // can't beat what another branch already found
+//    }
+//
+//    SharedBest<std::size_t, std::greater<>> earliest{std::numeric_limits<std::size_t>::max()};
+template <typename T, typename Compare = std::less<>>
+class SharedBest {
+  std::atomic<T> value_;
+
+ public:
+  explicit SharedBest(T const t_init) noexcept : value_{t_init} {}
+
+  [[nodiscard]] T get() const noexcept { return this->value_.load(std::memory_order_relaxed); }
+
+  // keeps t_value if it is better than the current one, returns whether it did
+  bool offer(T const t_value) noexcept {
+    auto current = this->get();
+    while (Compare{}(current, t_value)) {
+      if (this->value_.compare_exchange_weak(current, t_value, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+// Depth first search of a tree (e.g. a branch and bound), on the thread pool. t_expand(node, context, search) calls
+// search(child) for every child worth searching:
+//
+//    ParallelSearch<Memo> search{CUTOFF};
+//    search.run(root, [&](Node const& t_node, Memo& t_memo, auto&& t_search) {
+//      if (bound(t_node) <= best.get()) {
+//        return;
+//      }
+//
+//      for (auto const& child : children(t_node)) {
+//        t_search(child);
+//      }
+//    });
+//
+// Down to the cutoff depth (the root is at depth 0), the children of a node become tasks that idle threads steal.
+// Deeper, a subtree is searched on the thread that took it, right away and in the order of the calls to search, like a
+// plain recursion. Every thread hands its own Context (a memo, a DP table, a scratch map...) to t_expand, the tasks of
+// a thread use it one after another and never at the same time, for_each_context merges them afterward. The threads
+// outside of the pool (e.g. the jobs of the runner) that start or help the search get a context each as well
+template <typename Context>
+class ParallelSearch {
+  // a cache line each, the threads write their context all the time
+  struct alignas(64) Slot {
+    Context context_;
+  };
+
+  std::size_t cutoff_;
+  Context init_;
+  std::vector<Slot> slots_;  // of the workers of the pool
+
+  // the threads outside of the pool share an index there, they are told apart by their id instead. Only the nodes down
+  // to the cutoff look their context up, their children get it passed
+  std::mutex outside_mutex_;
+  std::map<std::thread::id, Context> outside_;
+
+  [[nodiscard]] Context& own_context() {
+    if (auto const idx = thread_pool().thread_index(); idx < this->slots_.size()) {
+      return this->slots_[idx].context_;
+    }
+
+    std::scoped_lock const lock{this->outside_mutex_};
+    return this->outside_.try_emplace(std::this_thread::get_id(), this->init_).first->second;
+  }
+
+  template <typename Node, typename Expand>
+  void search_in_place(Node const& t_node, Context& t_context, Expand const& t_expand) {
+    t_expand(t_node, t_context, [&](Node const& t_child) { this->search_in_place(t_child, t_context, t_expand); });
+  }
+
+  template <typename Node, typename Expand>
+  void search(Node const& t_node, std::size_t const t_depth, Expand const& t_expand) {
+    if (t_depth >= this->cutoff_) {
+      this->search_in_place(t_node, this->own_context(), t_expand);
+      return;
+    }
+
+    std::vector<Node> children;
+    t_expand(t_node, this->own_context(), [&](Node const& t_child) { children.push_back(t_child); });
+    parallel_for(children, [&](Node const& t_child) { this->search(t_child, t_depth + 1, t_expand); });
+  }
+
+ public:
+  // every thread starts from a copy of t_init
+  explicit ParallelSearch(std::size_t const t_cutoff, Context const& t_init = Context{})
+    : cutoff_{t_cutoff}, init_{t_init}, slots_(thread_pool().size() - 1, Slot{t_init}) {}
+
+  // returns once the whole tree is searched, the first exception thrown by t_expand is rethrown here
+  template <typename Node, typename Expand>
+  void run(Node const& t_root, Expand const& t_expand) {
+    this->search(t_root, 0, t_expand);
+  }
+
+  template <typename Fn>
+  void for_each_context(Fn const& t_fn) {
+    for (auto& slot : this->slots_) {
+      std::invoke(t_fn, slot.context_);
+    }
+
+    for (auto& [id, context] : this->outside_) {
+      std::invoke(t_fn, context);
+    }
+  }
+};
+
+}  // namespace aoc
+
+#endif
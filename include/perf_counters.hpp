@@ -0,0 +1,168 @@
+#ifndef PERF_COUNTERS_HPP_
+#define PERF_COUNTERS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aoc::bench {
+
+// hardware counts of one run, std::nullopt for the events the machine or the container doesn't let us count
+struct HardwareCounts {
+  std::optional<double> cycles_;         // core cycles, unlike Stats::cycles_ they follow the core frequency
+  std::optional<double> instructions_;   // retired instructions
+  std::optional<double> l1d_misses_;     // L1 data cache read misses
+  std::optional<double> llc_misses_;     // last level cache misses
+  std::optional<double> branch_misses_;  // mispredicted branches
+
+  // instructions per cycle
+  [[nodiscard]] std::optional<double> ipc() const noexcept {
+    if (not this->cycles_ or not this->instructions_ or *this->cycles_ == 0) {
+      return std::nullopt;
+    }
+
+    return *this->instructions_ / *this->cycles_;
+  }
+};
+
+struct HardwareEvent {
+  std::string_view name_;  // also the key in the json results
+  std::optional<double> HardwareCounts::*count_;
+  std::uint32_t type_;
+  std::uint64_t config_;
+};
+
+#if defined(__linux__)
+inline constexpr std::array HARDWARE_EVENTS{
+  HardwareEvent{"cycles", &HardwareCounts::cycles_, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  HardwareEvent{"instructions", &HardwareCounts::instructions_, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  HardwareEvent{"l1d_misses", &HardwareCounts::l1d_misses_, PERF_TYPE_HW_CACHE,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)},
+  HardwareEvent{"llc_misses", &HardwareCounts::llc_misses_, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  HardwareEvent{"branch_misses", &HardwareCounts::branch_misses_, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+#else
+inline constexpr std::array HARDWARE_EVENTS{
+  HardwareEvent{"cycles", &HardwareCounts::cycles_, 0, 0},
+  HardwareEvent{"instructions", &HardwareCounts::instructions_, 0, 0},
+  HardwareEvent{"l1d_misses", &HardwareCounts::l1d_misses_, 0, 0},
+  HardwareEvent{"llc_misses", &HardwareCounts::llc_misses_, 0, 0},
+  HardwareEvent{"branch_misses", &HardwareCounts::branch_misses_, 0, 0},
+};
+#endif
+
+// Linux perf_event_open counters of the calling thread and of every thread it starts once they are open (they are
+// inherited), user space only so that it works with the default perf_event_paranoid of 2. The threads started before
+// aren't counted: the thread pool has to start its workers after the counters are opened, or the work of the parallel
+// days is left out. Every event is opened on its own: a VM or a container often only lets some of them (or none)
+// through, those that can't be opened are left out. Elsewhere than on Linux nothing is ever available
+//
+//    PerfCounters counters;
+//    counters.start();
+//    ...
+//    auto const counts = counters.stop();
+class PerfCounters {
+  std::array<int, HARDWARE_EVENTS.size()> fds_{};
+  int error_ = 0;  // errno of the first event that couldn't be opened
+
+ public:
+  PerfCounters() noexcept {
+    this->fds_.fill(-1);
+
+#if defined(__linux__)
+    for (std::size_t i = 0; i < HARDWARE_EVENTS.size(); ++i) {
+      perf_event_attr attr{};
+      attr.size           = sizeof(attr);
+      attr.type           = HARDWARE_EVENTS[i].type_;
+      attr.config         = HARDWARE_EVENTS[i].config_;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.inherit        = 1;
+      attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      this->fds_[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+      if (this->fds_[i] == -1 and this->error_ == 0) {
+        this->error_ = errno;
+      }
+    }
+#else
+    this->error_ = ENOSYS;
+#endif
+  }
+
+  PerfCounters(PerfCounters const&)            = delete;
+  PerfCounters& operator=(PerfCounters const&) = delete;
+
+  ~PerfCounters() {
+#if defined(__linux__)
+    for (auto const fd : this->fds_) {
+      if (fd != -1) {
+        ::close(fd);
+      }
+    }
+#endif
+  }
+
+  // whether at least one event is counted
+  [[nodiscard]] bool available() const noexcept {
+    return std::ranges::any_of(this->fds_, [](int const t_fd) { return t_fd != -1; });
+  }
+
+  // why some events aren't counted (e.g. EACCES with a stricter perf_event_paranoid, ENOENT when the CPU or the
+  // hypervisor doesn't expose the event), 0 when they all are
+  [[nodiscard]] int error() const noexcept { return this->error_; }
+
+  void start() noexcept {
+#if defined(__linux__)
+    for (auto const fd : this->fds_) {
+      if (fd != -1) {
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // the counts since start, scaled up when the kernel had to multiplex the events on fewer hardware counters
+  [[nodiscard]] HardwareCounts stop() noexcept {
+    HardwareCounts ret_val;
+
+#if defined(__linux__)
+    for (auto const fd : this->fds_) {
+      if (fd != -1) {
+        ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+
+    for (std::size_t i = 0; i < HARDWARE_EVENTS.size(); ++i) {
+      std::array<std::uint64_t, 3> values{};  // value, time enabled, time running
+      if (this->fds_[i] == -1 or ::read(this->fds_[i], values.data(), sizeof(values)) != sizeof(values) or
+          values[2] == 0) {
+        continue;
+      }
+
+      ret_val.*HARDWARE_EVENTS[i].count_ =
+        static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+    }
+#endif
+
+    return ret_val;
+  }
+};
+
+}  // namespace aoc::bench
+
+#endif
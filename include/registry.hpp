@@ -0,0 +1,134 @@
+#ifndef REGISTRY_HPP_
+#define REGISTRY_HPP_
+
+#include "solution.hpp"
+#include "trace.hpp"
+
+#include <cerrno>
+#include <fmt/format.h>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace aoc {
+
+using ParsedInput = std::shared_ptr<void const>;
+
+struct Part {
+  std::string_view name_;
+  std::string (*solve_)(void const*);
+  std::string& (*trace_name_)();  // set when the day registers it, see detail::trace_name
+};
+
+struct Day {
+  int year_;
+  int day_;
+  std::string_view input_;  // default input, can be overridden at runtime (see arguments.hpp)
+  ParsedInput (*parse_)(std::string const&);  // reads the input from a path, "-" is stdin
+  std::vector<Part> parts_;
+};
+
+// All solutions that are linked into a binary show up here, each day registers itself with AOC_REGISTER during static
+// initialization, so the runner doesn't need to know which days exist
+[[nodiscard]] inline std::vector<Day>& registry() noexcept {
+  static std::vector<Day> days;
+  return days;
+}
+
+namespace detail {
+
+// the name of the trace events of a parse or of a part, e.g. "2022 day 16 part 2" rather than a bare "solve" that can't
+// be told apart from the others under aoc --all. One per function, every day has a Solution type and every part a
+// function of its own, set when the day registers (a function local static, the registration is static
+// initialization too)
+template <auto Fn>
+[[nodiscard]] std::string& trace_name() {
+  static std::string ret_val;
+  return ret_val;
+}
+
+template <typename>
+struct PartTraits;
+
+template <typename Result, typename Parsed>
+struct PartTraits<Result (*)(Parsed const&)> {
+  using parsed_type = Parsed;
+};
+
+// throws std::system_error when the input can't be read
+template <Solution S>
+[[nodiscard]] ParsedInput parse(std::string const& t_path) {
+  using Parsed = typename S::Parsed;
+
+  AOC_TRACE_SCOPE(trace_name<&parse<S>>().c_str());
+  if constexpr (ParsesMappedInput<S>) {
+    auto const input = t_path == "-" ? MappedInput::read(std::cin) : MappedInput{t_path};
+    return std::make_shared<Parsed const>(S::parse(input));
+  } else {
+    if (t_path == "-") {
+      return std::make_shared<Parsed const>(S::parse(std::cin));
+    }
+
+    std::ifstream in{t_path};
+    if (not in.is_open()) {
+      throw std::system_error(errno, std::generic_category(), t_path);
+    }
+
+    return std::make_shared<Parsed const>(S::parse(in));
+  }
+}
+
+template <auto Fn>
+[[nodiscard]] std::string solve(void const* const t_parsed) {
+  using Parsed = typename PartTraits<decltype(Fn)>::parsed_type;
+
+  AOC_TRACE_SCOPE(trace_name<Fn>().c_str());
+  return fmt::format("{}", Fn(*static_cast<Parsed const*>(t_parsed)));
+}
+
+}  // namespace detail
+
+// type erase a function that takes the parsed input, used to register alternative implementations of a part
+template <auto Fn>
+[[nodiscard]] constexpr Part part(std::string_view const t_name) noexcept {
+  return Part{.name_ = t_name, .solve_ = &detail::solve<Fn>, .trace_name_ = &detail::trace_name<Fn>};
+}
+
+template <Solution S>
+struct Registrar {
+  Registrar(int const t_year, int const t_day, std::string_view const t_input,
+            std::initializer_list<Part> const t_variants) {
+    auto& day = registry().emplace_back(
+      Day{.year_ = t_year, .day_ = t_day, .input_ = t_input, .parse_ = &detail::parse<S>, .parts_ = {}});
+
+    day.parts_.push_back(part<&S::part1>("1"));
+    if constexpr (HasPart2<S>) {
+      day.parts_.push_back(part<&S::part2>("2"));
+    }
+
+    day.parts_.insert(day.parts_.end(), t_variants);
+
+    detail::trace_name<&detail::parse<S>>() = fmt::format("{} day {} parse", t_year, t_day);
+    for (auto const& part : day.parts_) {
+      part.trace_name_() = fmt::format("{} day {} part {}", t_year, t_day, part.name_);
+    }
+  }
+};
+
+}  // namespace aoc
+
+#define AOC_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define AOC_CONCAT(lhs, rhs)      AOC_CONCAT_IMPL(lhs, rhs)
+
+// e.g. AOC_REGISTER(2022, 3, Day3, aoc::part<&Day3::part1_sybrand>("1_sybrand"));
+//
+// the day's parts are registered as "1" and "2", extra arguments are registered as alternative implementations
+#define AOC_REGISTER(YEAR, DAY, SOLUTION, ...) \
+  static aoc::Registrar<SOLUTION> const AOC_CONCAT(aoc_registrar_, __LINE__) { YEAR, DAY, INPUT_FILE, { __VA_ARGS__ } }
+
+#endif
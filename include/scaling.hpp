@@ -0,0 +1,198 @@
+#ifndef SCALING_HPP_
+#define SCALING_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc::bench {
+
+enum class Complexity { constant, log_n, n, n_log_n, n_squared, n_cubed };
+
+inline constexpr std::array COMPLEXITIES{Complexity::constant, Complexity::log_n,     Complexity::n,
+                                         Complexity::n_log_n,  Complexity::n_squared, Complexity::n_cubed};
+
+[[nodiscard]] constexpr std::string_view to_string(Complexity const t_complexity) noexcept {
+  switch (t_complexity) {
+    case Complexity::constant:
+      return "O(1)";
+    case Complexity::log_n:
+      return "O(log n)";
+    case Complexity::n:
+      return "O(n)";
+    case Complexity::n_log_n:
+      return "O(n log n)";
+    case Complexity::n_squared:
+      return "O(n^2)";
+    case Complexity::n_cubed:
+      return "O(n^3)";
+  }
+
+  return "";
+}
+
+[[nodiscard]] inline double evaluate(Complexity const t_complexity, double const t_n) noexcept {
+  switch (t_complexity) {
+    case Complexity::constant:
+      return 1;
+    case Complexity::log_n:
+      return std::log2(t_n);
+    case Complexity::n:
+      return t_n;
+    case Complexity::n_log_n:
+      return t_n * std::log2(t_n);
+    case Complexity::n_squared:
+      return t_n * t_n;
+    case Complexity::n_cubed:
+      return t_n * t_n * t_n;
+  }
+
+  return 0;
+}
+
+// t(n) ~ intercept_ + coefficient_ * complexity_(n), the intercept absorbs what doesn't depend on n (e.g. allocating
+// the result) so that it doesn't skew the small sizes
+struct Fit {
+  Complexity complexity_;
+  double intercept_   = 0;
+  double coefficient_ = 0;
+  double rms_         = 0;  // root mean square of the residuals relative to the times, 0.1 for 10%
+};
+
+// Least squares fit of t_times over t_sizes, the intercept and the coefficient are kept non negative. The residuals
+// are relative to the times: the sizes of a sweep span orders of magnitude, with absolute residuals the noise of the
+// largest size alone would pick the complexity
+[[nodiscard]] inline Fit fit(Complexity const t_complexity, std::span<double const> const t_sizes,
+                             std::span<double const> const t_times) {
+  if (t_sizes.empty() or t_sizes.size() != t_times.size() or std::ranges::find(t_times, 0.0) != t_times.end()) {
+    return {.complexity_ = t_complexity};
+  }
+
+  std::vector<double> terms(t_sizes.size());
+  std::vector<double> weights(t_times.size());
+  std::ranges::transform(t_sizes, terms.begin(), [=](double const t_n) { return evaluate(t_complexity, t_n); });
+  std::ranges::transform(t_times, weights.begin(), [](double const t_time) { return 1 / (t_time * t_time); });
+
+  double total_weight = 0;
+  double mean_term    = 0;
+  double mean_time    = 0;
+  for (std::size_t i = 0; i < terms.size(); ++i) {
+    total_weight += weights[i];
+    mean_term += weights[i] * terms[i];
+    mean_time += weights[i] * t_times[i];
+  }
+  mean_term /= total_weight;
+  mean_time /= total_weight;
+
+  double variance   = 0;
+  double covariance = 0;
+  for (std::size_t i = 0; i < terms.size(); ++i) {
+    variance += weights[i] * (terms[i] - mean_term) * (terms[i] - mean_term);
+    covariance += weights[i] * (terms[i] - mean_term) * (t_times[i] - mean_time);
+  }
+
+  Fit ret_val{.complexity_ = t_complexity, .intercept_ = mean_time};
+  if (variance > 0 and covariance > 0) {
+    ret_val.coefficient_ = covariance / variance;
+    ret_val.intercept_   = mean_time - ret_val.coefficient_ * mean_term;
+  }
+
+  if (ret_val.intercept_ < 0) {  // through the origin instead
+    double term_time   = 0;
+    double term_square = 0;
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+      term_time += weights[i] * terms[i] * t_times[i];
+      term_square += weights[i] * terms[i] * terms[i];
+    }
+
+    ret_val.intercept_   = 0;
+    ret_val.coefficient_ = term_square == 0 ? 0 : term_time / term_square;
+  }
+
+  double squared_residuals = 0;
+  for (std::size_t i = 0; i < terms.size(); ++i) {
+    auto const residual = t_times[i] - ret_val.intercept_ - ret_val.coefficient_ * terms[i];
+    squared_residuals += weights[i] * residual * residual;
+  }
+
+  ret_val.rms_ = std::sqrt(squared_residuals / static_cast<double>(terms.size()));
+  return ret_val;
+}
+
+// The complexity that fits best. A higher complexity needs a clearly better fit (10% lower rms) to win over a lower
+// one, with a handful of noisy points the higher one always fits a little better
+[[nodiscard]] inline Fit best_fit(std::span<double const> const t_sizes, std::span<double const> const t_times) {
+  static constexpr auto MARGIN = 0.9;
+
+  auto ret_val = fit(COMPLEXITIES.front(), t_sizes, t_times);
+  for (auto const complexity : std::span{COMPLEXITIES}.subspan(1)) {
+    if (auto const candidate = fit(complexity, t_sizes, t_times); candidate.rms_ < ret_val.rms_ * MARGIN) {
+      ret_val = candidate;
+    }
+  }
+
+  return ret_val;
+}
+
+// slope of log(t) over log(n), i.e. the k of t(n) ~ n^k. Unlike best_fit it doesn't round to a known complexity,
+// and it is biased towards 0 when a constant cost dominates the small sizes
+[[nodiscard]] inline double empirical_exponent(std::span<double const> const t_sizes,
+                                               std::span<double const> const t_times) {
+  std::vector<double> log_sizes;
+  std::vector<double> log_times;
+  for (std::size_t i = 0; i < std::min(t_sizes.size(), t_times.size()); ++i) {
+    if (t_sizes[i] > 0 and t_times[i] > 0) {
+      log_sizes.push_back(std::log(t_sizes[i]));
+      log_times.push_back(std::log(t_times[i]));
+    }
+  }
+
+  if (log_sizes.size() < 2) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  auto const count     = static_cast<double>(log_sizes.size());
+  double mean_log_size = 0;
+  double mean_log_time = 0;
+  for (std::size_t i = 0; i < log_sizes.size(); ++i) {
+    mean_log_size += log_sizes[i] / count;
+    mean_log_time += log_times[i] / count;
+  }
+
+  double variance   = 0;
+  double covariance = 0;
+  for (std::size_t i = 0; i < log_sizes.size(); ++i) {
+    variance += (log_sizes[i] - mean_log_size) * (log_sizes[i] - mean_log_size);
+    covariance += (log_sizes[i] - mean_log_size) * (log_times[i] - mean_log_time);
+  }
+
+  return variance == 0 ? std::numeric_limits<double>::quiet_NaN() : covariance / variance;
+}
+
+// sizes of a sweep: t_min, t_min * t_ratio, ... up to t_max included, t_ratio has to be more than 1
+[[nodiscard]] inline std::vector<std::size_t> geometric_sizes(std::size_t const t_min, std::size_t const t_max,
+                                                              double const t_ratio) {
+  std::vector<std::size_t> ret_val;
+  if (t_ratio <= 1) {
+    return ret_val;
+  }
+
+  for (auto size = static_cast<double>(std::max<std::size_t>(t_min, 1)); size <= static_cast<double>(t_max);
+       size *= t_ratio) {
+    if (auto const rounded = static_cast<std::size_t>(std::llround(size));
+        ret_val.empty() or rounded != ret_val.back()) {
+      ret_val.push_back(rounded);
+    }
+  }
+
+  return ret_val;
+}
+
+}  // namespace aoc::bench
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef SHORTEST_PATH_HPP_
+#define SHORTEST_PATH_HPP_
+
+#include "bfs.hpp"
+#include "grid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Monotone priority queue: the keys pushed are never less than the last key popped, which every Dijkstra and every A*
+// with a consistent heuristic guarantees. An entry sits in the bucket of the highest bit its key differs from the last
+// key popped in, and only moves to a lower bucket when the ones below are empty, hence at most 64 times
+template <typename Value>
+class RadixHeap {
+  using Entry = std::pair<std::uint64_t, Value>;
+
+  std::array<std::vector<Entry>, 65> buckets_;
+  std::uint64_t last_ = 0;
+  std::size_t size_   = 0;
+
+  [[nodiscard]] std::size_t bucket(std::uint64_t const t_key) const noexcept {
+    return t_key == this->last_ ? 0 : static_cast<std::size_t>(64 - std::countl_zero(t_key ^ this->last_));
+  }
+
+ public:
+  [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+  [[nodiscard]] std::size_t size() const noexcept { return this->size_; }
+
+  void push(std::uint64_t const t_key, Value t_value) {
+    this->buckets_[this->bucket(t_key)].emplace_back(t_key, std::move(t_value));
+    ++this->size_;
+  }
+
+  // the entry of the smallest key, the queue can't be empty
+  [[nodiscard]] Entry pop() {
+    if (this->buckets_[0].empty()) {
+      auto& lowest = *std::ranges::find_if(this->buckets_, [](auto const& t_bucket) { return not t_bucket.empty(); });
+      this->last_  = std::ranges::min(lowest, {}, &Entry::first).first;
+
+      for (auto& entry : lowest) {  // all of them go to a lower bucket
+        this->buckets_[this->bucket(entry.first)].push_back(std::move(entry));
+      }
+
+      lowest.clear();
+    }
+
+    auto ret_val = std::move(this->buckets_[0].back());
+    this->buckets_[0].pop_back();
+    --this->size_;
+    return ret_val;
+  }
+};
+
+// Dial's bucket queue for small integer steps: the keys in the queue are all within t_max_step of the smallest one
+// (e.g. the weights are at most t_max_step, or a step of an A* on a grid changes the key by 0 to 2). One bucket per key
+// in a ring, a push and a pop cost next to nothing
+template <typename Value>
+class BucketQueue {
+  std::vector<std::vector<Value>> buckets_;
+  std::uint64_t current_ = 0;  // the smallest key in the queue, at most
+  std::size_t size_      = 0;
+
+ public:
+  explicit BucketQueue(std::uint64_t const t_max_step) : buckets_(t_max_step + 1) {}
+
+  [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+  [[nodiscard]] std::size_t size() const noexcept { return this->size_; }
+
+  void push(std::uint64_t const t_key, Value t_value) {
+    if (this->size_ == 0 or t_key < this->current_) {
+      this->current_ = t_key;
+    }
+
+    this->buckets_[t_key % this->buckets_.size()].push_back(std::move(t_value));
+    ++this->size_;
+  }
+
+  // the entry of the smallest key, the queue can't be empty
+  [[nodiscard]] std::pair<std::uint64_t, Value> pop() {
+    while (this->buckets_[this->current_ % this->buckets_.size()].empty()) {
+      ++this->current_;
+    }
+
+    auto& bucket = this->buckets_[this->current_ % this->buckets_.size()];
+    auto ret_val = std::pair{this->current_, std::move(bucket.back())};
+    bucket.pop_back();
+    --this->size_;
+    return ret_val;
+  }
+};
+
+// Shortest paths from a set of sources over a weighted graph of t_node_count nodes numbered [0, t_node_count), as in
+// Bfs: t_edges(node, relax) calls relax(to, weight) for every edge leaving node. find is an A* when given a heuristic,
+// a lower bound of the distance left from a node to the nearest target that doesn't drop by more than the weight of an
+// edge along it (a consistent heuristic, e.g. the manhattan distance on a grid), a Dijkstra with NO_HEURISTIC:
+//
+//    aoc::ShortestPath<aoc::BucketQueue<std::size_t>> search{map.cells().size(), std::array{start},
+//                                                           aoc::BucketQueue<std::size_t>{2}};
+//    auto const steps = search.find(edges, aoc::manhattan_to(map, end),
+//                                   [&](std::size_t const t_idx) { return t_idx == end; });
+//
+// Queue is a RadixHeap of the nodes by default, a BucketQueue when the keys in the queue stay close to each other.
+// The nodes settled and their distances stay in flat arrays, a node is settled once and for all
+template <typename Queue = RadixHeap<std::size_t>>
+class ShortestPath {
+ public:
+  static constexpr std::uint64_t UNREACHED = std::numeric_limits<std::uint64_t>::max();
+
+ private:
+  std::vector<std::uint64_t> distance_;
+  VisitedSet settled_;
+  std::vector<std::size_t> sources_;  // waiting for the heuristic to be queued
+  Queue queue_;
+
+  template <typename Heuristic>
+  void queue_sources(Heuristic const& t_heuristic) {
+    for (auto const source : this->sources_) {
+      this->queue_.push(t_heuristic(source), source);
+    }
+
+    this->sources_.clear();
+  }
+
+  // the node of the smallest key not settled yet, nullopt once all of them are
+  [[nodiscard]] std::optional<std::size_t> settle_next() {
+    while (not this->queue_.empty()) {
+      if (auto const node = this->queue_.pop().second; this->settled_.insert(node)) {
+        return node;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  template <typename Edges, typename Heuristic>
+  void relax_edges(std::size_t const t_node, Edges const& t_edges, Heuristic const& t_heuristic) {
+    auto const distance = this->distance_[t_node];
+    t_edges(t_node, [&](std::size_t const t_to, std::uint64_t const t_weight) {
+      // a node settled already is at least as close, it is never relaxed again
+      if (auto const to_distance = distance + t_weight; to_distance < this->distance_[t_to]) {
+        this->distance_[t_to] = to_distance;
+        this->queue_.push(to_distance + t_heuristic(t_to), t_to);
+      }
+    });
+  }
+
+ public:
+  template <typename Sources>
+  ShortestPath(std::size_t const t_node_count, Sources const& t_sources, Queue t_queue = Queue{})
+    : distance_(t_node_count, UNREACHED), settled_{t_node_count}, queue_{std::move(t_queue)} {
+    for (auto const source : t_sources) {
+      this->distance_[source] = 0;
+      this->sources_.push_back(source);
+    }
+  }
+
+  // the distance of t_node from the nearest source, exact once t_node is settled
+  [[nodiscard]] std::uint64_t distance(std::size_t const t_node) const noexcept { return this->distance_[t_node]; }
+
+  // the distance of the first target settled, i.e. of the nearest one, nullopt if none can be reached
+  template <typename Edges, typename Heuristic, typename IsTarget>
+  [[nodiscard]] std::optional<std::uint64_t> find(Edges const& t_edges, Heuristic const& t_heuristic,
+                                                  IsTarget const& t_is_target) {
+    this->queue_sources(t_heuristic);
+    while (auto const node = this->settle_next()) {
+      if (t_is_target(*node)) {
+        return this->distance_[*node];
+      }
+
+      this->relax_edges(*node, t_edges, t_heuristic);
+    }
+
+    return std::nullopt;
+  }
+
+  // the distance of every node, see distance
+  template <typename Edges>
+  void run(Edges const& t_edges) {
+    constexpr auto no_heuristic = [](std::size_t) { return std::uint64_t{0}; };
+
+    this->queue_sources(no_heuristic);
+    while (auto const node = this->settle_next()) {
+      this->relax_edges(*node, t_edges, no_heuristic);
+    }
+  }
+};
+
+// a Dijkstra instead of an A*
+inline constexpr auto NO_HEURISTIC = [](std::size_t) { return std::uint64_t{0}; };
+
+// the manhattan distance from a cell of t_grid (a flat index) to t_target, the heuristic of the searches on a grid that
+// move to one of the 4 neighbours at a time. t_grid has to outlive it
+template <typename T>
+[[nodiscard]] auto manhattan_to(Grid2D<T> const& t_grid, std::size_t const t_target) {
+  auto const [target_x, target_y] = t_grid.coordinates(t_target);
+  return [&t_grid, target_x, target_y](std::size_t const t_idx) {
+    auto const [x, y] = t_grid.coordinates(t_idx);
+    return static_cast<std::uint64_t>(std::abs(x - target_x) + std::abs(y - target_y));
+  };
+}
+
+}  // namespace aoc
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef SIMD_HPP_
+#define SIMD_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <immintrin.h>
+#define AOC_SIMD_X86
+#endif
+
+// Byte scanning kernels, compiled for every instruction set they support and picked at run time for the CPU they run
+// on, so that one binary built without -march=native (configure with -DENABLE_NATIVE_ARCH=OFF) still scans with AVX2
+// or AVX-512 where it can. A kernel classifies the bytes of a string into bit masks, 64 bytes per word (bit i of word w
+// is byte 64 * w + i), the caller then walks the set bits:
+//
+//    std::array<std::uint64_t, aoc::simd::mask_words(4096)> masks;
+//    aoc::simd::classify(block, aoc::simd::ByteClass::one('\n'), masks);
+//    for (auto bits = masks[0]; bits != 0; bits &= bits - 1) {
+//      auto const newline = static_cast<std::size_t>(std::countr_zero(bits));
+//      ...
+//    }
+//
+// The environment variable AOC_SIMD (scalar, sse4.2, avx2 or avx512) caps the instruction set, to compare them or to
+// check the fallbacks on a machine that supports them all
+namespace aoc::simd {
+
+enum class Level : std::uint8_t { SCALAR, SSE42, AVX2, AVX512 };
+
+[[nodiscard]] constexpr std::string_view to_string(Level const t_level) noexcept {
+  switch (t_level) {
+    case Level::SCALAR:
+      return "scalar";
+    case Level::SSE42:
+      return "sse4.2";
+    case Level::AVX2:
+      return "avx2";
+    case Level::AVX512:
+      return "avx512";
+  }
+
+  return "unknown";
+}
+
+// words needed for the masks of t_size bytes
+[[nodiscard]] constexpr std::size_t mask_words(std::size_t const t_size) noexcept { return (t_size + 63) / 64; }
+
+// the bytes in [lo_, hi_] and the ones equal to also_
+struct ByteClass {
+  char lo_;
+  char hi_;
+  char also_;
+
+  [[nodiscard]] static constexpr ByteClass one(char const t_chr) noexcept {
+    return {.lo_ = t_chr, .hi_ = t_chr, .also_ = t_chr};
+  }
+
+  [[nodiscard]] constexpr bool contains(char const t_chr) const noexcept {
+    return static_cast<unsigned char>(t_chr - this->lo_) <= static_cast<unsigned char>(this->hi_ - this->lo_) or
+           t_chr == this->also_;
+  }
+};
+
+namespace detail {
+
+// the low t_count bits
+[[nodiscard]] constexpr std::uint64_t low_bits(std::size_t const t_count) noexcept {
+  return t_count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << t_count) - 1;
+}
+
+// the bytes from t_from on, one by one
+inline void classify_scalar(std::string_view const t_str, ByteClass const t_class, std::size_t const t_from,
+                            std::uint64_t* const t_out) noexcept {
+  for (auto word = t_from / 64; word < mask_words(t_str.size()); ++word) {
+    t_out[word] = 0;
+  }
+
+  for (auto i = t_from; i < t_str.size(); ++i) {
+    if (t_class.contains(t_str[i])) {
+      t_out[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+}
+
+inline void equal_at_distance_scalar(std::string_view const t_str, std::size_t const t_distance,
+                                     std::size_t const t_from, std::uint64_t* const t_out) noexcept {
+  for (auto word = t_from / 64; word < mask_words(t_str.size()); ++word) {
+    t_out[word] = 0;
+  }
+
+  for (auto i = t_from; i + t_distance < t_str.size(); ++i) {
+    if (t_str[i] == t_str[i + t_distance]) {
+      t_out[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+}
+
+// the last bytes, less than a block, through a zero padded copy. The padding is masked out of the result
+template <typename Block>
+inline void classify_tail(std::string_view const t_str, ByteClass const t_class, std::size_t const t_from,
+                          std::uint64_t* const t_out, Block const& t_block) noexcept {
+  if (t_from == t_str.size()) {
+    return;
+  }
+
+  std::array<char, 64> padded{};
+  std::memcpy(padded.data(), t_str.data() + t_from, t_str.size() - t_from);
+  t_out[t_from / 64] = t_block(padded.data(), t_class) & low_bits(t_str.size() - t_from);
+}
+
+#if defined(AOC_SIMD_X86)
+
+// unsigned t_lo <= t_chunk <= t_hi as t_chunk - t_lo <= t_hi - t_lo, there is no unsigned byte comparison before
+// AVX-512
+__attribute__((target("sse4.2"))) inline std::uint64_t classify_block_sse42(char const* const t_data,
+                                                                            ByteClass const t_class) noexcept {
+  auto const lo   = _mm_set1_epi8(t_class.lo_);
+  auto const span = _mm_set1_epi8(static_cast<char>(t_class.hi_ - t_class.lo_));
+  auto const also = _mm_set1_epi8(t_class.also_);
+
+  std::uint64_t ret_val = 0;
+  for (std::size_t i = 0; i < 64; i += sizeof(__m128i)) {
+    auto const chunk   = _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_data + i));
+    auto const offset  = _mm_sub_epi8(chunk, lo);
+    auto const matches = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(offset, span), offset), _mm_cmpeq_epi8(chunk, also));
+    ret_val |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(matches))} << i;
+  }
+
+  return ret_val;
+}
+
+__attribute__((target("avx2"))) inline std::uint64_t classify_block_avx2(char const* const t_data,
+                                                                         ByteClass const t_class) noexcept {
+  auto const lo   = _mm256_set1_epi8(t_class.lo_);
+  auto const span = _mm256_set1_epi8(static_cast<char>(t_class.hi_ - t_class.lo_));
+  auto const also = _mm256_set1_epi8(t_class.also_);
+
+  std::uint64_t ret_val = 0;
+  for (std::size_t i = 0; i < 64; i += sizeof(__m256i)) {
+    auto const chunk   = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_data + i));
+    auto const offset  = _mm256_sub_epi8(chunk, lo);
+    auto const matches = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(offset, span), offset),
+                                         _mm256_cmpeq_epi8(chunk, also));
+    ret_val |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(matches))} << i;
+  }
+
+  return ret_val;
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::uint64_t
+classify_block_avx512(char const* const t_data, ByteClass const t_class) noexcept {
+  auto const chunk  = _mm512_loadu_si512(t_data);
+  auto const offset = _mm512_sub_epi8(chunk, _mm512_set1_epi8(t_class.lo_));
+  auto const span   = _mm512_set1_epi8(static_cast<char>(t_class.hi_ - t_class.lo_));
+  return _mm512_cmple_epu8_mask(offset, span) | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(t_class.also_));
+}
+
+__attribute__((target("sse4.2"))) inline void classify_sse42(std::string_view const t_str, ByteClass const t_class,
+                                                             std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 <= t_str.size(); i += 64) {
+    t_out[i / 64] = classify_block_sse42(t_str.data() + i, t_class);
+  }
+
+  classify_tail(t_str, t_class, i, t_out, classify_block_sse42);
+}
+
+__attribute__((target("avx2"))) inline void classify_avx2(std::string_view const t_str, ByteClass const t_class,
+                                                          std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 <= t_str.size(); i += 64) {
+    t_out[i / 64] = classify_block_avx2(t_str.data() + i, t_class);
+  }
+
+  classify_tail(t_str, t_class, i, t_out, classify_block_avx2);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void classify_avx512(std::string_view const t_str,
+                                                                        ByteClass const t_class,
+                                                                        std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 <= t_str.size(); i += 64) {
+    t_out[i / 64] = classify_block_avx512(t_str.data() + i, t_class);
+  }
+
+  classify_tail(t_str, t_class, i, t_out, classify_block_avx512);
+}
+
+// the blocks whose bytes and their partners t_distance further are all in t_str, the rest one by one
+__attribute__((target("sse4.2"))) inline void equal_at_distance_sse42(std::string_view const t_str,
+                                                                      std::size_t const t_distance,
+                                                                      std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 + t_distance <= t_str.size(); i += 64) {
+    std::uint64_t mask = 0;
+    for (std::size_t j = 0; j < 64; j += sizeof(__m128i)) {
+      auto const lhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_str.data() + i + j));
+      auto const rhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(t_str.data() + i + j + t_distance));
+      mask |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)))} << j;
+    }
+
+    t_out[i / 64] = mask;
+  }
+
+  equal_at_distance_scalar(t_str, t_distance, i, t_out);
+}
+
+__attribute__((target("avx2"))) inline void equal_at_distance_avx2(std::string_view const t_str,
+                                                                   std::size_t const t_distance,
+                                                                   std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 + t_distance <= t_str.size(); i += 64) {
+    std::uint64_t mask = 0;
+    for (std::size_t j = 0; j < 64; j += sizeof(__m256i)) {
+      auto const lhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_str.data() + i + j));
+      auto const rhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(t_str.data() + i + j + t_distance));
+      mask |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)))} << j;
+    }
+
+    t_out[i / 64] = mask;
+  }
+
+  equal_at_distance_scalar(t_str, t_distance, i, t_out);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void equal_at_distance_avx512(std::string_view const t_str,
+                                                                                 std::size_t const t_distance,
+                                                                                 std::uint64_t* const t_out) noexcept {
+  std::size_t i = 0;
+  for (; i + 64 + t_distance <= t_str.size(); i += 64) {
+    t_out[i / 64] = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(t_str.data() + i),
+                                           _mm512_loadu_si512(t_str.data() + i + t_distance));
+  }
+
+  equal_at_distance_scalar(t_str, t_distance, i, t_out);
+}
+
+#endif
+
+// what the CPU supports, capped by AOC_SIMD
+[[nodiscard]] inline Level detect_level() noexcept {
+  auto supported = Level::SCALAR;
+#if defined(AOC_SIMD_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw")) {
+    supported = Level::AVX512;
+  } else if (__builtin_cpu_supports("avx2")) {
+    supported = Level::AVX2;
+  } else if (__builtin_cpu_supports("sse4.2")) {
+    supported = Level::SSE42;
+  }
+#endif
+
+  auto const* const requested = std::getenv("AOC_SIMD");
+  if (requested == nullptr) {
+    return supported;
+  }
+
+  for (auto const level : {Level::SCALAR, Level::SSE42, Level::AVX2, Level::AVX512}) {
+    if (to_string(level) == requested) {
+      return level < supported ? level : supported;
+    }
+  }
+
+  return supported;
+}
+
+struct Kernels {
+  void (*classify_)(std::string_view, ByteClass, std::uint64_t*) noexcept;
+  void (*equal_at_distance_)(std::string_view, std::size_t, std::uint64_t*) noexcept;
+};
+
+[[nodiscard]] inline Kernels select_kernels(Level const t_level) noexcept {
+  switch (t_level) {
+#if defined(AOC_SIMD_X86)
+    case Level::AVX512:
+      return {.classify_ = &classify_avx512, .equal_at_distance_ = &equal_at_distance_avx512};
+    case Level::AVX2:
+      return {.classify_ = &classify_avx2, .equal_at_distance_ = &equal_at_distance_avx2};
+    case Level::SSE42:
+      return {.classify_ = &classify_sse42, .equal_at_distance_ = &equal_at_distance_sse42};
+#endif
+    default:
+      return {
+        .classify_ = [](std::string_view const t_str, ByteClass const t_class, std::uint64_t* const t_out) noexcept {
+          classify_scalar(t_str, t_class, 0, t_out);
+        },
+        .equal_at_distance_ = [](std::string_view const t_str, std::size_t const t_distance,
+                                 std::uint64_t* const t_out) noexcept {
+          equal_at_distance_scalar(t_str, t_distance, 0, t_out);
+        },
+      };
+  }
+}
+
+}  // namespace detail
+
+// the instruction set the kernels run with
+[[nodiscard]] inline Level level() noexcept {
+  static Level const ret_val = detail::detect_level();
+  return ret_val;
+}
+
+namespace detail {
+
+// picked once, on the first call of a kernel
+[[nodiscard]] inline Kernels const& kernels() noexcept {
+  static Kernels const ret_val = select_kernels(level());
+  return ret_val;
+}
+
+}  // namespace detail
+
+// bit i of t_out is set when t_str[i] is in t_class, t_out needs mask_words(t_str.size()) words
+inline void classify(std::string_view const t_str, ByteClass const t_class,
+                     std::span<std::uint64_t> const t_out) noexcept {
+  detail::kernels().classify_(t_str, t_class, t_out.data());
+}
+
+// bit i of t_out is set when t_str[i] == t_str[i + t_distance], t_out needs mask_words(t_str.size()) words
+inline void equal_at_distance(std::string_view const t_str, std::size_t const t_distance,
+                              std::span<std::uint64_t> const t_out) noexcept {
+  detail::kernels().equal_at_distance_(t_str, t_distance, t_out.data());
+}
+
+}  // namespace aoc::simd
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef SOLUTION_HPP_
+#define SOLUTION_HPP_
+
+#include "mapped_input.hpp"
+
+#include <concepts>
+#include <istream>
+
+namespace aoc {
+
+// A solution parses its input once, both parts then work on the same parsed result, e.g.
+//
+//    struct Day1 {
+//      using Parsed = std::vector<int>;
+//
+//      static Parsed parse(std::istream& t_in);
+//      static int part1(Parsed const& t_calories);
+//      static int part2(Parsed const& t_calories);
+//    };
+//
+// whatever the parts return is formatted by the runner. part2 is optional since some days (e.g. 2022 day 25) don't
+// have one.
+//
+// parse can either read from a std::istream or take a MappedInput (the whole file mapped and split into lines), which
+// avoids a std::string per line on large inputs
+template <typename T>
+concept ParsesStream = requires(std::istream& t_in) {
+  { T::parse(t_in) } -> std::same_as<typename T::Parsed>;
+};
+
+template <typename T>
+concept ParsesMappedInput = requires(MappedInput const& t_in) {
+  { T::parse(t_in) } -> std::same_as<typename T::Parsed>;
+};
+
+template <typename T>
+concept Solution = (ParsesStream<T> or ParsesMappedInput<T>) and requires(typename T::Parsed const& t_parsed) {
+  T::part1(t_parsed);
+};
+
+template <typename T>
+concept HasPart2 = Solution<T> and requires(typename T::Parsed const& t_parsed) { T::part2(t_parsed); };
+
+}  // namespace aoc
+
+#endif
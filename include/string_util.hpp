@@ -1,35 +1,169 @@
+#ifndef STRING_UTIL_HPP_
+#define STRING_UTIL_HPP_
+
+#include "simd.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <charconv>
-#include <range/v3/iterator/operations.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <range/v3/range/concepts.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/split.hpp>
+#include <range/v3/utility/semiregular_box.hpp>
+#include <range/v3/view/facade.hpp>
 #include <range/v3/view/transform.hpp>
 #include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-[[nodiscard]] inline auto split_string(std::string const& t_str, char t_delim = ' ') {
-  using ranges::views::transform, ranges::views::split, ranges::to_vector, ranges::distance;
-  auto ret_val = t_str | split(t_delim) | transform([](auto&& t_rng) {
-                   return std::string{&*t_rng.begin(), static_cast<std::size_t>(distance(t_rng))};
-                 }) |
-                 to_vector;
+namespace detail {
+
+// returns where the next delimiter starts (npos if there is none) and its length
+template <typename Delim>
+[[nodiscard]] constexpr std::pair<std::size_t, std::size_t> find_delimiter(std::string_view const t_str,
+                                                                           Delim const& t_delim,
+                                                                           std::size_t const t_from) noexcept {
+  if constexpr (std::same_as<Delim, char>) {
+    return {t_str.find(t_delim, t_from), 1};
+  } else if constexpr (std::convertible_to<Delim const&, std::string_view>) {
+    auto const delim = std::string_view{t_delim};
+    return {t_str.find(delim, t_from), delim.size()};
+  } else {
+    auto const iter = std::find_if(t_str.begin() + static_cast<std::ptrdiff_t>(t_from), t_str.end(), std::ref(t_delim));
+    return {iter == t_str.end() ? std::string_view::npos : static_cast<std::size_t>(iter - t_str.begin()), 1};
+  }
+}
+
+}  // namespace detail
+
+// Lazily splits a string into std::string_view tokens, nothing is allocated. The delimiter can be a char, a (non empty)
+// multi character string or a predicate on a char, e.g. tokenize(t_line, " -> ") or tokenize(t_line, ::isspace).
+//
+// Consecutive delimiters yield empty tokens, a trailing delimiter doesn't (same as ranges::views::split). The tokens
+// refer to the original string, which has to outlive them
+template <typename Delim>
+class Tokenizer : public ranges::view_facade<Tokenizer<Delim>, ranges::finite> {
+  friend struct ranges::range_access;
+
+  std::string_view str_;
+  ranges::semiregular_box_t<Delim> delim_;
+
+  struct cursor {
+    Tokenizer const* parent_ = nullptr;
+    std::size_t begin_       = 0;  // current token is [begin_, end_)
+    std::size_t end_         = 0;
+    std::size_t delim_size_  = 0;  // 0 if the current token is the last one
+    bool done_               = true;
+
+    cursor() = default;
+    explicit cursor(Tokenizer const* t_parent) : parent_{t_parent}, done_{t_parent->str_.empty()} {
+      if (not this->done_) {
+        this->find_token_end();
+      }
+    }
+
+    void find_token_end() {
+      auto const [pos, size] = detail::find_delimiter(this->parent_->str_, this->parent_->delim_.get(), this->begin_);
+      this->end_             = pos == std::string_view::npos ? this->parent_->str_.size() : pos;
+      this->delim_size_      = pos == std::string_view::npos ? 0 : size;
+    }
+
+    [[nodiscard]] std::string_view read() const noexcept {
+      return this->parent_->str_.substr(this->begin_, this->end_ - this->begin_);
+    }
+
+    void next() {
+      if (this->delim_size_ == 0 or this->end_ + this->delim_size_ == this->parent_->str_.size()) {
+        this->done_ = true;
+        return;
+      }
+
+      this->begin_ = this->end_ + this->delim_size_;
+      this->find_token_end();
+    }
+
+    [[nodiscard]] bool equal(ranges::default_sentinel_t /**/) const noexcept { return this->done_; }
+
+    [[nodiscard]] bool equal(cursor const& t_that) const noexcept {
+      return this->done_ == t_that.done_ and (this->done_ or this->begin_ == t_that.begin_);
+    }
+  };
+
+  [[nodiscard]] cursor begin_cursor() const { return cursor{this}; }
+
+ public:
+  Tokenizer() = default;
+  Tokenizer(std::string_view const t_str, Delim t_delim) : str_{t_str}, delim_{std::move(t_delim)} {}
+};
+
+[[nodiscard]] inline Tokenizer<char> tokenize(std::string_view const t_str, char const t_delim = ' ') {
+  return {t_str, t_delim};
+}
+
+[[nodiscard]] inline Tokenizer<std::string_view> tokenize(std::string_view const t_str,
+                                                          std::string_view const t_delim) {
+  return {t_str, t_delim};
+}
+
+template <std::predicate<char> Pred>
+[[nodiscard]] Tokenizer<Pred> tokenize(std::string_view const t_str, Pred t_pred) {
+  return {t_str, std::move(t_pred)};
+}
+
+// fixed size fast path for lines with a known layout, e.g. split_n<2>("move 3", ' ') == {"move", "3"}. The first N - 1
+// tokens are split off, the last one is the rest of the string (unsplit), missing tokens are empty
+template <std::size_t N, typename Delim>
+  requires(N > 0)
+[[nodiscard]] constexpr std::array<std::string_view, N> split_n(std::string_view const t_str, Delim const& t_delim) {
+  std::array<std::string_view, N> ret_val{};
+
+  std::size_t begin = 0;
+  for (std::size_t i = 0; i + 1 < N and begin <= t_str.size(); ++i) {
+    auto const [pos, size] = detail::find_delimiter(t_str, t_delim, begin);
+    if (pos == std::string_view::npos) {
+      ret_val[i] = t_str.substr(begin);
+      return ret_val;
+    }
+
+    ret_val[i] = t_str.substr(begin, pos - begin);
+    begin      = pos + size;
+  }
+
+  if (begin <= t_str.size()) {
+    ret_val[N - 1] = t_str.substr(begin);
+  }
 
   return ret_val;
 }
 
+// eager versions, only use them when the tokens need to outlive the string they come from
+[[nodiscard]] inline auto split_string(std::string const& t_str, char t_delim = ' ') {
+  using ranges::views::transform, ranges::to_vector;
+
+  AOC_TRACE_SCOPE("split_string");
+  return tokenize(t_str, t_delim) | transform([](std::string_view t_token) { return std::string{t_token}; }) |
+         to_vector;
+}
+
 [[nodiscard]] inline auto split_string(std::string_view t_str, char t_delim = ' ') {
-  using ranges::views::transform, ranges::views::split, ranges::to_vector, ranges::distance;
-  auto ret_val = t_str | split(t_delim) | transform([](auto&& t_rng) {
-                   return std::string_view{&*t_rng.begin(), static_cast<std::size_t>(distance(t_rng))};
-                 }) |
-                 to_vector;
+  using ranges::to_vector;
 
-  return ret_val;
+  AOC_TRACE_SCOPE("split_string");
+  return tokenize(t_str, t_delim) | to_vector;
 }
 
-template <typename StrType>
+template <typename StrType, std::integral T>
   requires(std::ranges::contiguous_range<StrType>)
-inline constexpr auto ranges_from_chars(StrType&& t_rng, int& t_res, int const t_base = 10) {
+inline constexpr auto ranges_from_chars(StrType&& t_rng, T& t_res, int const t_base = 10) {
   if constexpr (ranges::enable_view<std::remove_cvref_t<StrType>>) {
     auto const* const first = std::ranges::data(t_rng);
     auto const* const last  = first + std::ranges::size(t_rng);
@@ -42,3 +176,106 @@ inline constexpr auto ranges_from_chars(StrType&& t_rng, int& t_res, int const t
     return std::make_pair(std::span(ptr, last), err);
   }
 }
+
+namespace detail {
+
+[[nodiscard]] constexpr bool is_digit(char const t_chr) noexcept { return '0' <= t_chr and t_chr <= '9'; }
+
+// The positions where the numbers of t_str start, in order: a digit or, when WithSign, a '-' directly followed by a
+// digit. The characters are classified BLOCK at a time by the simd kernels (see simd.hpp), only the candidates they
+// find are checked one by one
+template <bool WithSign>
+class NumberStarts {
+  static constexpr std::size_t BLOCK     = 512;
+  static constexpr auto CANDIDATES       = aoc::simd::ByteClass{.lo_ = '0', .hi_ = '9', .also_ = WithSign ? '-' : '0'};
+  static constexpr std::uint64_t ALL_SET = ~std::uint64_t{0};
+
+  std::string_view str_;
+  std::size_t block_begin_ = 0;  // the classified characters are [block_begin_, block_end_)
+  std::size_t block_end_   = 0;
+  std::array<std::uint64_t, aoc::simd::mask_words(BLOCK)> masks_{};
+
+  // a lone '-' is a false positive of the classification
+  [[nodiscard]] bool is_start(std::size_t const t_idx) const noexcept {
+    return is_digit(this->str_[t_idx]) or
+           (WithSign and t_idx + 1 < this->str_.size() and is_digit(this->str_[t_idx + 1]));
+  }
+
+ public:
+  explicit NumberStarts(std::string_view const t_str) noexcept : str_{t_str} {}
+
+  // the first start at or after t_from (the size of the string if there is none), t_from can't go backward from one
+  // call to the next
+  [[nodiscard]] std::size_t next(std::size_t t_from) noexcept {
+    while (t_from < this->str_.size()) {
+      if (t_from >= this->block_end_) {
+        this->block_begin_ = t_from;
+        this->block_end_   = std::min(this->str_.size(), t_from + BLOCK);
+        aoc::simd::classify(this->str_.substr(t_from, BLOCK), CANDIDATES, this->masks_);
+      }
+
+      auto const offset = t_from - this->block_begin_;
+      for (auto word = offset / 64; word < aoc::simd::mask_words(this->block_end_ - this->block_begin_); ++word) {
+        auto bits = this->masks_[word] & (word == offset / 64 ? ALL_SET << (offset % 64) : ALL_SET);
+        for (; bits != 0; bits &= bits - 1) {
+          auto const idx = this->block_begin_ + word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+          if (this->is_start(idx)) {
+            return idx;
+          }
+        }
+      }
+
+      t_from = this->block_end_;
+    }
+
+    return this->str_.size();
+  }
+};
+
+}  // namespace detail
+
+// Extracts every integer of t_str, in order, into t_out and returns how many were written (it stops when t_out is
+// full). Everything that is not part of a number is skipped, so it works on a line as well as on a whole buffer, e.g.
+// "Sensor at x=2, y=-18" gives {2, -18}.
+//
+// For signed types a '-' directly in front of a number is its sign unless it follows a digit, "2-4,6-8" gives
+// {2, 4, 6, 8}. Unsigned types ignore signs. Overflowing numbers wrap around, the input is expected to be well formed
+template <std::integral T>
+[[nodiscard]] inline std::size_t scan_integers(std::string_view const t_str, std::span<T> const t_out) noexcept {
+  using Unsigned = std::make_unsigned_t<T>;
+
+  detail::NumberStarts<std::is_signed_v<T>> starts{t_str};
+  std::size_t count = 0;
+  std::size_t pos   = 0;
+  while (count < t_out.size()) {
+    pos = starts.next(pos);
+    if (pos == t_str.size()) {
+      break;
+    }
+
+    auto const negative = t_str[pos] == '-' and (pos == 0 or not detail::is_digit(t_str[pos - 1]));
+    if (t_str[pos] == '-') {
+      ++pos;
+    }
+
+    Unsigned value = 0;
+    for (; pos < t_str.size() and detail::is_digit(t_str[pos]); ++pos) {
+      value = static_cast<Unsigned>(value * 10U + static_cast<Unsigned>(t_str[pos] - '0'));
+    }
+
+    t_out[count++] = static_cast<T>(negative ? static_cast<Unsigned>(Unsigned{0} - value) : value);
+  }
+
+  return count;
+}
+
+// fixed count version for lines with a known number of integers, e.g. scan_n<3>("move 1 from 2 to 1") == {1, 2, 1}.
+// Missing integers are 0
+template <std::size_t N, std::integral T = int>
+[[nodiscard]] inline std::array<T, N> scan_n(std::string_view const t_str) noexcept {
+  std::array<T, N> ret_val{};
+  [[maybe_unused]] auto const count = scan_integers(t_str, std::span<T>{ret_val});
+  return ret_val;
+}
+
+#endif
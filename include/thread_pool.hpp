@@ -0,0 +1,313 @@
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/concepts.hpp>
+#include <range/v3/range/operations.hpp>
+#include <range/v3/range/primitives.hpp>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Work stealing pool shared by the days, use it through parallel_for, parallel_reduce and parallel_invoke below.
+//
+// Every worker has a deque of its own: it pushes and pops the tasks it spawns at the back (the most recent ones, still
+// hot in its cache) and, when it runs out, steals from the front of the others (the oldest ones, usually the largest
+// pieces of work). A thread waiting for its tasks runs tasks meanwhile instead of blocking, hence nested parallel calls
+// don't deadlock and don't need more threads
+class ThreadPool {
+  using Task = std::function<void()>;
+
+  struct Queue {
+    std::mutex mutex_;
+    std::deque<Task> tasks_;
+  };
+
+  // what the tasks of one run share, lives on the stack of the thread that waits for them
+  struct Join {
+    std::atomic<std::size_t> remaining_;
+    std::mutex mutex_;
+    std::exception_ptr error_;  // the first exception thrown by a task
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;  // one per worker, the last one for the threads outside of the pool
+  std::atomic<std::size_t> pending_ = 0;        // tasks in the queues
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+  bool stop_ = false;
+
+  std::vector<std::thread> workers_;
+
+  static inline thread_local ThreadPool const* current_pool = nullptr;
+  static inline thread_local std::size_t current_queue      = 0;
+
+  [[nodiscard]] std::size_t own_queue() const noexcept {
+    return current_pool == this ? current_queue : this->queues_.size() - 1;
+  }
+
+  // the most recent task of t_queue or, if there is none, the oldest of another queue
+  [[nodiscard]] std::optional<Task> pop(std::size_t const t_queue) {
+    for (std::size_t i = 0; i < this->queues_.size(); ++i) {
+      auto& queue = *this->queues_[(t_queue + i) % this->queues_.size()];
+
+      std::scoped_lock const lock{queue.mutex_};
+      if (queue.tasks_.empty()) {
+        continue;
+      }
+
+      auto task = std::move(i == 0 ? queue.tasks_.back() : queue.tasks_.front());
+      if (i == 0) {
+        queue.tasks_.pop_back();
+      } else {
+        queue.tasks_.pop_front();
+      }
+
+      this->pending_.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+
+    return std::nullopt;
+  }
+
+  [[nodiscard]] bool run_one(std::size_t const t_queue) {
+    auto task = this->pop(t_queue);
+    if (not task) {
+      return false;
+    }
+
+    (*task)();
+    return true;
+  }
+
+  void work(std::size_t const t_queue) {
+    current_pool  = this;
+    current_queue = t_queue;
+
+    for (;;) {
+      if (this->run_one(t_queue)) {
+        continue;
+      }
+
+      std::unique_lock lock{this->sleep_mutex_};
+      this->wake_up_.wait(lock, [&] { return this->stop_ or this->pending_.load(std::memory_order_relaxed) != 0; });
+      if (this->stop_) {
+        return;
+      }
+    }
+  }
+
+ public:
+  // t_threads counts the thread that calls run as well, the pool starts t_threads - 1 workers
+  explicit ThreadPool(std::size_t const t_threads) {
+#if defined(AOC_ENABLE_TRACING)
+    // the workers hand their events over when they exit, the recorder has to be destroyed after the pool
+    static_cast<void>(trace::recorder());
+#endif
+
+    auto const workers = std::max<std::size_t>(t_threads, 1) - 1;
+    for (std::size_t i = 0; i <= workers; ++i) {
+      this->queues_.push_back(std::make_unique<Queue>());
+    }
+
+    for (std::size_t i = 0; i < workers; ++i) {
+      this->workers_.emplace_back([this, i] { this->work(i); });
+    }
+  }
+
+  ThreadPool(ThreadPool const&)            = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::scoped_lock const lock{this->sleep_mutex_};
+      this->stop_ = true;
+    }
+
+    this->wake_up_.notify_all();
+    for (auto& worker : this->workers_) {
+      worker.join();
+    }
+  }
+
+  // threads running the tasks, the calling one included
+  [[nodiscard]] std::size_t size() const noexcept { return this->workers_.size() + 1; }
+
+  // index of the calling thread in [0, size()), the threads outside of the pool all get the last one
+  [[nodiscard]] std::size_t thread_index() const noexcept { return this->own_queue(); }
+
+  // Runs t_fn(0), ..., t_fn(t_count - 1), possibly in parallel, and returns once they are all done. The calling thread
+  // runs t_fn(0) and then whatever task is left while it waits. The first exception thrown by t_fn is rethrown here
+  template <typename Fn>
+  void run(std::size_t const t_count, Fn const& t_fn) {
+    if (t_count == 0) {
+      return;
+    }
+
+    if (t_count == 1 or this->workers_.empty()) {
+      for (std::size_t i = 0; i < t_count; ++i) {
+        t_fn(i);
+      }
+
+      return;
+    }
+
+    Join join{.remaining_ = t_count, .mutex_ = {}, .error_ = nullptr};
+    auto const run_task = [&](std::size_t const t_idx) {
+      try {
+        t_fn(t_idx);
+      } catch (...) {
+        std::scoped_lock const lock{join.mutex_};
+        if (not join.error_) {
+          join.error_ = std::current_exception();
+        }
+      }
+
+      join.remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    auto const queue = this->own_queue();
+    {
+      std::scoped_lock const lock{this->queues_[queue]->mutex_};
+      for (auto i = t_count - 1; i > 0; --i) {  // t_fn(1) at the back, this thread runs it next
+        this->queues_[queue]->tasks_.emplace_back([&run_task, i] { run_task(i); });
+      }
+    }
+
+    this->pending_.fetch_add(t_count - 1, std::memory_order_relaxed);
+    {
+      std::scoped_lock const lock{this->sleep_mutex_};  // no worker can be between its check and its wait
+    }
+    this->wake_up_.notify_all();
+
+    run_task(0);
+    while (join.remaining_.load(std::memory_order_acquire) != 0) {
+      if (not this->run_one(queue)) {
+        std::this_thread::yield();  // the last tasks are running elsewhere
+      }
+    }
+
+    if (join.error_) {
+      std::rethrow_exception(join.error_);
+    }
+  }
+};
+
+namespace detail {
+
+inline std::atomic<std::size_t> requested_threads = 0;
+
+}  // namespace detail
+
+// Size of the pool, has to be called before the first parallel call to have any effect (e.g. from --threads, see
+// arguments.hpp). 0 means the hardware concurrency, which is the default
+inline void set_thread_count(std::size_t const t_threads) noexcept {
+  detail::requested_threads.store(t_threads, std::memory_order_relaxed);
+}
+
+[[nodiscard]] inline ThreadPool& thread_pool() {
+  static ThreadPool pool{[] {
+    auto const requested = detail::requested_threads.load(std::memory_order_relaxed);
+    return requested != 0 ? requested : std::max(std::thread::hardware_concurrency(), 1U);
+  }()};
+
+  return pool;
+}
+
+namespace detail {
+
+// the elements of t_range split in about 4 chunks per thread (to balance chunks of uneven cost), as their first
+// iterator and their size
+template <ranges::forward_range Rng>
+[[nodiscard]] auto split_in_chunks(Rng& t_range) {
+  auto const size   = static_cast<std::size_t>(ranges::distance(t_range));
+  auto const chunks = std::min(size, thread_pool().size() * 4);
+
+  std::vector<std::pair<ranges::iterator_t<Rng>, std::size_t>> ret_val;
+  ret_val.reserve(chunks);
+
+  auto iter = ranges::begin(t_range);
+  for (std::size_t i = 0; i < chunks; ++i) {
+    auto const count = size / chunks + (i < size % chunks ? 1 : 0);
+    ret_val.emplace_back(iter, count);
+    iter = ranges::next(iter, static_cast<ranges::range_difference_t<Rng>>(count));
+  }
+
+  return ret_val;
+}
+
+}  // namespace detail
+
+// calls t_fn on every element of t_range, in parallel and in no particular order, e.g.
+//
+//    parallel_for(ranges::views::indices(rows), [&](std::size_t t_row) { ... });
+template <ranges::forward_range Rng, typename Fn>
+void parallel_for(Rng&& t_range, Fn const& t_fn) {
+  auto const chunks = detail::split_in_chunks(t_range);
+  thread_pool().run(chunks.size(), [&](std::size_t const t_chunk) {
+    auto [iter, count] = chunks[t_chunk];
+    for (; count > 0; --count, ++iter) {
+      std::invoke(t_fn, *iter);
+    }
+  });
+}
+
+// Reduces t_transform(element) of every element of t_range with t_reduce, starting from t_init, in parallel, e.g.
+//
+//    parallel_reduce(t_lines, 0, std::plus<>{}, [](std::string const& t_line) { return to_number(t_line); });
+//
+// t_reduce has to be associative, the elements are reduced chunk by chunk and the chunks in order, hence it doesn't
+// need to be commutative
+template <ranges::forward_range Rng, typename T, typename Reduce = std::plus<>, typename Transform = std::identity>
+[[nodiscard]] T parallel_reduce(Rng&& t_range, T t_init, Reduce const& t_reduce = {},
+                                Transform const& t_transform = {}) {
+  auto const chunks = detail::split_in_chunks(t_range);
+
+  std::vector<std::optional<T>> partials(chunks.size());
+  thread_pool().run(chunks.size(), [&](std::size_t const t_chunk) {
+    auto [iter, count] = chunks[t_chunk];
+    T partial          = std::invoke(t_transform, *iter);
+    for (++iter, --count; count > 0; --count, ++iter) {
+      partial = std::invoke(t_reduce, std::move(partial), std::invoke(t_transform, *iter));
+    }
+
+    partials[t_chunk] = std::move(partial);
+  });
+
+  for (auto& partial : partials) {
+    t_init = std::invoke(t_reduce, std::move(t_init), std::move(*partial));
+  }
+
+  return t_init;
+}
+
+// calls every one of t_fns, in parallel, and returns once they are all done
+template <std::invocable... Fns>
+void parallel_invoke(Fns&&... t_fns) {
+  auto const fns = std::forward_as_tuple(t_fns...);
+  thread_pool().run(sizeof...(Fns), [&](std::size_t const t_idx) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      static_cast<void>(((t_idx == I ? (std::invoke(std::get<I>(fns)), true) : false) or ...));
+    }(std::index_sequence_for<Fns...>{});
+  });
+}
+
+}  // namespace aoc
+
+#endif
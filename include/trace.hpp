@@ -0,0 +1,162 @@
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+// Scoped tracing in the Chrome trace event format, to see on a timeline (chrome://tracing or ui.perfetto.dev) where a
+// run spends its time, thread by thread
+//
+//    void simulate() {
+//      AOC_TRACE_SCOPE("simulate");  // one event from here to the end of the scope
+//      ...
+//    }
+//
+// The macro compiles to nothing unless AOC_ENABLE_TRACING is defined (configure with -DENABLE_TRACING=ON). Then
+// every thread records its scopes in a buffer of its own, the events of all of them are written when the program
+// exits to the file named by the AOC_TRACE_FILE environment variable, aoc_trace.json by default
+#if defined(AOC_ENABLE_TRACING)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fmt/os.h>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace aoc::trace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+  char const* name_;  // a string literal or another that outlives the recorder, it is neither copied nor escaped
+  Clock::time_point start_;
+  Clock::duration duration_;
+  std::uint32_t thread_;
+};
+
+// Collects the events of every thread and writes them at exit. A benchmark runs its parts thousands of times, past
+// MAX_EVENTS the events are only counted, a trace that large is too slow to open anyway
+class Recorder {
+  static constexpr std::size_t MAX_EVENTS = std::size_t{1} << 22U;
+
+  std::mutex mutex_;
+  std::vector<Event> events_;
+  std::size_t dropped_                    = 0;
+  std::atomic<std::uint32_t> next_thread_ = 0;
+
+  // the timestamps are the ones of the steady clock (the uptime on Linux), the viewers show them from the first event
+  void write() const {
+    using Us = std::chrono::duration<double, std::micro>;
+
+    auto const* const path = std::getenv("AOC_TRACE_FILE");
+    auto file              = fmt::output_file(path == nullptr ? "aoc_trace.json" : path);
+    file.print(R"({{"displayTimeUnit": "ns", "traceEvents": [)");
+    for (std::size_t i = 0; i < this->events_.size(); ++i) {
+      auto const& event = this->events_[i];
+      file.print(R"({}{{"name": "{}", "ph": "X", "ts": {:.3f}, "dur": {:.3f}, "pid": 1, "tid": {}}})",
+                 i == 0 ? "\n" : ",\n", event.name_, Us{event.start_.time_since_epoch()}.count(),
+                 Us{event.duration_}.count(), event.thread_);
+    }
+
+    file.print("\n]}}\n");
+  }
+
+ public:
+  Recorder() = default;
+
+  Recorder(Recorder const&)            = delete;
+  Recorder& operator=(Recorder const&) = delete;
+
+  ~Recorder() {
+    try {
+      this->write();
+    } catch (std::system_error const& t_error) {
+      fmt::println(stderr, "unable to write the trace: {}", t_error.what());
+    }
+
+    if (this->dropped_ != 0) {
+      fmt::println(stderr, "the trace is truncated, {} events dropped", this->dropped_);
+    }
+  }
+
+  [[nodiscard]] std::uint32_t new_thread_id() noexcept {
+    return this->next_thread_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void append(std::span<Event const> const t_events) {
+    std::scoped_lock const lock{this->mutex_};
+    auto const kept = std::min(t_events.size(), MAX_EVENTS - std::min(MAX_EVENTS, this->events_.size()));
+    this->events_.insert(this->events_.end(), t_events.begin(), t_events.begin() + static_cast<std::ptrdiff_t>(kept));
+    this->dropped_ += t_events.size() - kept;
+  }
+};
+
+[[nodiscard]] inline Recorder& recorder() {
+  static Recorder ret_val;
+  return ret_val;
+}
+
+// the events of one thread, handed over to the recorder in batches so that the threads don't contend on every scope
+class ThreadBuffer {
+  static constexpr std::size_t BATCH = 4096;
+
+  Recorder& recorder_;  // constructed before the buffer of any thread, hence destroyed after them
+  std::uint32_t const id_;
+  std::vector<Event> events_;
+
+ public:
+  ThreadBuffer() : recorder_{recorder()}, id_{recorder_.new_thread_id()} { this->events_.reserve(BATCH); }
+
+  ThreadBuffer(ThreadBuffer const&)            = delete;
+  ThreadBuffer& operator=(ThreadBuffer const&) = delete;
+
+  ~ThreadBuffer() { this->recorder_.append(this->events_); }
+
+  void push(char const* const t_name, Clock::time_point const t_start, Clock::time_point const t_end) {
+    this->events_.push_back(
+      Event{.name_ = t_name, .start_ = t_start, .duration_ = t_end - t_start, .thread_ = this->id_});
+    if (this->events_.size() == BATCH) {
+      this->recorder_.append(this->events_);
+      this->events_.clear();
+    }
+  }
+};
+
+[[nodiscard]] inline ThreadBuffer& thread_buffer() {
+  thread_local ThreadBuffer ret_val;
+  return ret_val;
+}
+
+// one event from its construction to its destruction, use it through AOC_TRACE_SCOPE
+class Scope {
+  char const* name_;
+  Clock::time_point start_;
+
+ public:
+  explicit Scope(char const* const t_name) noexcept : name_{t_name}, start_{Clock::now()} {}
+
+  Scope(Scope const&)            = delete;
+  Scope& operator=(Scope const&) = delete;
+
+  ~Scope() { thread_buffer().push(this->name_, this->start_, Clock::now()); }
+};
+
+}  // namespace aoc::trace
+
+#define AOC_TRACE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define AOC_TRACE_CONCAT(lhs, rhs)      AOC_TRACE_CONCAT_IMPL(lhs, rhs)
+
+#define AOC_TRACE_SCOPE(NAME) aoc::trace::Scope const AOC_TRACE_CONCAT(aoc_trace_scope_, __LINE__)(NAME)
+
+#else
+
+#define AOC_TRACE_SCOPE(NAME) static_cast<void>(0)
+
+#endif
+
+#endif
@@ -1,57 +1,59 @@
-#include <fmt/format.h>
-#include <fstream>
+#include "mapped_input.hpp"
+#include "registry.hpp"
+
+#include <charconv>
+#include <functional>
 #include <range/v3/algorithm/max.hpp>
 #include <range/v3/algorithm/partial_sort.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/getlines.hpp>
 #include <range/v3/view/split.hpp>
 #include <range/v3/view/take.hpp>
 #include <range/v3/view/transform.hpp>
-#include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 auto to_list_of_calories(auto&& t_inputs) {
   using ranges::views::split, ranges::views::transform, ranges::accumulate;
   auto&& elves_calory_list =
     t_inputs     //
     | split("")  //
     | transform([](auto&& t_calories) {
-        return accumulate(t_calories, 0, [](auto&& t_v, auto&& t_in) { return t_v + std::stoi(t_in); });
+        return accumulate(t_calories, 0, [](int const t_v, std::string_view const t_in) {
+          int calory = 0;
+          std::from_chars(t_in.data(), t_in.data() + t_in.size(), calory);
+          return t_v + calory;
+        });
       });
 
   return elves_calory_list;
 }
 
-void part1() {
-  using ranges::getlines, ranges::max;
+struct Day1 {
+  using Parsed = std::vector<int>;
 
-  std::ifstream elves_inventory_list((INPUT_FILE));
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::to_vector;
+    return to_list_of_calories(t_in) | to_vector;
+  }
 
-  auto lines               = getlines(elves_inventory_list);
-  auto list_of_calories    = to_list_of_calories(lines);
-  auto elf_with_max_calory = max(list_of_calories);
-
-  fmt::println("{}", elf_with_max_calory);
-}
+  static int part1(Parsed const& t_calories) {
+    using ranges::max;
+    return max(t_calories);
+  }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::accumulate, ranges::partial_sort, ranges::views::take;
+  static int part2(Parsed const& t_calories) {
+    using ranges::accumulate, ranges::partial_sort, ranges::views::take;
 
-  std::ifstream elves_inventory_list((INPUT_FILE));
+    auto rng = t_calories;
+    partial_sort(rng, begin(rng) + 3, std::greater<>());
 
-  auto lines = getlines(elves_inventory_list);
-  auto rng   = to_list_of_calories(lines) | to_vector;
-
-  partial_sort(rng, begin(rng) + 3, std::greater<>());
-
-  auto sum_of_greatest_3 = accumulate(rng | take(3), 0);
-  fmt::println("sum of greatest 3: {}", sum_of_greatest_3);
-}
+    return accumulate(rng | take(3), 0);
+  }
+};
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 1, Day1);
@@ -1,31 +1,18 @@
+#include "mapped_input.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
+
+#include <array>
 #include <cstdlib>
 #include <fmt/format.h>
-#include <fstream>
+#include <fmt/ranges.h>
+#include <iterator>
 #include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/view/getlines.hpp>
-
-void part1() {
-  using ranges::getlines, ranges::accumulate;
-
-  std::ifstream in((INPUT_FILE));
-
-  auto rng = getlines(in);
+#include <string>
+#include <string_view>
+#include <vector>
 
-  std::vector<int> x_value{1};
-  for (auto&& instr : rng) {
-    x_value.push_back(x_value.back());
-    if (auto decomposed_cmd = split_string(instr); decomposed_cmd[0] != "noop") {
-      x_value.push_back(x_value.back() + std::stoi(decomposed_cmd[1]));
-    }
-  }
-
-  static constexpr std::array CYCLE_NUMS = {20UL, 60UL, 100UL, 140UL, 180UL, 220UL};
-
-  fmt::println("sum of signal strength: {}", accumulate(CYCLE_NUMS, 0, [x_value](int t_sum, std::size_t t_cycle) {
-                 return t_sum + x_value[t_cycle - 1] * static_cast<int>(t_cycle);
-               }));
-}
+namespace {
 
 void update_crt(std::string& t_row, int const t_cycle, int const t_sprite_pos) {
   if ((t_sprite_pos - 1 <= t_cycle) and (t_cycle <= t_sprite_pos + 1)) {
@@ -33,39 +20,52 @@ void update_crt(std::string& t_row, int const t_cycle, int const t_sprite_pos) {
   }
 }
 
-void part2() {
-  using ranges::getlines;
+struct Day10 {
+  // value of the X register during each cycle, i.e. x_value[cycle - 1]
+  using Parsed = std::vector<int>;
+
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using namespace std::string_view_literals;
+
+    std::vector<int> x_value{1};
+    x_value.reserve(t_in.size() * 2 + 1);
+    for (auto const instr : t_in) {
+      x_value.push_back(x_value.back());
+      if (instr != "noop"sv) {  // addx <v>
+        int value = 0;
+        ranges_from_chars(instr.substr(std::size("addx "sv)), value);
+        x_value.push_back(x_value.back() + value);
+      }
+    }
 
-  static constexpr auto HEIGHT = 6;
-  static constexpr auto WIDTH  = 40;
+    return x_value;
+  }
 
-  std::ifstream in((INPUT_FILE));
+  static int part1(Parsed const& t_x_value) {
+    using ranges::accumulate;
 
-  auto rng = getlines(in);
+    static constexpr std::array CYCLE_NUMS = {20UL, 60UL, 100UL, 140UL, 180UL, 220UL};
 
-  std::array<std::string, HEIGHT> crt;
-  crt.fill("........................................");
+    return accumulate(CYCLE_NUMS, 0, [&](int t_sum, std::size_t t_cycle) {
+      return t_sum + t_x_value[t_cycle - 1] * static_cast<int>(t_cycle);
+    });
+  }
 
-  int sprite_position = 1;
+  static std::string part2(Parsed const& t_x_value) {
+    static constexpr auto HEIGHT = 6;
+    static constexpr auto WIDTH  = 40;
 
-  for (std::size_t cycle = 0; auto&& instr : rng) {
-    ++cycle;
-    update_crt(crt[(cycle - 1UL) / WIDTH], (static_cast<int>(cycle) - 1) % WIDTH, sprite_position);
-    if (auto const decomposed_cmd = split_string(instr); decomposed_cmd[0] == "addx") {
-      ++cycle;
-      update_crt(crt[(cycle - 1UL) / WIDTH], (static_cast<int>(cycle) - 1) % WIDTH, sprite_position);
-      sprite_position += stoi(std::string(decomposed_cmd[1]));
+    std::array<std::string, HEIGHT> crt;
+    crt.fill("........................................");
+
+    for (std::size_t cycle = 1; cycle <= HEIGHT * WIDTH and cycle <= t_x_value.size(); ++cycle) {
+      update_crt(crt[(cycle - 1UL) / WIDTH], (static_cast<int>(cycle) - 1) % WIDTH, t_x_value[cycle - 1]);
     }
-  }
 
-  for (auto&& row : crt) {
-    fmt::println("{}", row);
+    return fmt::format("\n{}", fmt::join(crt, "\n"));
   }
-}
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 10, Day10);
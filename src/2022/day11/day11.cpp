@@ -1,21 +1,23 @@
+#include "registry.hpp"
 #include "string_util.hpp"
 
+#include <array>
+#include <charconv>
 #include <cstdlib>
 #include <deque>
-#include <fmt/format.h>
-#include <fmt/ranges.h>
-#include <fstream>
 #include <functional>
+#include <istream>
 #include <range/v3/algorithm/partial_sort.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/drop.hpp>
 #include <range/v3/view/getlines.hpp>
-#include <range/v3/view/split.hpp>
 #include <range/v3/view/split_when.hpp>
 #include <range/v3/view/transform.hpp>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 struct Monkey {
   long long unsigned dividend_ = 3;
   std::deque<long long unsigned> items_;
@@ -72,8 +74,15 @@ inline auto const start_with_monkey = [](auto&& t_str, auto&& /**/) {
   return std::pair{t_str->starts_with("Monkey"), t_str};
 };
 
-inline auto const to_integer = [](auto&& t_str) {
-  return static_cast<long long unsigned>(std::stoi(std::string(t_str)));
+inline auto const to_integer = [](std::string_view const t_str) {
+  long long unsigned ret_val = 0;
+  std::from_chars(t_str.data(), t_str.data() + t_str.size(), ret_val);
+  return ret_val;
+};
+
+// e.g. "    If true: throw to monkey 2"
+inline auto const last_integer = [](std::string_view const t_str) {
+  return to_integer(t_str.substr(t_str.rfind(' ') + 1));
 };
 
 template <typename WorryLevelManager>
@@ -85,71 +94,68 @@ void execute_turn(Monkey& t_current_monkey, std::vector<Monkey>& t_monkeys, Worr
   }
 }
 
-std::vector<Monkey> get_monkey_list(std::fstream& t_in) {
-  using ranges::getlines, ranges::views::split_when, ranges::to_vector, ranges::views::transform, ranges::to,
-    ranges::views::drop, ranges::partial_sort;
+std::vector<Monkey> get_monkey_list(std::istream& t_in) {
+  using ranges::getlines, ranges::views::split_when, ranges::to_vector, ranges::views::transform, ranges::to;
 
   auto rng = getlines(t_in) | to_vector;
 
   std::vector<Monkey> monkeys;
   for (auto&& monkey_list : rng | split_when(start_with_monkey)) {
-    auto const& starting_item   = split_string(monkey_list[1]);
-    auto const& operation       = split_string(monkey_list[2]);
-    auto const& test            = static_cast<long long unsigned>(std::stoi(split_string(monkey_list[3]).back()));
-    auto const& true_recipient  = std::stoi(split_string(monkey_list[4]).back());
-    auto const& false_recipient = std::stoi(split_string(monkey_list[5]).back());
+    auto const starting_item = split_n<2>(monkey_list[1], ": ")[1];      // "  Starting items: 79, 98"
+    auto const operation     = split_n<2>(monkey_list[2], "= old ")[1];  // "  Operation: new = old * 19"
+    auto const operand       = operation.substr(2);
 
     auto& monkey      = monkeys.emplace_back();
-    monkey.items_     = starting_item | drop(4) | transform(to_integer) | to<std::deque>;
-    monkey.operation_ = std::pair{
-      operation[6][0],
-      operation.back() == "old" ? 0 : static_cast<std::size_t>(std::stoi(operation.back())),
+    monkey.items_     = tokenize(starting_item, ", ") | transform(to_integer) | to<std::deque>;
+    monkey.operation_ = std::pair{operation[0], operand == "old" ? 0 : to_integer(operand)};
+    monkey.test_      = last_integer(monkey_list[3]);
+    monkey.recipient_ = {
+      static_cast<int>(last_integer(monkey_list[4])),
+      static_cast<int>(last_integer(monkey_list[5])),
     };
-    monkey.test_      = test;
-    monkey.recipient_ = {true_recipient, false_recipient};
   }
 
   return monkeys;
 }
 
-void part1() {
-  using ranges::partial_sort;
+struct Day11 {
+  using Parsed = std::vector<Monkey>;
 
-  std::fstream in((INPUT_FILE));
+  static Parsed parse(std::istream& t_in) { return get_monkey_list(t_in); }
 
-  auto const worry_lvl_management = [](auto const t_worry_lvl) { return t_worry_lvl / 3; };
+  static long long part1(Parsed const& t_monkeys) {
+    using ranges::partial_sort;
 
-  auto monkeys = get_monkey_list(in);
-  for (std::size_t i = 0; i < 20; ++i) {
-    for (auto&& monkey : monkeys) {
-      execute_turn(monkey, monkeys, worry_lvl_management);
+    auto const worry_lvl_management = [](auto const t_worry_lvl) { return t_worry_lvl / 3; };
+
+    auto monkeys = t_monkeys;
+    for (std::size_t i = 0; i < 20; ++i) {
+      for (auto&& monkey : monkeys) {
+        execute_turn(monkey, monkeys, worry_lvl_management);
+      }
     }
-  }
 
-  partial_sort(begin(monkeys), begin(monkeys) + 2, end(monkeys), std::greater{}, &Monkey::get_inspected_time);
-  fmt::println("monkey business: {}", monkeys[0].inspected_time_ * monkeys[1].inspected_time_);
-}
+    partial_sort(begin(monkeys), begin(monkeys) + 2, end(monkeys), std::greater{}, &Monkey::get_inspected_time);
+    return monkeys[0].inspected_time_ * monkeys[1].inspected_time_;
+  }
 
-void part2() {
-  using ranges::partial_sort, ranges::accumulate;
-  std::fstream in((INPUT_FILE));
+  static long long part2(Parsed const& t_monkeys) {
+    using ranges::partial_sort, ranges::accumulate;
 
-  auto monkeys                        = get_monkey_list(in);
-  auto const max_meaningful_worry_lvl = accumulate(monkeys, 1ULL, std::multiplies<>{}, &Monkey::get_test);
-  auto const worry_lvl_management     = [=](auto const t_worry_lvl) { return t_worry_lvl % max_meaningful_worry_lvl; };
-  for (std::size_t i = 0; i < 10000; ++i) {
-    for (auto&& monkey : monkeys) {
-      execute_turn(monkey, monkeys, worry_lvl_management);
+    auto monkeys                        = t_monkeys;
+    auto const max_meaningful_worry_lvl = accumulate(monkeys, 1ULL, std::multiplies<>{}, &Monkey::get_test);
+    auto const worry_lvl_management = [=](auto const t_worry_lvl) { return t_worry_lvl % max_meaningful_worry_lvl; };
+    for (std::size_t i = 0; i < 10000; ++i) {
+      for (auto&& monkey : monkeys) {
+        execute_turn(monkey, monkeys, worry_lvl_management);
+      }
     }
-  }
 
-  partial_sort(begin(monkeys), begin(monkeys) + 2, end(monkeys), std::greater{}, &Monkey::get_inspected_time);
-  fmt::println("monkey business: {}", monkeys[0].inspected_time_ * monkeys[1].inspected_time_);
-}
+    partial_sort(begin(monkeys), begin(monkeys) + 2, end(monkeys), std::greater{}, &Monkey::get_inspected_time);
+    return monkeys[0].inspected_time_ * monkeys[1].inspected_time_;
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 11, Day11);
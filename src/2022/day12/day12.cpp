@@ -1,142 +1,132 @@
+#include "bfs.hpp"
+#include "grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
+#include "shortest_path.hpp"
+
+#include <algorithm>
 #include <array>
-#include <cstdlib>
-#include <fmt/format.h>
-#include <fstream>
-#include <queue>
-#include <range/v3/range/conversion.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <range/v3/view/cartesian_product.hpp>
-#include <range/v3/view/getlines.hpp>
 #include <range/v3/view/indices.hpp>
-#include <set>
 #include <vector>
 
-using Coor        = std::pair<int, int>;
-using CoorVisited = std::pair<Coor, int>;
+namespace {
 
-auto get_neighbor(Coor const& t_coor) {
-  return std::array{Coor{t_coor.first + 1, t_coor.second}, Coor{t_coor.first - 1, t_coor.second},
-                    Coor{t_coor.first, t_coor.second + 1}, Coor{t_coor.first, t_coor.second - 1}};
-}
+inline constexpr char BORDER = '#';  // around the map, never climbed to
 
 auto default_search_predicate(char const t_neighbor_height, char const t_current_height) {
   return static_cast<int>(t_neighbor_height - t_current_height) <= 1;
 }
 
-auto bfs(std::vector<std::string> const& t_map, std::vector<Coor> const& t_start, auto&& t_end_predicate,
-         bool (*t_search_predicate)(char, char) = default_search_predicate) {
-  // Use std::set<Coor>, where Coor contains pair of int and steps, instead of std::map<Coor, std::size_t>. we don't
-  // need to do check if steps to neighbor coordinate is less than previous visitation because in bfs, coor visited
-  // previously definitely has less steps than the same one visted later
+// the steps from the nearest of t_start to the first cell t_is_end accepts, the large levels of the large maps are
+// expanded in parallel
+int bfs(aoc::Grid2D<char> const& t_map, std::vector<std::size_t> const& t_start, auto&& t_is_end,
+        bool (*t_search_predicate)(char, char) = default_search_predicate) {
+  aoc::Bfs search{t_map.cells().size(), t_start, aoc::Bfs::Revisit::NEVER, aoc::Bfs::Execution::PARALLEL};
 
-  std::set<Coor> searched;
-  std::queue<CoorVisited> search_list;
-  for (auto&& start : t_start) {
-    searched.insert(search_list.emplace(start, 0).first);
-  }
+  // the border keeps the neighbors in the map, no bounds to check
+  auto const steps = search.find([&](std::size_t const t_cell) { return t_map.neighbors4(t_cell); },
+                                 [&](std::size_t const t_from, std::size_t const t_to) {
+                                   return t_map[t_to] != BORDER and t_search_predicate(t_map[t_to], t_map[t_from]);
+                                 },
+                                 t_is_end);
 
-  while (t_end_predicate(search_list.front().first)) {
-    auto const coor_to_visit   = search_list.front();
-    auto const [current, step] = coor_to_visit;
+  return static_cast<int>(steps.value());
+}
 
-    search_list.pop();
-    auto height = t_map[static_cast<std::size_t>(current.first)][static_cast<std::size_t>(current.second)];
+struct Day12 {
+  struct Parsed {
+    aoc::Grid2D<char> map_;  // 'S' and 'E' are replaced by their height, i.e. 'a' and 'z'
+    std::size_t start_;      // flat indices in map_
+    std::size_t end_;
+  };
 
-    for (auto&& neighbor : get_neighbor(current)) {
-      auto const [neighbor_x, neighbor_y] = neighbor;
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::views::cartesian_product, ranges::views::indices;
 
-      auto const out_bound = neighbor_x < 0 or neighbor_x >= static_cast<int>(t_map.size()) or  //
-                             neighbor_y < 0 or
-                             neighbor_y >= static_cast<int>(t_map[static_cast<std::size_t>(neighbor_x)].size());
-      auto const visited = searched.contains(neighbor);
-      if (out_bound or visited) {
-        continue;
-      }
+    Parsed ret_val{.map_ = aoc::Grid2D<char>::from_lines(t_in.lines(), 1, BORDER), .start_ = {}, .end_ = {}};
 
-      auto const x = static_cast<std::size_t>(neighbor_x);
-      auto const y = static_cast<std::size_t>(neighbor_y);
-      if (t_search_predicate(t_map[x][y], height)) {
-        auto&& coor = search_list.emplace(std::pair{neighbor_x, neighbor_y}, step + 1);
-        searched.insert(coor.first);
+    auto& map = ret_val.map_;
+    for (auto [y, x] : cartesian_product(indices(map.height()), indices(map.width()))) {
+      if (map[x, y] == 'S') {
+        map[x, y]      = 'a';
+        ret_val.start_ = map.index(x, y);
+      } else if (map[x, y] == 'E') {
+        map[x, y]    = 'z';
+        ret_val.end_ = map.index(x, y);
       }
     }
-  }
 
-  return search_list.front().second;
-}
+    return ret_val;
+  }
 
-auto parse_map(std::fstream& t_in, bool (*t_start_predicate)(char&), bool (*t_end_predicate)(char&)) {
-  using ranges::getlines, ranges::to_vector, ranges::views::cartesian_product, ranges::views::indices;
-
-  auto map = getlines(t_in) | to_vector;
-  std::vector<Coor> start;
-  Coor end;
-  for (auto [i, j] : cartesian_product(indices(map.size()), indices(map[0].size()))) {
-    if (t_start_predicate(map[i][j])) {
-      start.emplace_back(static_cast<int>(i), static_cast<int>(j));
-    } else if (t_end_predicate(map[i][j])) {
-      end = std::pair{static_cast<int>(i), static_cast<int>(j)};
-    }
+  static int part1(Parsed const& t_map) {
+    auto const end = t_map.end_;
+    return bfs(t_map.map_, std::vector{t_map.start_}, [end](std::size_t const t_cell) { return end == t_cell; });
   }
 
-  return std::tuple{map, start, end};
-}
+  // an A* instead: a step climbs a cell at most and moves a cell away, the steps left are at least the manhattan
+  // distance to 'E' and the height left to climb. Either of them only drops by one a step, but the height left jumps up
+  // when going down a slope, far out of the window of a bucket queue
+  static int part1_astar(Parsed const& t_map) {
+    auto const& map = t_map.map_;
+    auto const end  = t_map.end_;
 
-void part1() {
-  std::fstream in((INPUT_FILE));
+    aoc::ShortestPath search{map.cells().size(), std::array{t_map.start_}};
 
-  // just for fun, only do this in self learning project
-  constexpr auto start_predicate = [](char& t_c) { return t_c == 'S' ? (t_c = 'a', true) : false; };
-  constexpr auto end_predicate   = [](char& t_c) { return t_c == 'E' ? (t_c = 'z', true) : false; };
+    auto const climb = [&](std::size_t const t_cell, auto&& t_relax) {
+      for (auto const neighbor : map.neighbors4(t_cell)) {
+        if (map[neighbor] != BORDER and default_search_predicate(map[neighbor], map[t_cell])) {
+          t_relax(neighbor, 1);
+        }
+      }
+    };
 
-  auto const [map, start, end]{parse_map(in, start_predicate, end_predicate)};
+    auto const manhattan  = aoc::manhattan_to(map, end);
+    auto const steps_left = [&](std::size_t const t_cell) {
+      return std::max(manhattan(t_cell), static_cast<std::uint64_t>('z' - map[t_cell]));
+    };
 
-  fmt::println("min cost: {}", bfs(map, start, [end](Coor const& t_to_search) { return end != t_to_search; }));
-}
+    auto const steps = search.find(climb, steps_left, [end](std::size_t const t_cell) { return end == t_cell; });
+    return static_cast<int>(steps.value());
+  }
 
-void part2() {
   // 2 ways to do it:
   //
   //  1. find 'forward', i.e. find minimum steps for all 'a'
   //  2. find 'backward', i.e., BFS starting from 'E' and search for first encountered 'a'
-  std::fstream in((INPUT_FILE));
-
-  // just for fun, only do this in self learning project
-  constexpr auto start_predicate = [](char& t_c) { return t_c == 'S' ? (t_c = 'a', true) : t_c == 'a'; };
-  constexpr auto end_predicate   = [](char& t_c) { return t_c == 'E' ? (t_c = 'z', true) : false; };
-
-  auto const [map, start, end]{parse_map(in, start_predicate, end_predicate)};
+  static int part2(Parsed const& t_map) {
+    using ranges::views::cartesian_product, ranges::views::indices;
 
-  fmt::println("min cost: {}", bfs(map, start, [end](Coor const& t_to_search) { return end != t_to_search; }));
-}
-
-void part2_backward_find() {
-  std::fstream in((INPUT_FILE));
+    auto const& map = t_map.map_;
 
-  // just for fun, only do this in self learning project
-  constexpr auto start_predicate = [](char& t_c) { return t_c == 'E' ? (t_c = 'z', true) : false; };
+    std::vector<std::size_t> start;
+    for (auto [y, x] : cartesian_product(indices(map.height()), indices(map.width()))) {
+      if (map[x, y] == 'a') {
+        start.push_back(map.index(x, y));
+      }
+    }
 
-  // end is not meaningful as we are finding first appeared 'a', we don't need to know how many 'a' there are
-  constexpr auto end_predicate = [](char& t_c) { return t_c == 'S' ? (t_c = 'a', false) : false; };
+    auto const end = t_map.end_;
+    return bfs(map, start, [end](std::size_t const t_cell) { return end == t_cell; });
+  }
 
-  auto const [map, start, _]{parse_map(in, start_predicate, end_predicate)};
+  static int part2_backward_find(Parsed const& t_map) {
+    auto const& map = t_map.map_;
 
-  auto const continue_search_predicate = [map](Coor const& t_coor) {
-    auto const [x, y] = t_coor;
-    return map[static_cast<std::size_t>(x)][static_cast<std::size_t>(y)] != 'a';
-  };
+    auto const end_predicate = [&map](std::size_t const t_cell) { return map[t_cell] == 'a'; };
 
-  constexpr auto valid_neighbor_predicate = [](char const t_neighbor_height, char const t_current_height) {
-    return t_current_height - t_neighbor_height <= 1;
-  };
+    constexpr auto valid_neighbor_predicate = [](char const t_neighbor_height, char const t_current_height) {
+      return t_current_height - t_neighbor_height <= 1;
+    };
 
-  fmt::println("backward find algo, min cost: {}",
-               bfs(map, start, continue_search_predicate, valid_neighbor_predicate));
-}
+    return bfs(map, std::vector{t_map.end_}, end_predicate, valid_neighbor_predicate);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
-  part2_backward_find();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 12, Day12, aoc::part<&Day12::part1_astar>("1_astar"),
+             aoc::part<&Day12::part2_backward_find>("2_backward"));
@@ -1,8 +1,9 @@
+#include "registry.hpp"
+
 #include <cctype>
 #include <charconv>
 #include <cstdlib>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <iterator>
 #include <range/v3/algorithm/lower_bound.hpp>
 #include <range/v3/algorithm/sort.hpp>
@@ -19,6 +20,8 @@
 #include <variant>
 #include <vector>
 
+namespace {
+
 struct Node {
   using Signal = std::variant<int, Node>;
   std::vector<Signal> signals_;
@@ -118,61 +121,51 @@ Node parse_node(std::string_view const t_str) {
   return lhs;
 }
 
-std::vector<std::pair<Node, Node>> signal_parser(std::fstream& t_in) {
-  using ranges::getlines, ranges::to_vector, ranges::views::split, ranges::views::transform, ranges::begin,
-    ranges::next;
-
-  auto const rng = getlines(t_in) | to_vector;
-  auto ret_val   = rng | split("") | transform([](auto&& t_signal_pair) {
-                   return std::pair{parse_node(*begin(t_signal_pair)), parse_node(*next(begin(t_signal_pair)))};
-                 }) |
-                 to_vector;
+struct Day13 {
+  using Parsed = std::vector<Node>;
 
-  return ret_val;
-}
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::filter, ranges::views::transform;
 
-void part1() {
-  std::fstream in((INPUT_FILE));
+    return getlines(t_in)                                            //
+           | filter([](auto&& t_str) { return not t_str.empty(); })  //
+           | transform(parse_node)                                   //
+           | to_vector;
+  }
 
-  NodeVisitor visitor{};
-  auto const signals = signal_parser(in);
+  static std::size_t part1(Parsed const& t_signals) {
+    NodeVisitor visitor{};
 
-  std::size_t result = 0;
-  for (std::size_t i = 0; i < signals.size(); ++i) {
-    if (auto&& [lhs, rhs] = signals[i]; visitor(lhs, rhs) == Result::Right) {
-      result += (i + 1);
+    std::size_t result = 0;
+    for (std::size_t i = 0; i + 1 < t_signals.size(); i += 2) {
+      if (visitor(t_signals[i], t_signals[i + 1]) == Result::Right) {
+        result += (i / 2 + 1);
+      }
     }
+
+    return result;
   }
 
-  fmt::println("sum of right order signals: {}", result);
-}
+  static long part2(Parsed const& t_signals) {
+    using namespace std::string_view_literals;
+    using ranges::sort;
 
-void part2() {
-  using namespace std::string_view_literals;
-  using ranges::getlines, ranges::to_vector, ranges::views::filter, ranges::sort, ranges::views::transform;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in)                                              //
-             | filter([](auto&& t_str) { return not t_str.empty(); })  //
-             | transform(parse_node)                                   //
-             | to_vector;
-
-  auto const predicate = [visitor = NodeVisitor{}](auto&& t_lhs, auto&& t_rhs) {
-    return visitor(t_lhs, t_rhs) == Result::Right;
-  };
-
-  sort(rng, predicate);
-
-  // divider_packet_2 need to consider the presence of divider_packet_1 when calculating index (using lower_bound)
-  // or using upper_bound to count backward
-  auto const divider_packet_1 = ranges::lower_bound(rng, parse_node("[[2]]"sv), predicate) - rng.begin() + 1;
-  auto const divider_packet_2 = ranges::lower_bound(rng, parse_node("[[6]]"sv), predicate) - rng.begin() + 2;
-  fmt::println("packets position: {}, {}, decoder key: {}", divider_packet_1, divider_packet_2,
-               divider_packet_1 * divider_packet_2);
-}
+    auto rng = t_signals;
+
+    auto const predicate = [visitor = NodeVisitor{}](auto&& t_lhs, auto&& t_rhs) {
+      return visitor(t_lhs, t_rhs) == Result::Right;
+    };
+
+    sort(rng, predicate);
+
+    // divider_packet_2 need to consider the presence of divider_packet_1 when calculating index (using lower_bound)
+    // or using upper_bound to count backward
+    auto const divider_packet_1 = ranges::lower_bound(rng, parse_node("[[2]]"sv), predicate) - rng.begin() + 1;
+    auto const divider_packet_2 = ranges::lower_bound(rng, parse_node("[[6]]"sv), predicate) - rng.begin() + 2;
+    return divider_packet_1 * divider_packet_2;
+  }
+};
+
+}  // namespace
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 13, Day13);
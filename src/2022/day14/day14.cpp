@@ -1,27 +1,35 @@
+#include "bit_grid.hpp"
+#include "grid.hpp"
+#include "metrics.hpp"
 #include "pairview.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <optional>
 #include <range/v3/algorithm/minmax.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/filter.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/join.hpp>
 #include <range/v3/view/transform.hpp>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
 
 using Coor = std::pair<int, int>;
-using namespace std::string_view_literals;
 
 static constexpr auto CAVE_POURING_POINT_X = 500;
 
 // this looks like binary tree traverse thingy to me -> recursive is the way
-bool drop_sand(std::vector<std::string>& t_map, Coor const& t_start, std::size_t& t_sand_count, auto&& t_move_y,
-               auto&& t_move_left, auto&& t_move_right) {
+bool drop_sand(aoc::Grid2D<char>& t_map, Coor const& t_start, std::size_t& t_sand_count, auto&& t_move_y) {
+  AOC_METRIC_DEPTH("day14.depth");
+  AOC_METRIC_COUNT("day14.expanded");
   auto const [sand_start_x, sand_start_y] = t_start;
 
   auto sand_x_idx = static_cast<std::size_t>(sand_start_x);
@@ -29,171 +37,139 @@ bool drop_sand(std::vector<std::string>& t_map, Coor const& t_start, std::size_t
 
   auto const sand_y_pos = t_move_y(t_map, sand_x_idx, sand_y_idx);
   if (not sand_y_pos) {
+    AOC_METRIC_COUNT("day14.fell_out");
     return false;
   }
 
+  // the map is wider than the pile can ever get, left and right are always in it
   sand_y_idx = *sand_y_pos;
-  if (t_move_left(t_map, sand_x_idx, sand_y_idx)) {
+  if (t_map[sand_x_idx - 1, sand_y_idx] == '.') {
     return drop_sand(t_map, Coor{static_cast<int>(sand_x_idx) - 1, static_cast<int>(sand_y_idx)}, t_sand_count,
-                     t_move_y, t_move_left, t_move_right);
+                     t_move_y);
   }
 
-  if (t_move_right(t_map, sand_x_idx, sand_y_idx)) {
+  if (t_map[sand_x_idx + 1, sand_y_idx] == '.') {
     return drop_sand(t_map, Coor{static_cast<int>(sand_x_idx) + 1, static_cast<int>(sand_y_idx)}, t_sand_count,
-                     t_move_y, t_move_left, t_move_right);
+                     t_move_y);
   }
 
-  t_map[sand_y_idx - 1U][sand_x_idx] = 'o';
+  t_map[sand_x_idx, sand_y_idx - 1U] = 'o';
   ++t_sand_count;
+  AOC_METRIC_COUNT("day14.settled");
   return true;
 }
 
+// The pile of part 2 can't spread further than its height on either side of the pouring point, the map is that wide
+// and has a row of air below the lowest rock. Its border is rock, the bottom row of the border is the floor of part 2
 auto scan_to_map(std::vector<std::vector<Coor>> const& t_scans) {
   using ranges::views::join, ranges::minmax;
 
   auto const [min_x, max_x] = minmax(t_scans | join, std::less<int>{}, [](auto&& t_coor) { return t_coor.first; });
   auto const [min_y, max_y] = minmax(t_scans | join, std::less<int>{}, [](auto&& t_coor) { return t_coor.second; });
 
-  auto const width  = static_cast<std::size_t>(max_x.first) - static_cast<std::size_t>(min_x.first) + 1;
-  auto const length = static_cast<std::size_t>(max_y.second) + 1;
+  auto const floor_y = max_y.second + 2;
+  auto const left    = std::min(min_x.first, CAVE_POURING_POINT_X - floor_y);
+  auto const right   = std::max(max_x.first, CAVE_POURING_POINT_X + floor_y);
+
+  auto const width  = static_cast<std::size_t>(right - left + 1);
+  auto const length = static_cast<std::size_t>(floor_y);
 
-  std::vector<std::string> map(length, std::string(width, '.'));
+  aoc::Grid2D<char> map{width, length, '.', 1, '#'};
 
   for (auto&& scan : t_scans) {
     for (auto&& [first, second] : ranges::views::pairview(scan)) {  // need const version of pairview
       auto const [x_start, x_end] = minmax(first.first, second.first);
       for (int x_curr = x_start; x_curr <= x_end; ++x_curr) {
-        auto const y_idx  = static_cast<std::size_t>(first.second);
-        auto const x_idx  = static_cast<std::size_t>(x_curr - min_x.first);
-        map[y_idx][x_idx] = '#';
+        map[x_curr - left, first.second] = '#';
       }
 
       auto const [y_start, y_end] = minmax(first.second, second.second);
       for (int y_curr = y_start; y_curr <= y_end; ++y_curr) {
-        auto const y_idx  = static_cast<std::size_t>(y_curr);
-        auto const x_idx  = static_cast<std::size_t>(first.first - min_x.first);
-        map[y_idx][x_idx] = '#';
+        map[first.first - left, y_curr] = '#';
       }
     }
   }
 
-  return std::pair{map, CAVE_POURING_POINT_X - min_x.first};
+  return std::pair{map, CAVE_POURING_POINT_X - left};
 }
 
-auto to_coor_vec(std::string const& t_str) {
-  using ranges::to_vector, ranges::views::transform, ranges::views::filter;
+auto to_coor_vec(std::string_view const t_str) {
+  using ranges::to_vector, ranges::views::transform;
+
+  auto const str_to_vec = [](std::string_view const t_num_str) {
+    auto const [x_str, y_str] = split_n<2>(t_num_str, ',');
 
-  auto const str_to_vec = [](auto&& t_num_str) {
-    auto number_split = split_string(t_num_str, ',');
-    return Coor{std::stoi(number_split[0]), std::stoi(number_split[1])};
+    Coor ret_val;
+    ranges_from_chars(x_str, ret_val.first);
+    ranges_from_chars(y_str, ret_val.second);
+    return ret_val;
   };
 
-  auto const splitted = split_string(t_str);                                   //
-  auto ret_val        = splitted                                               //
-                 | filter([](auto&& t_filter) { return t_filter != "->"sv; })  //
-                 | transform(str_to_vec)                                       //
-                 | to_vector;
-  return ret_val;
+  return tokenize(t_str, " -> ") | transform(str_to_vec) | to_vector;
 };
 
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::minmax, ranges::views::transform;
-
-  std::fstream in((INPUT_FILE));
-  auto rng               = getlines(in) | transform(to_coor_vec) | to_vector;
-  auto [map, sand_x_idx] = scan_to_map(rng);
-
-  constexpr auto move_y = [](std::vector<std::string> const& t_map, std::size_t t_x,
-                             std::size_t t_y) -> std::optional<std::size_t> {
-    if (t_x == 0 or t_x == t_map[t_y].size() - 1) {
-      return std::nullopt;
-    }
-
-    while (t_map[t_y][t_x] == '.') {
-      if (++t_y >= t_map.size()) {
-        return std::nullopt;
-      }
-    }
-
-    return t_y;
-  };
+struct Cave {
+  aoc::Grid2D<char> map_;
+  int sand_x_idx_;
+};
 
-  constexpr auto move_left = [](std::vector<std::string> const& t_map, std::size_t t_x, std::size_t t_y) {
-    return t_map[t_y][t_x - 1U] == '.';
-  };
+struct Day14 {
+  using Parsed = Cave;
 
-  constexpr auto move_right = [](std::vector<std::string> const& t_map, std::size_t t_x, std::size_t t_y) {
-    return t_map[t_y][t_x + 1] == '.';
-  };
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::transform;
 
-  std::size_t result = 0;
-  while (drop_sand(map, Coor{sand_x_idx, 0}, result, move_y, move_left, move_right)) {
+    auto [map, sand_x_idx] = scan_to_map(getlines(t_in) | transform(to_coor_vec) | to_vector);
+    return Cave{.map_ = std::move(map), .sand_x_idx_ = sand_x_idx};
   }
 
-  map[0][static_cast<std::size_t>(sand_x_idx)] = '+';
-  fmt::println("Units of sand: {}", result);
-}
-
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to_vector;
-
-  std::fstream in((INPUT_FILE));
-  auto rng               = getlines(in) | transform(to_coor_vec) | to_vector;
-  auto [map, sand_x_idx] = scan_to_map(rng);
+  static std::size_t part1(Parsed const& t_cave) {
+    auto map              = t_cave.map_;
+    auto const sand_x_idx = t_cave.sand_x_idx_;
 
-  auto start = Coor{sand_x_idx, 0};
-
-  constexpr auto move_y = [](std::vector<std::string> const& t_map, std::size_t t_x, std::size_t t_y) {
-    while (t_map[t_y][t_x] == '.') {
-      ++t_y;
-    }
-
-    return t_y != 0 ? std::optional{t_y} : std::nullopt;
-  };
-
-  auto move_left = [&start](std::vector<std::string>& t_map, std::size_t& t_x, std::size_t t_y) {
-    if (t_x == 0) {
-      ++start.first;
-      ++t_x;
-
-      for (auto& row : t_map) {
-        row.insert(0, "."sv);
+    // below the lowest rock there is only the floor, which doesn't exist yet
+    constexpr auto move_y = [](aoc::Grid2D<char> const& t_map, std::size_t const t_x,
+                               std::size_t t_y) -> std::optional<std::size_t> {
+      while (t_map[t_x, t_y] == '.') {
+        ++t_y;
       }
 
-      t_map.back().front() = '#';
+      return t_y < t_map.height() ? std::optional{t_y} : std::nullopt;
+    };
+
+    std::size_t result = 0;
+    while (drop_sand(map, Coor{sand_x_idx, 0}, result, move_y)) {
     }
 
-    return t_map[t_y][t_x - 1] == '.';
-  };
+    map[sand_x_idx, 0] = '+';
+    return result;
+  }
 
-  constexpr auto move_right = [](std::vector<std::string>& t_map, std::size_t t_x, std::size_t t_y) {
-    if (t_x + 1 == t_map[t_y].size()) {
-      for (auto& row : t_map) {
-        row += '.';
+  // Where the sand comes to rest is where it can get to: a tile is filled when one of the three tiles above it is, unless
+  // it is rock. The rows are filled one after the other down to the floor, 64 tiles at a time
+  static std::size_t part2(Parsed const& t_cave) {
+    auto const& map = t_cave.map_;
+
+    aoc::BitGrid sand{map.width(), 1};
+    sand.set(static_cast<std::size_t>(t_cave.sand_x_idx_), 0);
+
+    std::size_t result = sand.count();
+    for (std::size_t y = 1; y < map.height(); ++y) {
+      aoc::BitGrid rock{map.width(), 1};
+      for (std::size_t x = 0; x < map.width(); ++x) {
+        if (map[x, y] == '#') {
+          rock.set(x, 0);
+        }
       }
 
-      t_map.back().back() = '#';
+      sand    = and_not(sand | sand.shifted(1, 0) | sand.shifted(-1, 0), rock);
+      result += sand.count();
     }
 
-    return t_map[t_y][t_x + 1] == '.';
-  };
-
-  // add floor
-  map.emplace_back(map.front().size(), '.');
-  map.emplace_back(map.front().size(), '#');
-
-  std::size_t result = 0;
-
-  while (drop_sand(map, start, result, move_y, move_left, move_right)) {
+    return result;
   }
+};
 
-  map[0][static_cast<std::size_t>(start.first)] = '+';
-  fmt::println("units of sand: {}", result);
-}
-
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 14, Day14);
@@ -1,28 +1,42 @@
+#include "mapped_input.hpp"
+#include "registry.hpp"
+#include "string_util.hpp"
+#include "thread_pool.hpp"
+
 #include <algorithm>
-#include <ctre.hpp>
-#include <fmt/format.h>
-#include <fstream>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/sort.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
-#include <range/v3/view/getlines.hpp>
+#include <range/v3/view/indices.hpp>
 #include <range/v3/view/transform.hpp>
+#include <string_view>
 #include <utility>
+#include <vector>
+
+namespace {
 
 using Coor = std::pair<int, int>;
 
-inline constexpr auto ROW_TO_CHECK = 2000000;
+inline constexpr auto ROW_TO_CHECK    = 2000000;
+inline constexpr auto SEARCH_AREA_MAX = 4000000;  // the beacon of part 2 is in [0, SEARCH_AREA_MAX]^2
+
+[[nodiscard]] constexpr bool in_search_area(Coor const& t_coor) noexcept {
+  return 0 <= t_coor.first and t_coor.first <= SEARCH_AREA_MAX and 0 <= t_coor.second and
+         t_coor.second <= SEARCH_AREA_MAX;
+}
 
 auto manhattan(Coor const& t_first, Coor const& t_second) {
   return std::abs(t_first.first - t_second.first) + std::abs(t_first.second - t_second.second);
 }
 
 constexpr auto to_tuning_freq(Coor const& t_coor) {
-  static constexpr auto MULTIPLIER = 4000000;
-  return static_cast<double>(t_coor.first) * MULTIPLIER + static_cast<double>(t_coor.second);
+  static constexpr auto MULTIPLIER = 4000000LL;
+  return static_cast<long long>(t_coor.first) * MULTIPLIER + static_cast<long long>(t_coor.second);
 }
 
 class Sensor {
@@ -87,10 +101,10 @@ class Sensor {
   [[nodiscard]] bool operator==(Sensor const&) const = default;
 };
 
-auto str_to_sensor(std::string const& t_str) {
-  auto coors = ctre::match<"[a-zA-Z ]+x=(-?[0-9]+), y=(-?[0-9]+):[a-zA-Z ]+x=(-?[0-9]+), y=(-?[0-9]+)">(t_str);
-  return Sensor{{std::stoi(coors.get<1>().to_string()), std::stoi(coors.get<2>().to_string())},
-                {std::stoi(coors.get<3>().to_string()), std::stoi(coors.get<4>().to_string())}};
+// e.g. "Sensor at x=2, y=18: closest beacon is at x=-2, y=15"
+auto str_to_sensor(std::string_view const t_str) {
+  auto const [x, y, beacon_x, beacon_y] = scan_n<4>(t_str);
+  return Sensor{{x, y}, {beacon_x, beacon_y}};
 }
 
 auto get_merged_ranges(std::vector<Sensor> const& t_sensors, int const t_row) {
@@ -116,48 +130,61 @@ auto get_merged_ranges(std::vector<Sensor> const& t_sensors, int const t_row) {
   return reduced_x_ranges;
 }
 
-void part1() {
-  using ranges::getlines, ranges::views::transform, ranges::to_vector, ranges::accumulate;
+struct Day15 {
+  using Parsed = std::vector<Sensor>;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform(str_to_sensor) | to_vector;
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::views::transform, ranges::to_vector;
+    return t_in | transform(str_to_sensor) | to_vector;
+  }
 
-  auto const reduced_x_ranges = get_merged_ranges(rng, ROW_TO_CHECK);
-  int result                  = accumulate(reduced_x_ranges, 0, std::plus<>{}, [&](auto&& t_rng) {
-    auto&& [min_x, max_x] = t_rng;
-    return max_x - min_x + 1;
-  });
+  static int part1(Parsed const& t_sensors) {
+    using ranges::accumulate;
 
-  fmt::println("number of positions where a beacon cannot be present: {}", result);
-}
+    auto const reduced_x_ranges = get_merged_ranges(t_sensors, ROW_TO_CHECK);
+    return accumulate(reduced_x_ranges, 0, std::plus<>{}, [&](auto&& t_rng) {
+      auto&& [min_x, max_x] = t_rng;
+      return max_x - min_x + 1;
+    });
+  }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::views::transform, ranges::all_of, ranges::views::filter;
+  static long long part2(Parsed const& t_sensors) {
+    using ranges::all_of, ranges::views::filter, ranges::views::indices;
+
+    // the beacon is the one cell of the search area no sensor covers, hence just out of reach of some of them. Their
+    // edges are scanned in parallel, the beacon found next to the first sensor wins whichever thread finds it, and the
+    // sensors after it stop scanning
+    std::vector<long long> tuning_freq(t_sensors.size(), -1);
+    std::atomic<std::size_t> first_found = t_sensors.size();
+    aoc::parallel_for(indices(t_sensors.size()), [&](std::size_t const t_idx) {
+      auto const& sensor = t_sensors[t_idx];
+      for (auto&& edge : sensor.get_edge()) {
+        if (first_found.load(std::memory_order_relaxed) < t_idx) {
+          return;
+        }
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform(str_to_sensor) | to_vector;
+        if (in_search_area(edge) and all_of(t_sensors | filter([&](auto&& t_other) { return t_other != sensor; }),
+                                            [&](auto&& t_other) { return not t_other.is_in_range(edge); })) {
+          tuning_freq[t_idx] = to_tuning_freq(edge);
 
-  double result = [&]() {
-    for (auto&& sensor : rng) {
-      auto const edges = sensor.get_edge();
-      for (auto&& edge : edges) {
-        if (all_of(rng | filter([&](auto&& t_sensor) { return t_sensor != sensor; }),
-                   [&](auto&& t_sensor) { return not t_sensor.is_in_range(edge); })) {
-          fmt::println("{}, {}", edge.first, edge.second);
-          return to_tuning_freq(edge);
+          auto found = first_found.load(std::memory_order_relaxed);
+          while (t_idx < found and not first_found.compare_exchange_weak(found, t_idx, std::memory_order_relaxed)) {
+          }
+
+          return;
         }
       }
-    }
+    });
 
-    std::unreachable();
-  }();
+    auto const first = first_found.load(std::memory_order_relaxed);
+    if (first == t_sensors.size()) {
+      std::unreachable();
+    }
 
-  fmt::println("distress freq: {}", result);
-}
+    return tuning_freq[first];
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 15, Day15);
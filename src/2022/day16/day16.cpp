@@ -1,13 +1,19 @@
+#include "flat_hash.hpp"
+#include "metrics.hpp"
+#include "parallel_search.hpp"
+#include "registry.hpp"
+#include "shortest_path.hpp"
 #include "string_util.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
 #include <ctre.hpp>
-#include <fmt/format.h>
-#include <fstream>
 #include <functional>
+#include <istream>
 #include <limits>
-#include <map>
-#include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/algorithm/max.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/cartesian_product.hpp>
@@ -15,10 +21,14 @@
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/transform.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 using DistMap       = std::vector<std::vector<int>>;
-using StateBestFlow = std::map<std::size_t, std::size_t>;
+using StateBestFlow = aoc::FlatHashMap<std::size_t, std::size_t>;
+using IdxMap        = aoc::FlatHashMap<std::string, std::size_t>;
 
 struct Valve {
   std::string name_;
@@ -30,12 +40,12 @@ struct Valve {
   [[nodiscard]] int get_flow_rate() const noexcept { return this->flow_rate_; }
 };
 
-void add_to_map(std::vector<Valve>& t_map, std::string const& t_str, std::map<std::string, std::size_t>& t_str_to_idx) {
+void add_to_map(std::vector<Valve>& t_map, std::string const& t_str, IdxMap& t_str_to_idx) {
   auto valve = ctre::match<"Valve ([A-Z]{2})[a-z ]+=([0-9]+);[a-z ]+(.*)">(t_str);
 
   auto const name         = valve.get<1>().to_string();
   auto const flow_rate    = std::stoi(valve.get<2>().to_string());
-  auto const neighbor_str = split_string(valve.get<3>().to_string());
+  auto const neighbor_str = valve.get<3>().to_view();  // e.g. "DD, II, BB"
 
   if (not t_str_to_idx.contains(name)) {
     t_str_to_idx[name] = t_map.size();
@@ -44,8 +54,8 @@ void add_to_map(std::vector<Valve>& t_map, std::string const& t_str, std::map<st
     t_map[t_str_to_idx.at(name)].flow_rate_ = flow_rate;
   }
 
-  for (auto const& neighbor : neighbor_str) {
-    auto n = neighbor.substr(0, 2);
+  for (auto const neighbor : tokenize(neighbor_str, ", ")) {
+    auto n = std::string{neighbor};
     if (not t_str_to_idx.contains(n)) {
       t_str_to_idx[n] = t_map.size();
       t_map.emplace_back(n, 0);
@@ -54,112 +64,141 @@ void add_to_map(std::vector<Valve>& t_map, std::string const& t_str, std::map<st
   }
 }
 
-auto generate_shortest_path_matrix(std::vector<Valve> const& t_map,
-                                   std::map<std::string, std::size_t> const& t_idx_map) {
-  using ranges::for_each;
+// the tunnels all take a minute, a search from every valve (see shortest_path.hpp) rather than a Floyd-Warshall over
+// all of them
+auto generate_shortest_path_matrix(std::vector<Valve> const& t_map, IdxMap const& t_idx_map) {
+  AOC_TRACE_SCOPE("generate_shortest_path_matrix");
   // (max / 4) since we will calculate addition of element in dist_mat (not 3 because modulus != 0)
   DistMap dist_mat(t_map.size(), std::vector(t_map.size(), std::numeric_limits<int>::max() / 4));
 
-  for_each(t_map, [&](auto&& t_valve) {
-    for (auto&& neighbor : t_valve.neighbor_) {
-      dist_mat[t_idx_map.at(t_valve.name_)][neighbor] = 1;
+  auto const tunnels = [&](std::size_t const t_valve, auto&& t_relax) {
+    for (auto const neighbor : t_map[t_valve].neighbor_) {
+      t_relax(neighbor, 1);
     }
-  });
+  };
+
+  for (auto&& valve : t_map) {
+    auto const idx = t_idx_map.at(valve.name_);
+    aoc::ShortestPath<aoc::BucketQueue<std::size_t>> search{t_map.size(), std::array{idx},
+                                                           aoc::BucketQueue<std::size_t>{1}};
+    search.run(tunnels);
 
-  for (std::size_t j = 0; j < t_map.size(); ++j) {
-    for (std::size_t i = 0; i < t_map.size(); ++i) {
-      auto const idx = t_idx_map.at(t_map[i].name_);
-      for (std::size_t k = 0; k < t_map.size(); ++k) {
-        if (dist_mat[idx][j] + dist_mat[j][k] < dist_mat[idx][k]) {
-          dist_mat[idx][k] = dist_mat[idx][j] + dist_mat[j][k];
-        }
+    for (std::size_t k = 0; k < t_map.size(); ++k) {
+      if (auto const distance = search.distance(k); distance != search.UNREACHED) {
+        dist_mat[idx][k] = static_cast<int>(distance);
       }
     }
   }
 
-  for (std::size_t i = 0; i < t_map.size(); ++i) {
-    dist_mat[i][i] = 0;
-  }
-
   return dist_mat;
 }
 
-void traveling_salesman_problem(Valve const& t_start, std::map<std::string, std::size_t> const& t_idx_map,
-                                std::vector<Valve> const& t_valves, DistMap const& t_graph, int const t_time_left,
-                                std::size_t const t_valve_state, std::size_t const t_flow,
-                                StateBestFlow& t_valve_state_best_output) {
-  t_valve_state_best_output.at(t_valve_state) = std::max(t_valve_state_best_output[t_valve_state], t_flow);
-
-  for (auto&& valve : t_valves) {
-    auto const time_left = t_time_left - t_graph[t_idx_map.at(t_start.name_)][t_idx_map.at(valve.name_)] - 1;
-    auto const pos       = 1UL << t_idx_map.at(valve.name_);
-    if (((t_valve_state & pos) != 0U) or  // this path is meaningless (opened already), proceed to next one
-        time_left <= 0) {                 // this path is impossible (timeout), proceed to next one
-      continue;
-    }
+struct Route {
+  Valve const* valve_;
+  int time_left_;
+  std::size_t valve_state_;
+  std::size_t flow_;
+};
 
-    traveling_salesman_problem(valve, t_idx_map, t_valves, t_graph, time_left, t_valve_state | pos,
-                               t_flow + static_cast<std::size_t>(time_left * valve.get_flow_rate()),
-                               t_valve_state_best_output);
-  }
-}
+// best flow of every set of valves that can be opened in time, searched in parallel (see parallel_search.hpp): every
+// thread records the routes it walks in a map of its own, merged afterward
+StateBestFlow traveling_salesman_problem(Valve const& t_start, IdxMap const& t_idx_map,
+                                         std::vector<Valve> const& t_valves, DistMap const& t_graph,
+                                         int const t_time_left) {
+  static constexpr std::size_t CUTOFF = 2;
+
+  aoc::ParallelSearch<StateBestFlow> search{CUTOFF};
+  auto const expand = [&](Route const& t_route, StateBestFlow& t_valve_state_best_output, auto&& t_search) {
+    AOC_METRIC_RECORD("day16.depth", std::popcount(t_route.valve_state_) + 1);
+    AOC_METRIC_COUNT("day16.expanded");
+    auto& best_flow = t_valve_state_best_output[t_route.valve_state_];
+    best_flow       = std::max(best_flow, t_route.flow_);
+
+    for (auto&& valve : t_valves) {
+      auto const time_left =
+        t_route.time_left_ - t_graph[t_idx_map.at(t_route.valve_->name_)][t_idx_map.at(valve.name_)] - 1;
+      auto const pos = 1UL << t_idx_map.at(valve.name_);
+      if ((t_route.valve_state_ & pos) != 0U) {  // this path is meaningless (opened already), proceed to next one
+        AOC_METRIC_COUNT("day16.pruned.opened");
+        continue;
+      }
 
-void part1() {
-  using ranges::getlines, ranges::max, ranges::views::transform, ranges::views::filter, ranges::to_vector;
+      if (time_left <= 0) {  // this path is impossible (timeout), proceed to next one
+        AOC_METRIC_COUNT("day16.pruned.timeout");
+        continue;
+      }
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+      t_search(Route{.valve_       = &valve,
+                     .time_left_   = time_left,
+                     .valve_state_ = t_route.valve_state_ | pos,
+                     .flow_        = t_route.flow_ + static_cast<std::size_t>(time_left * valve.get_flow_rate())});
+    }
+  };
 
-  std::vector<Valve> map;
-  std::map<std::string, std::size_t> idx_map;
+  search.run(Route{.valve_ = &t_start, .time_left_ = t_time_left, .valve_state_ = 0, .flow_ = 0}, expand);
 
-  for (auto&& str : rng) {
-    add_to_map(map, str, idx_map);
-  }
+  StateBestFlow ret_val;
+  search.for_each_context([&](StateBestFlow const& t_valve_state_best_output) {
+    for (auto const& [valve_state, flow] : t_valve_state_best_output) {
+      auto& best_flow = ret_val[valve_state];
+      best_flow       = std::max(best_flow, flow);
+    }
+  });
 
-  auto const non_zero_flow_valve = map | filter([](auto&& t_f) { return t_f > 0; }, &Valve::get_flow_rate) | to_vector;
+  return ret_val;
+}
 
-  StateBestFlow answer;
-  auto const dist_map = generate_shortest_path_matrix(map, idx_map);
+struct Volcano {
+  std::vector<Valve> valves_;
+  IdxMap idx_map_;
+  std::vector<Valve> non_zero_flow_valves_;
+  DistMap dist_map_;
+};
 
-  traveling_salesman_problem(map[idx_map.at("AA")], idx_map, non_zero_flow_valve, dist_map, 30, 0, 0, answer);
+struct Day16 {
+  using Parsed = Volcano;
 
-  fmt::println("best result: {}", max(answer | transform([](auto&& t_pair) { return t_pair.second; })));
-}
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::views::filter, ranges::to_vector;
 
-void part2() {
-  using ranges::getlines, ranges::views::filter, ranges::to_vector, ranges::views::cartesian_product, ranges::max,
-    ranges::views::transform;
+    Volcano ret_val;
+    for (auto&& str : getlines(t_in)) {
+      add_to_map(ret_val.valves_, str, ret_val.idx_map_);
+    }
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+    ret_val.non_zero_flow_valves_ =
+      ret_val.valves_ | filter([](auto&& t_f) { return t_f > 0; }, &Valve::get_flow_rate) | to_vector;
+    ret_val.dist_map_ = generate_shortest_path_matrix(ret_val.valves_, ret_val.idx_map_);
+    return ret_val;
+  }
 
-  std::vector<Valve> map;
-  std::map<std::string, std::size_t> idx_map;
+  static std::size_t part1(Parsed const& t_volcano) {
+    using ranges::max, ranges::views::transform;
 
-  for (auto&& str : rng) {
-    add_to_map(map, str, idx_map);
+    auto const answer = best_flow_per_state(t_volcano, 30);
+    return max(answer | transform([](auto&& t_pair) { return t_pair.second; }));
   }
 
-  auto const non_zero_flow_valve = map | filter([](auto&& t_f) { return t_f > 0; }, &Valve::get_flow_rate) | to_vector;
+  static std::size_t part2(Parsed const& t_volcano) {
+    using ranges::views::filter, ranges::views::cartesian_product, ranges::max, ranges::views::transform;
 
-  StateBestFlow answer;
-  auto const dist_map = generate_shortest_path_matrix(map, idx_map);
-  traveling_salesman_problem(map[idx_map.at("AA")], idx_map, non_zero_flow_valve, dist_map, 26, 0, 0, answer);
+    auto const answer = best_flow_per_state(t_volcano, 26);
+    auto best_result_candidate =
+      cartesian_product(answer, answer)                                                                     //
+      | filter([](auto&& t_comb) { return (std::get<0>(t_comb).first & std::get<1>(t_comb).first) == 0; })  //
+      | transform([](auto&& t_comb) { return std::get<0>(t_comb).second + std::get<1>(t_comb).second; });
 
-  auto best_result_candidate =
-    cartesian_product(answer, answer)                                                                     //
-    | filter([](auto&& t_comb) { return (std::get<0>(t_comb).first & std::get<1>(t_comb).first) == 0; })  //
-    | transform([](auto&& t_comb) { return std::get<0>(t_comb).second + std::get<1>(t_comb).second; });
-
-  auto result = max(best_result_candidate);
+    return max(best_result_candidate);
+  }
 
-  fmt::println("best result with elephant: {}", result);
-}
+ private:
+  static StateBestFlow best_flow_per_state(Volcano const& t_volcano, int const t_time) {
+    AOC_TRACE_SCOPE("traveling_salesman_problem");
+    return traveling_salesman_problem(t_volcano.valves_[t_volcano.idx_map_.at("AA")], t_volcano.idx_map_,
+                                      t_volcano.non_zero_flow_valves_, t_volcano.dist_map_, t_time);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 16, Day16);
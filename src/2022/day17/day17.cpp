@@ -1,18 +1,21 @@
+#include "cycle.hpp"
+#include "flat_hash.hpp"
+#include "registry.hpp"
+#include "trace.hpp"
+
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <filesystem>
-#include <fmt/format.h>
-#include <fstream>
-#include <range/v3/algorithm/find.hpp>
+#include <istream>
 #include <range/v3/iterator/operations.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/view/cycle.hpp>
-#include <range/v3/view/getlines.hpp>
-#include <range/v3/view/reverse.hpp>
+#include <string>
 #include <utility>
 #include <vector>
 
+namespace {
+
 static inline constexpr auto CHAMBER_WIDTH = 7;
 static inline constexpr auto DROP_POINT_X  = 2;  // 0 based index
 static inline constexpr auto DROP_POINT_Y  = 3;
@@ -30,19 +33,20 @@ struct Coor {
   void move_down() noexcept { --y; }
 };
 
+// what the next rocks fall onto, the chamber falls the same way from 2 equal states on
 struct State {
   std::size_t rock_idx_;
   std::ptrdiff_t jet_idx_;
   std::array<int, CHAMBER_WIDTH> surface_;
-  long long rock_fell_;
-  long long height_;
 
-  bool operator==(State const& t_rhs) const noexcept {
-    return this->rock_idx_ == t_rhs.rock_idx_ and this->jet_idx_ == t_rhs.jet_idx_ and this->surface_ == t_rhs.surface_;
-  }
+  bool operator==(State const& t_rhs) const noexcept = default;
 };
 
-using RockFallHistory = std::vector<State>;
+struct StateHash {
+  [[nodiscard]] std::uint64_t operator()(State const& t_state) const noexcept {
+    return aoc::mix(aoc::fingerprint(t_state.surface_) ^ aoc::pack(t_state.rock_idx_, t_state.jet_idx_));
+  }
+};
 
 struct Rock {
   std::vector<Coor> positions_;  // starting from bottom left
@@ -60,9 +64,12 @@ struct Chamber {
   // however, if we want to see the history, then we need to keep those
   std::vector<std::uint8_t> content_ = std::vector<std::uint8_t>(4, 0);
 
+  // the depth of the highest rock of every column (-1 for none), from the top of content_ down to the first row where
+  // all of them are known rather than the whole chamber
   [[nodiscard]] auto get_surface() const noexcept {
     std::array<int, CHAMBER_WIDTH> surface{-1, -1, -1, -1, -1, -1, -1};
-    for (std::size_t j = 0; j < this->content_.size(); ++j) {
+    auto unknown = CHAMBER_WIDTH;
+    for (std::size_t j = 0; j < this->content_.size() and unknown != 0; ++j) {
       for (std::size_t i = 0; i < CHAMBER_WIDTH; ++i) {
         if (surface[i] != -1) {
           continue;
@@ -70,6 +77,7 @@ struct Chamber {
 
         if ((this->content_[this->content_.size() - 1 - j] & (1UL << i)) != 0) {
           surface[i] = static_cast<int>(j);
+          --unknown;
         }
       }
     }
@@ -114,21 +122,6 @@ struct Chamber {
       this->content_[offset_y] |= static_cast<std::uint8_t>(1U << offset_x);
     }
   }
-
-  void print_chamber(std::filesystem::path const& t_path) const noexcept {
-    std::fstream debug_txt(t_path.string());
-
-    using ranges::views::reverse;
-    for (auto&& row : this->content_ | reverse) {
-      debug_txt << '|';
-      for (std::size_t i = 0; i < CHAMBER_WIDTH; ++i) {
-        debug_txt << ((row & (1UL << i)) != 0 ? '#' : '.');
-      }
-      debug_txt << "|\n";
-    }
-
-    debug_txt << "+-------+\n\n";
-  }
 };
 
 std::array const rocks_order{
@@ -138,11 +131,14 @@ std::array const rocks_order{
   Rock{{{0, 0}, {0, 1}, {1, 0}, {1, 1}}},
 };
 
+// the chamber repeats itself after a while (see cycle.hpp), the height past the first cycle is extrapolated
 auto rock_falling_sim(std::string const& t_jet_input, long long const t_rock_fell) {
-  using ranges::views::cycle, ranges::begin, ranges::distance, ranges::find;
+  using ranges::views::cycle, ranges::begin, ranges::distance;
 
+  AOC_TRACE_SCOPE("rock_falling_sim");
   Chamber chamber;
-  RockFallHistory history;
+  aoc::CycleDetector<State, StateHash> detector;
+  std::vector<long long> heights;  // the height of the tower before every rock
 
   long long unit_tall = 0;
 
@@ -155,28 +151,16 @@ auto rock_falling_sim(std::string const& t_jet_input, long long const t_rock_fel
 
     auto rock_coor = Coor{DROP_POINT_X, unit_tall + DROP_POINT_Y};
 
-    auto state = State{
-      .rock_idx_  = idx,
-      .jet_idx_   = jet_idx,
-      .surface_   = chamber.get_surface(),
-      .rock_fell_ = rock_num,
-      .height_    = unit_tall,
-    };
-
-    if (auto iter = find(history, state); iter != history.end()) {
-      auto const& pattern       = *iter;
-      auto const height_cycle   = unit_tall - pattern.height_;
-      auto const rock_num_cycle = rock_num - pattern.rock_fell_;
-
-      auto const cycle_num               = (t_rock_fell - pattern.rock_fell_) / rock_num_cycle;
-      auto const rock_left_after_pattern = (t_rock_fell - pattern.rock_fell_) % rock_num_cycle;
-
-      auto const after_pattern_idx    = static_cast<std::size_t>(iter - history.begin() + rock_left_after_pattern);
-      auto const height_after_pattern = history[after_pattern_idx].height_;
-      return height_cycle * cycle_num + height_after_pattern;
-    }
+    heights.push_back(unit_tall);
+    auto const pattern = [&] {
+      AOC_TRACE_SCOPE("cycle search");
+      return detector.push(State{.rock_idx_ = idx, .jet_idx_ = jet_idx, .surface_ = chamber.get_surface()});
+    }();
 
-    history.push_back(state);
+    if (pattern) {
+      AOC_TRACE_SCOPE("extrapolate");
+      return aoc::extrapolate(heights, *pattern, static_cast<std::uint64_t>(t_rock_fell));
+    }
 
     for (;; ++dir) {
       if (*dir == '>' and not chamber.check_collision(rock, rock_coor.right())) {
@@ -200,27 +184,20 @@ auto rock_falling_sim(std::string const& t_jet_input, long long const t_rock_fel
   return unit_tall;
 }
 
-void part1() {
-  using ranges::getlines, ranges::begin;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
-
-  fmt::println("units tall: {}", rock_falling_sim(*begin(rng), 2022));
-}
+struct Day17 {
+  using Parsed = std::string;
 
-void part2() {
-  using ranges::getlines, ranges::begin;
+  static Parsed parse(std::istream& t_in) {
+    std::string jets;
+    std::getline(t_in, jets);
+    return jets;
+  }
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+  static long long part1(Parsed const& t_jets) { return rock_falling_sim(t_jets, 2022); }
 
-  fmt::println("units tall: {}", rock_falling_sim(*begin(rng), 1'000'000'000'000));
-}
+  static long long part2(Parsed const& t_jets) { return rock_falling_sim(t_jets, 1'000'000'000'000); }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 17, Day17);
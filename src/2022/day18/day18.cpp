@@ -1,20 +1,26 @@
+#include "bfs.hpp"
+#include "flat_hash.hpp"
 #include "pairview.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
-#include <fmt/format.h>
-#include <fstream>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
-#include <map>
-#include <queue>
+#include <istream>
 #include <range/v3/algorithm/count_if.hpp>
 #include <range/v3/algorithm/minmax.hpp>
 #include <range/v3/algorithm/sort.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/transform.hpp>
-#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 using Plane = std::pair<int, int>;
 
 struct Cube {
@@ -30,12 +36,12 @@ struct Cube {
   [[nodiscard]] int y_coor() const noexcept { return this->y; }
   [[nodiscard]] int z_coor() const noexcept { return this->z; }
 
-  auto operator<=>(Cube const&) const = default;
+  bool operator==(Cube const&) const = default;
 };
 
 auto get_surface_area(std::vector<Cube> const& t_droplets, auto&& t_proj) {
   using ranges::views::transform, ranges::sort, ranges::count_if;
-  std::map<Plane, std::vector<int>> projections;
+  aoc::FlatHashMap<Plane, std::vector<int>> projections;
   for (auto&& [plane, height] : t_droplets | transform(t_proj)) {
     projections[plane].push_back(height);
   }
@@ -55,93 +61,110 @@ auto get_surface_area(std::vector<Cube> const& t_droplets, auto&& t_proj) {
   return ret_val * 2;
 }
 
-auto const to_cube = [](auto&& t_str) {
-  auto const num_str = split_string(t_str, ',');
-  return Cube{.x = std::stoi(num_str[0]), .y = std::stoi(num_str[1]), .z = std::stoi(num_str[2])};
+auto const to_cube = [](std::string_view const t_str) {
+  auto const [x, y, z] = split_n<3>(t_str, ',');
+
+  Cube ret_val{};
+  ranges_from_chars(x, ret_val.x);
+  ranges_from_chars(y, ret_val.y);
+  ranges_from_chars(z, ret_val.z);
+  return ret_val;
 };
 
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::views::transform;
+// The droplet in a box one cube larger on every side, water can flow all around it. The box has a border of its own
+// that the water never enters: the six neighbours of a cube of the box are a fixed offset away and always in it
+class Voxels {
+  Cube origin_;  // the corner of the border
+  std::size_t width_;
+  std::size_t height_;
+  std::vector<char> lava_;  // or border
+
+ public:
+  explicit Voxels(std::vector<Cube> const& t_droplets) {
+    using ranges::minmax;
+    auto const [min_x, max_x] = minmax(t_droplets, std::less<>{}, &Cube::x_coor);
+    auto const [min_y, max_y] = minmax(t_droplets, std::less<>{}, &Cube::y_coor);
+    auto const [min_z, max_z] = minmax(t_droplets, std::less<>{}, &Cube::z_coor);
+
+    this->origin_    = Cube{min_x.x - 2, min_y.y - 2, min_z.z - 2};
+    this->width_     = static_cast<std::size_t>(max_x.x - min_x.x + 5);
+    this->height_    = static_cast<std::size_t>(max_y.y - min_y.y + 5);
+    auto const depth = static_cast<std::size_t>(max_z.z - min_z.z + 5);
+    this->lava_.assign(this->width_ * this->height_ * depth, 1);
+
+    for (std::size_t z = 1; z + 1 < depth; ++z) {
+      for (std::size_t y = 1; y + 1 < this->height_; ++y) {
+        auto const row = (z * this->height_ + y) * this->width_;
+        std::fill_n(this->lava_.begin() + static_cast<std::ptrdiff_t>(row + 1), this->width_ - 2, 0);
+      }
+    }
 
-  std::fstream in((INPUT_FILE));
-  auto const droplets = getlines(in) | transform(to_cube) | to_vector;
+    for (auto const& droplet : t_droplets) {
+      this->lava_[this->index(droplet)] = 1;
+    }
+  }
 
-  auto x_dir = get_surface_area(droplets, [](auto&& t_d) { return std::pair{t_d.x_plane(), t_d.x}; });
-  auto y_dir = get_surface_area(droplets, [](auto&& t_d) { return std::pair{t_d.y_plane(), t_d.y}; });
-  auto z_dir = get_surface_area(droplets, [](auto&& t_d) { return std::pair{t_d.z_plane(), t_d.z}; });
+  [[nodiscard]] std::size_t size() const noexcept { return this->lava_.size(); }
+  [[nodiscard]] bool lava(std::size_t const t_idx) const noexcept { return this->lava_[t_idx] != 0; }
 
-  fmt::println("surface area: {}", x_dir + y_dir + z_dir);
-}
+  [[nodiscard]] std::size_t index(Cube const& t_cube) const noexcept {
+    auto const x = static_cast<std::size_t>(t_cube.x - this->origin_.x);
+    auto const y = static_cast<std::size_t>(t_cube.y - this->origin_.y);
+    auto const z = static_cast<std::size_t>(t_cube.z - this->origin_.z);
+    return (z * this->height_ + y) * this->width_ + x;
+  }
 
-auto const get_neighbor = [](Cube const& t_queried) {
-  return std::array{
-    Cube{t_queried.x + 1, t_queried.y, t_queried.z}, Cube{t_queried.x - 1, t_queried.y, t_queried.z},
-    Cube{t_queried.x, t_queried.y + 1, t_queried.z}, Cube{t_queried.x, t_queried.y - 1, t_queried.z},
-    Cube{t_queried.x, t_queried.y, t_queried.z + 1}, Cube{t_queried.x, t_queried.y, t_queried.z - 1},
-  };
-};
+  // the corner of the box inside the border
+  [[nodiscard]] std::size_t corner() const noexcept { return (this->height_ + 1) * this->width_ + 1; }
 
-std::set<Cube> flood_fill(std::set<Cube> const& t_droplets) {
-  using ranges::minmax;
-  auto const [min_x, max_x] = minmax(t_droplets, std::less<>{}, &Cube::x_coor);
-  auto const [min_y, max_y] = minmax(t_droplets, std::less<>{}, &Cube::y_coor);
-  auto const [min_z, max_z] = minmax(t_droplets, std::less<>{}, &Cube::z_coor);
+  [[nodiscard]] std::array<std::size_t, 6> neighbors(std::size_t const t_idx) const noexcept {
+    auto const layer = this->width_ * this->height_;
+    return {t_idx + 1, t_idx - 1, t_idx + this->width_, t_idx - this->width_, t_idx + layer, t_idx - layer};
+  }
+};
 
-  Cube const bottom_left_corner{min_x.x - 1, min_y.y - 1, min_z.z - 1};
-  Cube const upper_right_corner{max_x.x + 1, max_y.y + 1, max_z.z + 1};
+// the cubes of the box the water reaches from its corner, in parallel for the large boxes
+aoc::Bfs flood_fill(Voxels const& t_voxels) {
+  aoc::Bfs water{t_voxels.size(), std::array{t_voxels.corner()}, aoc::Bfs::Revisit::NEVER,
+                 aoc::Bfs::Execution::PARALLEL};
+  water.run([&](std::size_t const t_idx) { return t_voxels.neighbors(t_idx); },
+            [&](std::size_t, std::size_t const t_to) { return not t_voxels.lava(t_to); });
 
-  std::set<Cube> water;
+  return water;
+}
 
-  std::queue<Cube> bfs;
-  bfs.emplace(min_x.x, min_y.y, min_z.z);
+struct Day18 {
+  using Parsed = std::vector<Cube>;
 
-  auto const is_in_bound = [&](Cube const& t_queried) {
-    return bottom_left_corner.x <= t_queried.x and t_queried.x <= upper_right_corner.x and
-           bottom_left_corner.y <= t_queried.y and t_queried.y <= upper_right_corner.y and
-           bottom_left_corner.z <= t_queried.z and t_queried.z <= upper_right_corner.z;
-  };
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::transform;
+    return getlines(t_in) | transform(to_cube) | to_vector;
+  }
 
-  while (not bfs.empty()) {
-    auto const curr = bfs.front();
-    bfs.pop();
+  static std::size_t part1(Parsed const& t_droplets) {
+    auto x_dir = get_surface_area(t_droplets, [](auto&& t_d) { return std::pair{t_d.x_plane(), t_d.x}; });
+    auto y_dir = get_surface_area(t_droplets, [](auto&& t_d) { return std::pair{t_d.y_plane(), t_d.y}; });
+    auto z_dir = get_surface_area(t_droplets, [](auto&& t_d) { return std::pair{t_d.z_plane(), t_d.z}; });
 
-    if (water.contains(curr)) {
-      continue;
-    }
+    return x_dir + y_dir + z_dir;
+  }
 
-    water.insert(curr);
+  // the faces of the droplet the water touches
+  static int part2(Parsed const& t_droplets) {
+    Voxels const voxels{t_droplets};
+    auto const water = flood_fill(voxels);
 
-    for (auto&& neighbor : get_neighbor(curr)) {
-      if (not t_droplets.contains(neighbor) and not water.contains(neighbor) and is_in_bound(neighbor)) {
-        bfs.push(neighbor);
+    int area = 0;
+    for (auto const& droplet : t_droplets) {
+      for (auto const neighbor : voxels.neighbors(voxels.index(droplet))) {
+        area += static_cast<int>(water.visited(neighbor));
       }
     }
-  }
-
-  return water;
-}
-
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to;
 
-  std::fstream in((INPUT_FILE));
-  auto const droplets = getlines(in) | transform(to_cube) | to<std::set>;
-
-  auto const water = flood_fill(droplets);
-
-  int area = 0;
-  for (auto const& lava : droplets) {
-    for (auto&& neighbor : get_neighbor(lava)) {
-      area += static_cast<int>(not droplets.contains(neighbor) and water.contains(neighbor));
-    }
+    return area;
   }
+};
 
-  fmt::println("surface area: {}", area);
-}
-
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 18, Day18);
@@ -1,18 +1,25 @@
+#include "mapped_input.hpp"
+#include "metrics.hpp"
+#include "parallel_search.hpp"
+#include "registry.hpp"
+#include "string_util.hpp"
+#include "thread_pool.hpp"
+
 #include <algorithm>
+#include <array>
 #include <cstddef>
-#include <ctre.hpp>
-#include <fmt/format.h>
-#include <fstream>
+#include <functional>
 #include <map>
 #include <range/v3/algorithm/find_if.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/getlines.hpp>
 #include <range/v3/view/take.hpp>
 #include <range/v3/view/transform.hpp>
-#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+namespace {
+
 struct Blueprint {
   int idx_;
   int ore_bot_cost_;
@@ -31,20 +38,10 @@ struct OreCount {
 
   bool operator==(OreCount const&) const noexcept = default;
 
-  bool operator<(OreCount const& t_ore) const noexcept {
-    if (this->geode_ != t_ore.geode_) {
-      return this->geode_ < t_ore.geode_;
-    }
-
-    if (this->obsidian_ != t_ore.obsidian_) {
-      return this->obsidian_ < t_ore.obsidian_;
-    }
-
-    if (this->clay_ != t_ore.clay_) {
-      return this->clay_ < t_ore.clay_;
-    }
-
-    return this->ore_ < t_ore.ore_;
+  // at least as much of every ore
+  [[nodiscard]] bool covers(OreCount const& t_ore) const noexcept {
+    return this->ore_ >= t_ore.ore_ and this->clay_ >= t_ore.clay_ and this->obsidian_ >= t_ore.obsidian_ and
+           this->geode_ >= t_ore.geode_;
   }
 
   auto operator+(OreCount const& t_ore) const noexcept {
@@ -61,25 +58,11 @@ struct OreCount {
   }
 };
 
-template <std::size_t Time>
-using Buffer = std::array<std::pair<OreCount, OreCount>, Time>;
-
-auto to_blueprint(std::string const& t_str) {
-  auto const result = ctre::match<
-    "Blueprint ([0-9]+):"
-    "[a-zA-Z ]+([0-9]+)[a-zA-Z ]+."                    // ore robot
-    "[a-zA-Z ]+([0-9]+)[a-zA-Z ]+."                    // clay robot
-    "[a-zA-Z ]+([0-9]+)[a-zA-Z ]+([0-9]+)[a-zA-Z ]+."  // obsidian robot
-    "[a-zA-Z ]+([0-9]+)[a-zA-Z ]+([0-9]+)[a-zA-Z ]+."  // geode robot
-    >(t_str);                                          //
-
-  auto const idx                 = std::stoi(result.get<1>().to_string());
-  auto const ore_bot_cost        = std::stoi(result.get<2>().to_string());
-  auto const clay_bot_cost       = std::stoi(result.get<3>().to_string());
-  auto const obsidian_ore_cost   = std::stoi(result.get<4>().to_string());
-  auto const obsidian_clay_cost  = std::stoi(result.get<5>().to_string());
-  auto const geode_ore_cost      = std::stoi(result.get<6>().to_string());
-  auto const geode_obsidian_cost = std::stoi(result.get<7>().to_string());
+// "Blueprint <idx>: Each ore robot costs <ore> ore. Each clay robot costs <ore> ore. Each obsidian robot costs <ore>
+// ore and <clay> clay. Each geode robot costs <ore> ore and <obsidian> obsidian."
+auto to_blueprint(std::string_view const t_str) {
+  auto const [idx, ore_bot_cost, clay_bot_cost, obsidian_ore_cost, obsidian_clay_cost, geode_ore_cost,
+              geode_obsidian_cost] = scan_n<7>(t_str);
 
   return Blueprint{.idx_               = idx,
                    .ore_bot_cost_      = ore_bot_cost,
@@ -89,127 +72,166 @@ auto to_blueprint(std::string const& t_str) {
                    .max_ore_cost_      = std::max({ore_bot_cost, clay_bot_cost, obsidian_ore_cost, geode_ore_cost})};
 };
 
-template <std::size_t T>
-void run_mining_sim(Blueprint const& t_bp, OreCount& t_bot_count, Buffer<T>& t_mining_state, int const t_time = T,
-                    OreCount const& t_result = {}) {
-  if (t_time == 1) {
-    if (auto& [bot_count_at_time, ore_count_at_time] = t_mining_state.back(); ore_count_at_time < t_result) {
-      bot_count_at_time = t_bot_count;
-      ore_count_at_time = t_result;
-    }
-
-    return;
-  }
+enum BotMask : int { ORE_BOT = 1, CLAY_BOT = 2, OBSIDIAN_BOT = 4 };
 
-  auto& [bot_count_at_time, ore_count_at_time] = t_mining_state[T - static_cast<std::size_t>(t_time)];
-  if (bot_count_at_time.geode_ > t_bot_count.geode_ and ore_count_at_time.geode_ >= t_result.geode_) {
-    return;
-  }
+struct MiningState {
+  OreCount bot_count_;
+  OreCount result_;
+  int time_    = 0;
+  int skipped_ = 0;  // BotMask of the bots that could have been built the minute before but weren't
 
-  if (bot_count_at_time == t_bot_count and t_result < ore_count_at_time) {
-    return;
+  // whatever can be done from t_state can be done from here
+  [[nodiscard]] bool covers(MiningState const& t_state) const noexcept {
+    return this->bot_count_.covers(t_state.bot_count_) and this->result_.covers(t_state.result_) and
+           (this->skipped_ & ~t_state.skipped_) == 0;
   }
+};
 
-  bot_count_at_time = t_bot_count;
-  ore_count_at_time = t_result;
-
-  // we can only build one bot a time (face palm :P)
-  if (auto const [geode_ore_cost, geode_obsidian_cost] = t_bp.geode_bot_cost_;
-      t_result.ore_ >= geode_ore_cost and t_result.obsidian_ >= geode_obsidian_cost) {
-    OreCount new_result = t_result + t_bot_count;
-    new_result.ore_ -= geode_ore_cost;
-    new_result.obsidian_ -= geode_obsidian_cost;
-
-    OreCount new_bot_count = t_bot_count;
-    ++new_bot_count.geode_;
-    run_mining_sim(t_bp, new_bot_count, t_mining_state, t_time - 1, new_result);
-
-    return;  // since we are dfs-ing, if this happens in one branch, it must be the first to happen, then we don't need
-             // to search for the rest because we are aiming to make geode bot ASAP
-  }
+template <std::size_t Time>
+using Buffer = std::array<MiningState, Time>;
 
-  if (auto const [obsidian_ore_cost, obsidian_clay_cost] = t_bp.obsidian_bot_cost_;
-      t_result.ore_ >= obsidian_ore_cost and t_result.clay_ >= obsidian_clay_cost and
-      t_bot_count.obsidian_ < t_bp.geode_bot_cost_.second) {
-    OreCount new_result = t_result + t_bot_count;
-    new_result.ore_ -= obsidian_ore_cost;
-    new_result.clay_ -= obsidian_clay_cost;
+// Searched in parallel (see parallel_search.hpp), every thread keeps a DP table of its own: the last state it expanded
+// at every minute, the states it covers are pruned. They share the most geodes found so far, a state that can't beat it
+// even with a new geode bot every minute left is pruned too. Every pruning rule is sound (only the geode bot first rule
+// is a heuristic, and it doesn't depend on the order), hence the threads always agree on the result
+template <std::size_t T>
+int run_mining_sim(Blueprint const& t_bp) {
+  static constexpr std::size_t CUTOFF = 6;
 
-    OreCount new_bot_count = t_bot_count;
-    ++new_bot_count.obsidian_;
-    run_mining_sim(t_bp, new_bot_count, t_mining_state, t_time - 1, new_result);
-  }
+  aoc::SharedBest<int> most_geodes{0};
+  aoc::ParallelSearch<Buffer<T>> search{CUTOFF};
 
-  if (t_result.ore_ >= t_bp.clay_bot_cost_ and t_bot_count.clay_ < t_bp.obsidian_bot_cost_.second) {
-    OreCount new_result = t_result + t_bot_count;
-    new_result.ore_ -= t_bp.clay_bot_cost_;
+  auto const expand = [&](MiningState const& t_state, Buffer<T>& t_mining_state, auto&& t_search) {
+    auto const& [bot_count, result, time, skipped] = t_state;
 
-    OreCount new_bot_count = t_bot_count;
-    ++new_bot_count.clay_;
-    run_mining_sim(t_bp, new_bot_count, t_mining_state, t_time - 1, new_result);
-  }
+    AOC_METRIC_RECORD("day19.depth", static_cast<int>(T) - time + 1);
+    if (time == 1) {
+      AOC_METRIC_COUNT("day19.leaves");
+      most_geodes.offer(result.geode_);
+      return;
+    }
 
-  if (t_result.ore_ >= t_bp.ore_bot_cost_ and t_bot_count.ore_ < t_bp.max_ore_cost_) {
-    OreCount new_result = t_result + t_bot_count;
-    new_result.ore_ -= t_bp.ore_bot_cost_;
+    if (auto const minutes = time - 1;
+        result.geode_ + bot_count.geode_ * minutes + minutes * (minutes - 1) / 2 <= most_geodes.get()) {
+      AOC_METRIC_COUNT("day19.pruned.bound");
+      return;
+    }
 
-    OreCount new_bot_count = t_bot_count;
-    ++new_bot_count.ore_;
-    run_mining_sim(t_bp, new_bot_count, t_mining_state, t_time - 1, new_result);
-  }
+    auto& state_at_time = t_mining_state[T - static_cast<std::size_t>(time)];
+    if (state_at_time.covers(t_state)) {
+      AOC_METRIC_COUNT("day19.memo_hits");
+      return;
+    }
 
-  run_mining_sim(t_bp, t_bot_count, t_mining_state, t_time - 1, t_result + t_bot_count);
-}
+    AOC_METRIC_COUNT("day19.expanded");
+    state_at_time = t_state;
 
-void part1() {
-  using ranges::getlines, ranges::views::transform, ranges::to_vector;
+    // we can only build one bot a time (face palm :P)
+    if (auto const [geode_ore_cost, geode_obsidian_cost] = t_bp.geode_bot_cost_;
+        result.ore_ >= geode_ore_cost and result.obsidian_ >= geode_obsidian_cost) {
+      OreCount new_result = result + bot_count;
+      new_result.ore_ -= geode_ore_cost;
+      new_result.obsidian_ -= geode_obsidian_cost;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform(to_blueprint) | to_vector;
+      OreCount new_bot_count = bot_count;
+      ++new_bot_count.geode_;
+      t_search(MiningState{.bot_count_ = new_bot_count, .result_ = new_result, .time_ = time - 1});
 
-  static constexpr auto COUNTDOWN = 24 - 0 + 1;
+      AOC_METRIC_COUNT("day19.pruned.geode_bot_first");
+      return;  // since we are dfs-ing, if this happens in one branch, it must be the first to happen, then we don't
+               // need to search for the rest because we are aiming to make geode bot ASAP
+    }
 
-  int quality_sum = 0;
-  for (auto&& bp : rng) {
-    OreCount bot_count{1};
+    // a bot is only worth building as soon as it can be, waiting a minute to build it is never better
+    int affordable = 0;
+    auto const worth_building = [&](BotMask const t_bot) {
+      affordable |= t_bot;
+      if ((skipped & t_bot) != 0) {
+        AOC_METRIC_COUNT("day19.pruned.skipped");
+        return false;
+      }
+
+      return true;
+    };
+
+    if (auto const [obsidian_ore_cost, obsidian_clay_cost] = t_bp.obsidian_bot_cost_;
+        result.ore_ >= obsidian_ore_cost and result.clay_ >= obsidian_clay_cost and
+        bot_count.obsidian_ < t_bp.geode_bot_cost_.second) {
+      if (worth_building(OBSIDIAN_BOT)) {
+        OreCount new_result = result + bot_count;
+        new_result.ore_ -= obsidian_ore_cost;
+        new_result.clay_ -= obsidian_clay_cost;
+
+        OreCount new_bot_count = bot_count;
+        ++new_bot_count.obsidian_;
+        t_search(MiningState{.bot_count_ = new_bot_count, .result_ = new_result, .time_ = time - 1});
+      }
+    } else if (result.ore_ >= obsidian_ore_cost and result.clay_ >= obsidian_clay_cost) {
+      AOC_METRIC_COUNT("day19.pruned.max_bots");
+    }
 
-    Buffer<COUNTDOWN> dp;
-    run_mining_sim(bp, bot_count, dp);
+    if (result.ore_ >= t_bp.clay_bot_cost_ and bot_count.clay_ < t_bp.obsidian_bot_cost_.second) {
+      if (worth_building(CLAY_BOT)) {
+        OreCount new_result = result + bot_count;
+        new_result.ore_ -= t_bp.clay_bot_cost_;
+
+        OreCount new_bot_count = bot_count;
+        ++new_bot_count.clay_;
+        t_search(MiningState{.bot_count_ = new_bot_count, .result_ = new_result, .time_ = time - 1});
+      }
+    } else if (result.ore_ >= t_bp.clay_bot_cost_) {
+      AOC_METRIC_COUNT("day19.pruned.max_bots");
+    }
 
-    quality_sum += bp.idx_ * dp[COUNTDOWN - 1].second.geode_;
+    if (result.ore_ >= t_bp.ore_bot_cost_ and bot_count.ore_ < t_bp.max_ore_cost_) {
+      if (worth_building(ORE_BOT)) {
+        OreCount new_result = result + bot_count;
+        new_result.ore_ -= t_bp.ore_bot_cost_;
+
+        OreCount new_bot_count = bot_count;
+        ++new_bot_count.ore_;
+        t_search(MiningState{.bot_count_ = new_bot_count, .result_ = new_result, .time_ = time - 1});
+      }
+    } else if (result.ore_ >= t_bp.ore_bot_cost_) {
+      AOC_METRIC_COUNT("day19.pruned.max_bots");
+    }
 
-    fmt::println("{}: {}", bp.idx_, dp[COUNTDOWN - 1].second.geode_);
-  }
+    t_search(MiningState{
+      .bot_count_ = bot_count, .result_ = result + bot_count, .time_ = time - 1, .skipped_ = skipped | affordable});
+  };
 
-  fmt::println("quality sum: {}", quality_sum);
+  search.run(MiningState{.bot_count_ = OreCount{1}, .result_ = {}, .time_ = static_cast<int>(T), .skipped_ = 0},
+             expand);
+  return most_geodes.get();
 }
 
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to_vector, ranges::views::take;
+struct Day19 {
+  using Parsed = std::vector<Blueprint>;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform(to_blueprint) | to_vector;
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::views::transform, ranges::to_vector;
+    return t_in | transform(to_blueprint) | to_vector;
+  }
 
-  static constexpr auto COUNTDOWN = 33;
+  // the blueprints don't depend on each other, each one is searched on its own thread
+  static int part1(Parsed const& t_blueprints) {
+    static constexpr auto COUNTDOWN = 24 - 0 + 1;
 
-  int result = 1;
-  for (auto&& bp : rng | take(3)) {
-    OreCount bot_count{1};
+    return aoc::parallel_reduce(t_blueprints, 0, std::plus<>{}, [](Blueprint const& t_bp) {
+      return t_bp.idx_ * run_mining_sim<COUNTDOWN>(t_bp);
+    });
+  }
 
-    Buffer<COUNTDOWN> dp;
-    run_mining_sim(bp, bot_count, dp);
+  static int part2(Parsed const& t_blueprints) {
+    using ranges::views::take;
 
-    result *= dp[COUNTDOWN - 1].second.geode_;
+    static constexpr auto COUNTDOWN = 33;
 
-    fmt::println("result: {}", dp[COUNTDOWN - 1].second.geode_);
+    return aoc::parallel_reduce(t_blueprints | take(3), 1, std::multiplies<>{},
+                                [](Blueprint const& t_bp) { return run_mining_sim<COUNTDOWN>(t_bp); });
   }
+};
 
-  fmt::println("quality sum: {}", result);
-}
-
-int main(int /**/, char** /**/) {
-  // part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 19, Day19);
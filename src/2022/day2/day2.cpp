@@ -1,58 +1,65 @@
+#include "mapped_input.hpp"
+#include "registry.hpp"
+
 #include <array>
-#include <fmt/format.h>
-#include <fstream>
+#include <cstddef>
 #include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/to_container.hpp>
-#include <range/v3/view/getlines.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/transform.hpp>
+#include <string_view>
 #include <vector>
 
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::accumulate;
+namespace {
+
+struct Round {
+  std::size_t elf_choice_;  // A, B, C
+  std::size_t second_col_;  // X, Y, Z
+};
 
-  std::ifstream elves_inventory_list((INPUT_FILE));
+struct Day2 {
+  using Parsed = std::vector<Round>;
 
-  static constexpr std::array<std::array<int, 3>, 3> rps_table = {
-    //         A  B  C
-    std::array{4, 1, 7},  // X
-    std::array{8, 5, 2},  // Y
-    std::array{3, 9, 6},  // Z
-  };
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::views::transform, ranges::to_vector;
 
-  auto lines = getlines(elves_inventory_list) | to_vector;
-  auto score = accumulate(lines, 0, [](auto&& t_v, auto&& t_in) {
-    std::size_t const elf_choice = static_cast<std::size_t>(t_in[0]) - static_cast<std::size_t>('A');
-    std::size_t const my_choice  = static_cast<std::size_t>(t_in[2]) - static_cast<std::size_t>('X');
-    return t_v + rps_table.at(my_choice).at(elf_choice);
-  });
+    return t_in | transform([](std::string_view const t_line) {
+             return Round{.elf_choice_ = static_cast<std::size_t>(t_line[0]) - static_cast<std::size_t>('A'),
+                          .second_col_ = static_cast<std::size_t>(t_line[2]) - static_cast<std::size_t>('X')};
+           }) |
+           to_vector;
+  }
 
-  fmt::println("self deduct: {}", score);
-}
+  static int part1(Parsed const& t_strategy) {
+    using ranges::accumulate;
 
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::accumulate;
+    static constexpr std::array<std::array<int, 3>, 3> rps_table = {
+      //         A  B  C
+      std::array{4, 1, 7},  // X
+      std::array{8, 5, 2},  // Y
+      std::array{3, 9, 6},  // Z
+    };
 
-  std::ifstream elves_inventory_list((INPUT_FILE));
+    return accumulate(t_strategy, 0, [](int const t_v, Round const& t_round) {
+      return t_v + rps_table.at(t_round.second_col_).at(t_round.elf_choice_);  // second column is my choice
+    });
+  }
 
-  static constexpr std::array<std::array<int, 3>, 3> strat_table = {
-    //         A  B  C
-    std::array{3, 1, 2},  // X
-    std::array{4, 5, 6},  // Y
-    std::array{8, 9, 7},  // Z
-  };
+  static int part2(Parsed const& t_strategy) {
+    using ranges::accumulate;
 
-  auto lines = getlines(elves_inventory_list) | to_vector;
-  auto score = accumulate(lines, 0, [](auto&& t_v, auto&& t_in) {
-    std::size_t const elf_choice = static_cast<std::size_t>(t_in[0]) - static_cast<std::size_t>('A');
-    std::size_t const elf_strat  = static_cast<std::size_t>(t_in[2]) - static_cast<std::size_t>('X');
-    return t_v + strat_table.at(elf_strat).at(elf_choice);
-  });
+    static constexpr std::array<std::array<int, 3>, 3> strat_table = {
+      //         A  B  C
+      std::array{3, 1, 2},  // X
+      std::array{4, 5, 6},  // Y
+      std::array{8, 9, 7},  // Z
+    };
 
-  fmt::println("elf strategy: {}", score);
-}
+    return accumulate(t_strategy, 0, [](int const t_v, Round const& t_round) {
+      return t_v + strat_table.at(t_round.second_col_).at(t_round.elf_choice_);  // second column is the elf strategy
+    });
+  }
+};
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 2, Day2);
@@ -1,16 +1,20 @@
+#include "registry.hpp"
+
 #include <algorithm>
 #include <cmath>
 #include <concepts>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <list>
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/transform.hpp>
+#include <string>
 #include <vector>
 
+namespace {
+
 template <typename T>
   requires(std::integral<T>)
 void mix(std::list<T>& t_numbers, std::vector<typename std::list<T>::iterator>& t_nodes) {
@@ -49,35 +53,14 @@ void mix(std::list<T>& t_numbers, std::vector<typename std::list<T>::iterator>&
 
 constexpr auto operator""_K(unsigned long long t_v) noexcept { return t_v * 1000; }
 
-void part1() {
-  using ranges::getlines, ranges::to, ranges::views::transform, ranges::find, ranges::to_vector;
-
-  std::fstream in((INPUT_FILE));
-
-  auto rng = getlines(in) | transform([](auto&& t_str) { return std::stoi(t_str); }) | to<std::list>;
-  std::vector<typename std::list<int>::iterator> nodes;
-  nodes.reserve(rng.size());
-  for (auto node = rng.begin(); node != rng.end(); ++node) {
-    nodes.push_back(node);
-  }
-
-  mix(rng, nodes);
-  auto const zero    = static_cast<std::size_t>(distance(rng.begin(), find(rng, 0)));
-  auto const numbers = rng | to_vector;
-
-  auto const first = numbers[(zero + 1_K) % numbers.size()];
-  auto const sec   = numbers[(zero + 2_K) % numbers.size()];
-  auto const third = numbers[(zero + 3_K) % numbers.size()];
-  fmt::println("1000: {}, 2000: {}, 3000: {}, sum: {}", first, sec, third, first + sec + third);
-}
-
 inline constexpr auto DECRYPTION_KEY = 811'589'153;
 
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to, ranges::find, ranges::to_vector;
+// the grove coordinates can be found by looking at the 1000th, 2000th, and 3000th numbers after the value ***0***
+// for some reason, I misread this part and keep using the one at zero idx in pre-mix list
+long grove_coordinates_sum(std::vector<long> const& t_numbers, long const t_key, std::size_t const t_rounds) {
+  using ranges::views::transform, ranges::to, ranges::find, ranges::to_vector;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform([](auto&& t_str) { return std::stol(t_str) * DECRYPTION_KEY; }) | to<std::list>;
+  auto rng = t_numbers | transform([=](auto&& t_num) { return t_num * t_key; }) | to<std::list>;
 
   std::vector<typename std::list<long>::iterator> nodes;
   nodes.reserve(rng.size());
@@ -85,24 +68,32 @@ void part2() {
     nodes.push_back(node);
   }
 
-  for (std::size_t i = 0; i < 10; ++i) {
+  for (std::size_t i = 0; i < t_rounds; ++i) {
     mix(rng, nodes);
   }
 
-  // the grove coordinates can be found by looking at the 1000th, 2000th, and 3000th numbers after the value ***0***
-  // for some reason, I misread this part and keep using the one at zero idx in pre-mix list
   auto const zero    = static_cast<std::size_t>(distance(rng.begin(), find(rng, 0)));
   auto const numbers = rng | to_vector;
 
   auto const first = numbers[(zero + 1_K) % numbers.size()];
   auto const sec   = numbers[(zero + 2_K) % numbers.size()];
   auto const third = numbers[(zero + 3_K) % numbers.size()];
-  fmt::println("1000: {}, 2000: {}, 3000: {}, sum: {}", first, sec, third, first + sec + third);
+  return first + sec + third;
 }
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+struct Day20 {
+  using Parsed = std::vector<long>;
 
-  return EXIT_SUCCESS;
-}
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::views::transform, ranges::to_vector;
+    return getlines(t_in) | transform([](auto&& t_str) { return std::stol(t_str); }) | to_vector;
+  }
+
+  static long part1(Parsed const& t_numbers) { return grove_coordinates_sum(t_numbers, 1, 1); }
+
+  static long part2(Parsed const& t_numbers) { return grove_coordinates_sum(t_numbers, DECRYPTION_KEY, 10); }
+};
+
+}  // namespace
+
+AOC_REGISTER(2022, 20, Day20);
@@ -1,21 +1,27 @@
+#include "flat_hash.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
-#include <fmt/format.h>
-#include <fstream>
-#include <map>
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/filter.hpp>
+
+#include <cmath>
+#include <istream>
 #include <range/v3/view/getlines.hpp>
-#include <range/v3/view/transform.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
 
-inline std::map<char, double (*)(double, double)> const operation{
+inline aoc::FlatHashMap<char, double (*)(double, double)> const operation{
   {'+', [](double l, double r) { return l + r; }},
   {'-', [](double l, double r) { return l - r; }},
   {'*', [](double l, double r) { return l * r; }},
   {'/', [](double l, double r) { return l / r; }},
 };
 
-void eval(std::map<std::string, double>& t_evaluated, std::map<std::string, std::vector<std::string>>& t_tokens,
-          auto&& t_predicate) {
+using Tokens    = aoc::FlatHashMap<std::string, std::vector<std::string>>;
+using Evaluated = aoc::FlatHashMap<std::string, double>;
+
+void eval(Evaluated& t_evaluated, Tokens const& t_tokens, auto&& t_predicate) {
   while (t_predicate()) {
     for (auto&& [name, expr] : t_tokens) {
       if (t_evaluated.contains(name)) {
@@ -35,32 +41,12 @@ void eval(std::map<std::string, double>& t_evaluated, std::map<std::string, std:
   }
 }
 
-void part1() {
-  using ranges::getlines, ranges::views::transform, ranges::to;
-  using namespace std::string_literals;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | transform([](auto&& t_str) {
-               auto const delimiter = t_str.find(':');
-               auto name            = t_str.substr(0, delimiter);
-               auto expr            = split_string(t_str.substr(delimiter + 2));
-               return std::pair{name, expr};
-             }) |
-             to<std::map>;
-
-  std::map<std::string, double> evaluated;
-  eval(evaluated, rng, [&]() { return not evaluated.contains("root"s); });
-
-  fmt::println("root = {}", evaluated.at("root"s));
-}
-
-auto newton_ralphson(std::map<std::string, std::vector<std::string>>& t_tokens, double t_guess,
-                     double t_epsilon = 1e-6) {
+auto newton_ralphson(Tokens const& t_tokens, double t_guess, double t_epsilon = 1e-6) {
   using namespace std::string_literals;
 
   auto const& root_expr = t_tokens.at("root"s);
 
-  std::map<std::string, double> pre_eval;  // pre eval those that are not dependent of "humn"
+  Evaluated pre_eval;  // pre eval those that are not dependent of "humn"
   eval(pre_eval, t_tokens, [&, size = 1UL]() mutable {
     bool const size_changed = pre_eval.size() == size;
 
@@ -94,27 +80,40 @@ auto newton_ralphson(std::map<std::string, std::vector<std::string>>& t_tokens,
   return t_guess;
 }
 
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to, ranges::views::filter;
-  using namespace std::string_literals;
+struct Day21 {
+  using Parsed = Tokens;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | filter([](auto&& t_str) { return not t_str.starts_with("humn"); }) |
-             transform([](auto&& t_str) {
-               auto const delimiter = t_str.find(':');
-               auto name            = t_str.substr(0, delimiter);
-               auto expr            = split_string(t_str.substr(delimiter + 2));
-               return std::pair{name, expr};
-             }) |
-             to<std::map>;
-
-  auto const result = newton_ralphson(rng, 1);
-  fmt::println("I should yell: {}!", result);
-}
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines;
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+    Tokens ret_val;
+    for (auto&& str : getlines(t_in)) {
+      auto const delimiter = str.find(':');
+      ret_val.emplace(str.substr(0, delimiter), split_string(str.substr(delimiter + 2)));
+    }
 
-  return EXIT_SUCCESS;
-}
+    return ret_val;
+  }
+
+  static double part1(Parsed const& t_tokens) {
+    using namespace std::string_literals;
+
+    Evaluated evaluated;
+    eval(evaluated, t_tokens, [&]() { return not evaluated.contains("root"s); });
+
+    return evaluated.at("root"s);
+  }
+
+  static double part2(Parsed const& t_tokens) {
+    using namespace std::string_literals;
+
+    auto tokens = t_tokens;
+    tokens.erase("humn"s);  // that's me, the value is what we are solving for
+
+    return newton_ralphson(tokens, 1);
+  }
+};
+
+}  // namespace
+
+AOC_REGISTER(2022, 21, Day21);
@@ -1,21 +1,26 @@
+#include "grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
+
+#include <algorithm>
 #include <array>
-#include <cctype>
 #include <cmath>
-#include <fmt/format.h>
-#include <fstream>
+#include <cstddef>
 #include <iterator>
 #include <numeric>
-#include <optional>
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/algorithm/find_if.hpp>
-#include <range/v3/algorithm/max.hpp>
 #include <range/v3/iterator/operations.hpp>
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/getlines.hpp>
+#include <range/v3/range/access.hpp>
 #include <range/v3/view/reverse.hpp>
+#include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
 
 inline constexpr std::array dir_char{'>', 'v', '<', '^'};
 inline constexpr std::array dir_vec{
@@ -25,15 +30,12 @@ inline constexpr std::array dir_vec{
   std::pair{0, -1},  // '^'
 };
 
-inline constexpr auto to_idx       = [](auto&& t_idx) { return static_cast<std::size_t>(t_idx - 1); };
-inline constexpr auto is_in_map    = [](auto const t_chr) { return t_chr != ' '; };
-inline constexpr auto get_col_proj = [](std::size_t const t_x) {
-  return [x = to_idx(t_x)](auto&& t_row) { return x >= t_row.size() ? ' ' : t_row[x]; };
-};
+// the positions are 1 based, the border of the map is at 0 and at its size + 1
+inline constexpr auto to_idx    = [](auto&& t_idx) { return static_cast<std::ptrdiff_t>(t_idx) - 1; };
+inline constexpr auto is_in_map = [](auto const t_chr) { return t_chr != ' '; };
 
-void move(std::vector<std::string>& t_map, std::pair<std::size_t, std::size_t>& t_pos, int t_move, std::size_t& t_dir,
+void move(aoc::Grid2D<char>& t_map, std::pair<std::size_t, std::size_t>& t_pos, int t_move, std::size_t& t_dir,
           auto&& t_check_wrap_around) {
-  using ranges::views::reverse, ranges::find_if, ranges::distance;
   int curr_x = static_cast<int>(t_pos.first);
   int curr_y = static_cast<int>(t_pos.second);
 
@@ -45,7 +47,7 @@ void move(std::vector<std::string>& t_map, std::pair<std::size_t, std::size_t>&
     auto y_tmp            = curr_y + inc_y;
     auto&& [mov_x, mov_y] = t_check_wrap_around(t_map, curr_x, curr_y, x_tmp, y_tmp, t_dir);
 
-    if (t_map[to_idx(mov_y)][to_idx(mov_x)] == '#') {
+    if (t_map[to_idx(mov_x), to_idx(mov_y)] == '#') {
       // check wrap around won't check for obstacles, direction will still be changed even if we can't go there in this
       // function, so we need to change it to previous direction
       t_dir = prev_dir;
@@ -55,51 +57,70 @@ void move(std::vector<std::string>& t_map, std::pair<std::size_t, std::size_t>&
     curr_x = static_cast<int>(mov_x);
     curr_y = static_cast<int>(mov_y);
 
-    t_map[to_idx(curr_y)][to_idx(curr_x)] = dir_char[t_dir];
+    t_map[to_idx(curr_x), to_idx(curr_y)] = dir_char[t_dir];
   }
 
   t_pos.first  = static_cast<std::size_t>(curr_x);
   t_pos.second = static_cast<std::size_t>(curr_y);
 }
 
-inline auto const part1_wraparound = [](auto const& t_map, auto /**/, auto /**/, auto t_x_pos, auto t_y_pos,
-                                        auto& t_dir) {
-  using ranges::views::reverse, ranges::find_if;
+// the tiles outside of the map are ' ', its border included, hence any step off the map lands on one
+inline auto const part1_wraparound = [](aoc::Grid2D<char> const& t_map, auto /**/, auto /**/, auto t_x_pos,
+                                        auto t_y_pos, auto& t_dir) {
+  using ranges::views::reverse, ranges::find_if, ranges::distance;
 
   std::pair<std::size_t, std::size_t> ret_val{t_x_pos, t_y_pos};
+  if (is_in_map(t_map[to_idx(t_x_pos), to_idx(t_y_pos)])) {
+    return ret_val;
+  }
+
+  auto const first_in_map = [](auto&& t_line) {
+    return static_cast<std::size_t>(distance(ranges::begin(t_line), find_if(t_line, is_in_map)) + 1);
+  };
+
+  auto const last_in_map = [](auto&& t_line) {
+    auto reversed = t_line | reverse;
+    return static_cast<std::size_t>(distance(ranges::begin(t_line), find_if(reversed, is_in_map).base()));
+  };
 
-  auto const x_pos = static_cast<std::size_t>(t_x_pos);
-  auto const y_pos = static_cast<std::size_t>(t_y_pos);
-
-  auto const col_proj = get_col_proj(x_pos);
-  if (t_dir == 1 and (y_pos >= t_map.size() + 1 or x_pos >= t_map[to_idx(y_pos)].size() + 1)) {
-    ret_val.second = static_cast<std::size_t>(distance(t_map.begin(), find_if(t_map, is_in_map, col_proj)) + 1);
-  } else if (t_dir == 3 and (y_pos == 0 or t_map[to_idx(y_pos)][to_idx(x_pos)] == ' ')) {
-    auto res       = find_if(t_map | reverse, is_in_map, col_proj).base();
-    ret_val.second = static_cast<std::size_t>(distance(t_map.begin(), res));
-  } else if (t_dir == 0 and (x_pos >= t_map[to_idx(y_pos)].size() + 1)) {
-    auto res      = distance(t_map[to_idx(y_pos)].begin(), find_if(t_map[to_idx(y_pos)], is_in_map));
-    ret_val.first = static_cast<std::size_t>(res + 1);
-  } else if (t_dir == 2 and (x_pos == 0 or t_map[to_idx(y_pos)][to_idx(x_pos)] == ' ')) {
-    auto res      = find_if(t_map[to_idx(y_pos)] | reverse, is_in_map).base();
-    ret_val.first = static_cast<std::size_t>(distance(t_map[to_idx(y_pos)].begin(), res));
+  switch (t_dir) {
+    case 0:
+      ret_val.first = first_in_map(t_map.row(static_cast<std::size_t>(to_idx(t_y_pos))));
+      break;
+    case 1:
+      ret_val.second = first_in_map(t_map.column(static_cast<std::size_t>(to_idx(t_x_pos))));
+      break;
+    case 2:
+      ret_val.first = last_in_map(t_map.row(static_cast<std::size_t>(to_idx(t_y_pos))));
+      break;
+    case 3:
+      ret_val.second = last_in_map(t_map.column(static_cast<std::size_t>(to_idx(t_x_pos))));
+      break;
+    default:
+      std::unreachable();
   }
 
   return ret_val;
 };
 
-void part1() {
-  using ranges::getlines, ranges::to_vector;
+struct Notes {
+  aoc::Grid2D<char> map_;
+  std::string instruction_;
+};
 
-  std::fstream in((INPUT_FILE));
-  auto const rng          = getlines(in) | to_vector;
-  auto const& instruction = rng.back();
-  auto map                = std::vector(rng.begin(), rng.end() - 2);
+auto follow_path(Notes const& t_notes, auto&& t_wraparound) {
+  using ranges::find, ranges::distance;
 
-  auto curr_pos = std::pair{map.front().find('.') + 1, 1UL};
+  auto map                = t_notes.map_;
+  auto const& instruction = t_notes.instruction_;
 
+  // map[0, 0] <-> (1, 1)
+  auto const first_row      = map.row(0);
+  auto const start_x        = distance(first_row.begin(), find(first_row, '.')) + 1;
+  auto curr_pos             = std::pair{static_cast<std::size_t>(start_x), 1UL};
   std::size_t dir           = 0;
   auto const* const end_ptr = std::next(instruction.data(), static_cast<long>(instruction.size()));
+
   for (auto const* ptr = instruction.data(); ptr != end_ptr;) {
     int steps = 0;
     if (auto [non_matching_pos, ec]{ranges_from_chars(std::string_view(ptr, end_ptr), steps)};
@@ -114,30 +135,19 @@ void part1() {
       ptr = non_matching_pos.data();
     }
 
-    move(map, curr_pos, steps, dir, part1_wraparound);
+    move(map, curr_pos, steps, dir, t_wraparound);
   }
 
-  auto result = 1000 * curr_pos.second + 4 * curr_pos.first + dir;
-  fmt::println("result: {}", result);
+  return 1000 * curr_pos.second + 4 * curr_pos.first + dir;
 }
 
-auto find_length_of_cube(std::vector<std::string> const& t_map) {
-  using ranges::max;
-  return std::gcd(t_map.size(), max(t_map, std::less<>{}, [](auto&& t_str) { return t_str.size(); }).size());
-}
+auto find_length_of_cube(aoc::Grid2D<char> const& t_map) { return std::gcd(t_map.height(), t_map.width()); }
 
 auto cube_labeller(int const t_size) {
   return [=](int const t_x, int const t_y) { return std::pair<int, int>{t_x / t_size, t_y / t_size}; };
 }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector;
-
-  std::fstream in((INPUT_FILE));
-  auto const rng          = getlines(in) | to_vector;
-  auto const& instruction = rng.back();
-  auto map                = std::vector(rng.begin(), rng.end() - 2);
-
+auto cube_wraparound(int const t_face_length) {
   // hardcoded right now
   //
   //  cube network          labelled
@@ -154,10 +164,8 @@ void part2() {
                                         std::pair{std::pair{1, 1}, 2UL}, std::pair{std::pair{0, 2}, 3UL},
                                         std::pair{std::pair{1, 2}, 4UL}, std::pair{std::pair{0, 3}, 5UL}};
 
-  auto const face_length      = static_cast<int>(find_length_of_cube(map));
-  auto const part2_wraparound = [&, cube_label = cube_labeller(face_length)](auto const& /*t_map*/, auto t_curr_x,
-                                                                             auto t_curr_y, auto t_x_pos, auto t_y_pos,
-                                                                             auto& t_dir) {
+  return [face_length = t_face_length, cube_label = cube_labeller(t_face_length)](
+           auto const& /*t_map*/, auto t_curr_x, auto t_curr_y, auto t_x_pos, auto t_y_pos, auto& t_dir) {
     using ranges::find;
 
     if (t_y_pos >= 1 and t_x_pos >= 1) {  // e.g. -1 / 50 = 0 instead of -1 => coor (-1, -1) has cube_label (0, 0)
@@ -292,40 +300,25 @@ void part2() {
                              : static_cast<std::size_t>(new_edge_origin.second + edge_dist_to_corner);
     return std::pair{static_cast<std::size_t>(new_edge_origin.first), y};
   };
+}
 
-  // map[0][0] <-> (1, 1)
-  auto curr_pos             = std::pair{map.front().find('.') + 1, 1UL};
-  std::size_t dir           = 0;
-  auto const* const end_ptr = std::next(instruction.data(), static_cast<long>(instruction.size()));
-
-  for (auto const* ptr = instruction.data(); ptr != end_ptr;) {
-    int steps = 0;
-    if (auto [non_matching_pos, ec]{ranges_from_chars(std::string_view(ptr, end_ptr), steps)};
-        ec == std::errc::invalid_argument) {  // R or L
-      if (*ptr == 'R') {
-        dir = (dir + 1) % 4;
-      } else {
-        dir = (dir + 3) % 4;  // dir = 0 -> dir - 1 = 3; dir = 1 -> dir - 1 = 0
-      }
-      ptr = std::next(ptr);
-    } else if (ec == std::errc()) {
-      ptr = non_matching_pos.data();
-    }
+struct Day22 {
+  using Parsed = Notes;
 
-    move(map, curr_pos, steps, dir, part2_wraparound);
+  // the map, an empty line and the path
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    auto const lines = t_in.lines();
+    return Notes{.map_         = aoc::Grid2D<char>::from_lines(lines.first(lines.size() - 2), 1, ' '),
+                 .instruction_ = std::string{lines.back()}};
   }
 
-  // for (auto&& row : map) {
-  //   fmt::println("{}", row);
-  // }
+  static std::size_t part1(Parsed const& t_notes) { return follow_path(t_notes, part1_wraparound); }
 
-  auto result = 1000 * curr_pos.second + 4 * curr_pos.first + dir;
-  fmt::println("result: {}", result);
-}
+  static std::size_t part2(Parsed const& t_notes) {
+    return follow_path(t_notes, cube_wraparound(static_cast<int>(find_length_of_cube(t_notes.map_))));
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 22, Day22);
@@ -1,214 +1,152 @@
+#include "bit_grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
+
+#include <algorithm>
 #include <array>
-#include <cmath>
 #include <cstddef>
-#include <fmt/format.h>
-#include <fstream>
-#include <functional>
-#include <map>
-#include <range/v3/algorithm.hpp>
-#include <range/v3/view.hpp>
-#include <set>
+#include <limits>
 #include <utility>
-#include <vector>
-
-struct Elf;
-
-using Coor    = std::pair<int, int>;
-using DirPred = std::pair<bool (*)(std::set<Coor> const&, Elf const&), Coor (*)(Coor)>;
 
-struct Elf {
-  bool conflicted_proposal_ = false;
-  bool have_neighbor_       = false;
-  DirPred predicate_        = {nullptr, nullptr};
-  Coor coor_;
+namespace {
 
-  [[nodiscard]] Coor get_coor() const noexcept { return this->coor_; }
+enum Direction : std::size_t { NORTH, SOUTH, WEST, EAST };
 
-  bool operator==(Elf const& t_elf) const noexcept { return this->coor_ == t_elf.coor_; }
-
-  explicit Elf(Coor t_coor) : coor_(std::move(t_coor)) {}
+inline constexpr std::array<std::pair<std::ptrdiff_t, std::ptrdiff_t>, 4> STEP{
+  std::pair{0, -1},  // north
+  std::pair{0, 1},   // south
+  std::pair{-1, 0},  // west
+  std::pair{1, 0},   // east
 };
 
-template <char Dir>
-inline constexpr auto adjacent = [](Coor const& t_to_check) {
-  //    N
-  //  W + E
-  //    S
-
-  auto&& [x_check, y_check] = t_to_check;
-  if constexpr (Dir == 'N') {
-    return std::array{Coor{x_check - 1, y_check - 1}, Coor{x_check, y_check - 1}, Coor{x_check + 1, y_check - 1}};
-  } else if constexpr (Dir == 'S') {
-    return std::array{Coor{x_check - 1, y_check + 1}, Coor{x_check, y_check + 1}, Coor{x_check + 1, y_check + 1}};
-  } else if constexpr (Dir == 'W') {
-    return std::array{Coor{x_check - 1, y_check - 1}, Coor{x_check - 1, y_check}, Coor{x_check - 1, y_check + 1}};
-  } else if constexpr (Dir == 'E') {
-    return std::array{Coor{x_check + 1, y_check - 1}, Coor{x_check + 1, y_check}, Coor{x_check + 1, y_check + 1}};
-  }
-
-  std::unreachable();
-};
-
-inline constexpr std::array<DirPred, 4> MOVE_ORDER = {
-  DirPred{[](std::set<Coor> const& t_elves, Elf const& t_elf_to_check) {
-            return ranges::none_of(adjacent<'N'>(t_elf_to_check.coor_),
-                                   [&](auto&& t_coor) { return t_elves.contains(t_coor); });
-          },
-          [](Coor t_v) { return --t_v.second, t_v; }},  // abomination
-  DirPred{[](std::set<Coor> const& t_elves, Elf const& t_elf_to_check) {
-            return ranges::none_of(adjacent<'S'>(t_elf_to_check.coor_),
-                                   [&](auto&& t_coor) { return t_elves.contains(t_coor); });
-          },
-          [](Coor t_v) { return ++t_v.second, t_v; }},
-  DirPred{[](std::set<Coor> const& t_elves, Elf const& t_elf_to_check) {
-            return ranges::none_of(adjacent<'W'>(t_elf_to_check.coor_),
-                                   [&](auto&& t_coor) { return t_elves.contains(t_coor); });
-          },
-          [](Coor t_v) { return --t_v.first, t_v; }},
-  DirPred{[](std::set<Coor> const& t_elves, Elf const& t_elf_to_check) {
-            return ranges::none_of(adjacent<'E'>(t_elf_to_check.coor_),
-                                   [&](auto&& t_coor) { return t_elves.contains(t_coor); });
-          },
-          [](Coor t_v) { return ++t_v.first, t_v; }},
-};
-
-void debug_print(std::vector<Elf> const& t_elves, std::size_t const t_round) {
-  using ranges::minmax;
-
-  auto&& [min_x, max_x] = minmax(t_elves, std::less<>{}, [](auto const& t_elf) { return t_elf.get_coor().first; });
-  auto&& [min_y, max_y] = minmax(t_elves, std::less<>{}, [](auto const& t_elf) { return t_elf.get_coor().second; });
+// the elves spread by at most one tile a round, the grid grows by MARGIN tiles on every side whenever an elf reaches
+// its edge, a round can then look at the neighbours of every elf and move it without losing it out of the grid
+inline constexpr std::size_t MARGIN = 16;
 
-  auto const x_size = static_cast<std::size_t>(max_x.coor_.first - min_x.coor_.first) + 1;
-  auto const y_size = static_cast<std::size_t>(max_y.coor_.second - min_y.coor_.second) + 1;
-
-  std::vector<std::string> map(y_size, std::string(x_size, '.'));
-  for (auto&& elf : t_elves) {
-    auto&& [elf_x, elf_y] = elf.get_coor();
-    auto const x_idx      = static_cast<std::size_t>(elf_x - min_x.coor_.first);
-    auto const y_idx      = static_cast<std::size_t>(elf_y - min_y.coor_.second);
-
-    map[y_idx][x_idx] = '#';
+bool on_edge(aoc::BitGrid const& t_elves) {
+  auto const any = [](auto&& t_words) { return std::ranges::any_of(t_words, [](auto t_word) { return t_word != 0; }); };
+  if (any(t_elves.row(0)) or any(t_elves.row(t_elves.height() - 1))) {
+    return true;
   }
 
-  for (auto&& row : map) {
-    fmt::println("{}", row);
+  auto const last_x = t_elves.width() - 1;
+  for (std::size_t y = 1; y + 1 < t_elves.height(); ++y) {
+    if (t_elves.test(0, y) or t_elves.test(last_x, y)) {
+      return true;
+    }
   }
 
-  fmt::println("== End of Round {} == ", t_round);
+  return false;
 }
 
-void move(std::vector<Elf>& t_elves, auto&& t_direction_predicate) {
-  using ranges::find_if, ranges::views::transform, ranges::to, ranges::views::drop;
+// One round, every elf at once: each direction is checked for the whole grid with a few shifts. Returns whether an elf
+// moved
+bool spread(aoc::BitGrid& t_elves, std::size_t const t_first_direction) {
+  if (on_edge(t_elves)) {
+    auto const margin = static_cast<std::ptrdiff_t>(MARGIN);
+    t_elves           = t_elves.resized(t_elves.width() + 2 * MARGIN, t_elves.height() + 2 * MARGIN, margin, margin);
+  }
 
-  auto const elf_position = t_elves | transform(&Elf::get_coor) | to<std::set>;
-  std::map<Coor, Elf&> proposed_position;
+  // an elf north of the tile, south of it...
+  auto const north      = t_elves.shifted(0, 1);
+  auto const south      = t_elves.shifted(0, -1);
+  auto const north_west = north.shifted(1, 0);
+  auto const north_east = north.shifted(-1, 0);
+  auto const south_west = south.shifted(1, 0);
+  auto const south_east = south.shifted(-1, 0);
+
+  // the tiles with an elf among the three tiles of a direction
+  std::array const crowded{
+    north | north_west | north_east,
+    south | south_west | south_east,
+    t_elves.shifted(1, 0) | north_west | south_west,
+    t_elves.shifted(-1, 0) | north_east | south_east,
+  };
+
+  // the elves with a neighbour propose the first direction without any, the others stay
+  auto undecided = t_elves & (crowded[NORTH] | crowded[SOUTH] | crowded[WEST] | crowded[EAST]);
+  auto next      = and_not(t_elves, undecided);
+
+  std::array<aoc::BitGrid, 4> proposed;  // the tile every elf proposes
+  for (std::size_t i = 0; i < STEP.size(); ++i) {
+    auto const direction = (t_first_direction + i) % STEP.size();
+    auto const [x, y]    = STEP[direction];
+    proposed[direction]  = and_not(undecided, crowded[direction]).shifted(x, y);
+
+    undecided &= crowded[direction];
+  }
 
-  for (auto&& elf : t_elves) {
-    auto const no_neighbor   = [&](auto&& t_pred) { return (*t_pred.first)(elf_position, elf); };
-    auto const have_neighbor = [&](auto&& t_pred) { return not no_neighbor(t_pred); };
+  next |= undecided;
 
-    elf.conflicted_proposal_ = false;
-    auto const move_result   = [&]() {
-      auto const begin         = ranges::begin(t_direction_predicate);
-      auto const end           = ranges::end(t_direction_predicate);
-      auto const first_invalid = find_if(t_direction_predicate, have_neighbor);
-      if (first_invalid == end) {
-        return DirPred{nullptr, nullptr};
-      }
+  // two elves proposing the same tile come from opposite sides, any other pair of them would see each other. Those
+  // stay where they are
+  std::array const conflicts{proposed[NORTH] & proposed[SOUTH], proposed[WEST] & proposed[EAST]};
+  for (std::size_t direction = 0; direction < STEP.size(); ++direction) {
+    auto const& conflict = conflicts[direction / 2];
+    auto const [x, y]    = STEP[direction];
 
-      if (first_invalid != begin) {
-        return *begin;
-      }
-
-      auto const first_valid = find_if(ranges::next(first_invalid), end, no_neighbor);
-      if (first_valid != end) {
-        return *first_valid;
-      }
+    next |= and_not(proposed[direction], conflict);
+    next |= conflict.shifted(-x, -y);
+  }
 
-      return DirPred{nullptr, nullptr};  // neighbor everywhere
-    }();
+  auto const moved = next != t_elves;
+  t_elves          = std::move(next);
+  return moved;
+}
 
-    elf.predicate_          = move_result;
-    auto&& [checker, mover] = move_result;
-    if (checker == nullptr and mover == nullptr) {
-      continue;
-    }
+struct Day23 {
+  using Parsed = aoc::BitGrid;
 
-    if (auto coor = (*mover)(elf.coor_); not proposed_position.contains(coor)) {
-      proposed_position.emplace(coor, elf);
-    } else {
-      auto& same_proposal_elf                = proposed_position.at(coor);
-      same_proposal_elf.conflicted_proposal_ = true;
-      elf.conflicted_proposal_               = true;
-    }
-  }
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    auto const lines = t_in.lines();
 
-  for (auto&& elf : t_elves) {
-    if (auto&& [_, mover] = elf.predicate_; not elf.conflicted_proposal_ and _ != nullptr and mover != nullptr) {
-      elf.coor_ = (*mover)(elf.coor_);
+    std::size_t width = 0;
+    for (auto const line : lines) {
+      width = std::max(width, line.size());
     }
-  }
-}
-
-auto get_elves_coor_from_map(auto&& t_map) {
-  std::vector<Elf> ret_val;
 
-  ret_val.reserve(t_map.size() * t_map[0].size());
-  for (std::size_t i = 0; i < t_map.size(); ++i) {
-    auto& row = t_map[i];
-    for (std::size_t j = 0; j < t_map[i].size(); ++j) {
-      if (row[j] == '#') {
-        ret_val.emplace_back(std::pair{static_cast<int>(j), static_cast<int>(i)});
+    aoc::BitGrid ret_val{width + 2 * MARGIN, lines.size() + 2 * MARGIN};
+    for (std::size_t y = 0; y < lines.size(); ++y) {
+      for (std::size_t x = 0; x < lines[y].size(); ++x) {
+        if (lines[y][x] == '#') {
+          ret_val.set(x + MARGIN, y + MARGIN);
+        }
       }
     }
-  }
-
-  return ret_val;
-}
-
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::minmax, ranges::views::cycle, ranges::views::sliding,
-    ranges::views::take;
-
-  std::fstream in((INPUT_FILE));
-  auto const rng = getlines(in) | to_vector;
 
-  auto elves = get_elves_coor_from_map(rng);
-  for (auto&& current_order : MOVE_ORDER | cycle | sliding(MOVE_ORDER.size()) | take(10)) {
-    move(elves, current_order);
+    return ret_val;
   }
 
-  auto&& [min_x, max_x] = minmax(elves, std::less<>{}, [](auto const& t_elf) { return t_elf.get_coor().first; });
-  auto&& [min_y, max_y] = minmax(elves, std::less<>{}, [](auto const& t_elf) { return t_elf.get_coor().second; });
-
-  auto const total_tile = (max_x.coor_.first - min_x.coor_.first + 1) * (max_y.coor_.second - min_y.coor_.second + 1);
-  fmt::println("empty ground tiles: {}", total_tile - static_cast<int>(elves.size()));
-}
-
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::views::cycle, ranges::views::sliding, ranges::views::take;
-
-  std::fstream in((INPUT_FILE));
-  auto const rng = getlines(in) | to_vector;
+  static std::size_t part1(Parsed const& t_elves) {
+    auto elves = t_elves;
+    for (std::size_t round = 0; round < 10; ++round) {
+      spread(elves, round % STEP.size());
+    }
 
-  auto elves       = get_elves_coor_from_map(rng);
-  auto prev_result = elves;
-  for (std::size_t round = 0; auto&& current_order : MOVE_ORDER | cycle | sliding(MOVE_ORDER.size())) {
-    move(elves, current_order);
-    ++round;
+    auto min_x = std::numeric_limits<std::size_t>::max();
+    auto min_y = std::numeric_limits<std::size_t>::max();
+    auto max_x = std::size_t{0};
+    auto max_y = std::size_t{0};
+    elves.for_each_set([&](std::size_t const t_x, std::size_t const t_y) {
+      min_x = std::min(min_x, t_x);
+      max_x = std::max(max_x, t_x);
+      min_y = std::min(min_y, t_y);
+      max_y = std::max(max_y, t_y);
+    });
+
+    return (max_x - min_x + 1) * (max_y - min_y + 1) - elves.count();
+  }
 
-    if (prev_result == elves) {
-      fmt::println("After {} of rounds, no elves moves for the first time", round);
-      break;
+  static std::size_t part2(Parsed const& t_elves) {
+    auto elves = t_elves;
+    for (std::size_t round = 0;; ++round) {
+      if (not spread(elves, round % STEP.size())) {
+        return round + 1;  // no elves moves for the first time
+      }
     }
-
-    prev_result = elves;
   }
-}
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 23, Day23);
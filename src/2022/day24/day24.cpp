@@ -1,14 +1,25 @@
-#include <fmt/format.h>
-#include <fstream>
+#include "bit_grid.hpp"
+#include "cycle.hpp"
+#include "grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
+#include "shortest_path.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <limits>
-#include <range/v3/action/sort.hpp>
-#include <range/v3/algorithm/find_if.hpp>
+#include <optional>
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view.hpp>
+#include <tuple>
 #include <utility>
+#include <vector>
+
+namespace {
 
 using ranges::views::zip, ranges::views::repeat, ranges::views::cycle, ranges::views::drop, ranges::views::reverse;
 
@@ -83,21 +94,13 @@ class Blizzard {
 using Blizzards = std::tuple<std::vector<Blizzard<'>'>>, std::vector<Blizzard<'<'>>, std::vector<Blizzard<'^'>>,
                              std::vector<Blizzard<'v'>>>;
 
-struct MapState {
-  Coor my_pos_;
-  std::size_t cycle_idx_ = 0;
-  std::size_t time_      = 0;
-
-  bool operator==(MapState const&) const = default;
-};
-
-auto parse_map(Blizzards& t_blizzards, std::vector<std::string> const& t_map, std::vector<std::size_t> const& t_row,
+auto parse_map(Blizzards& t_blizzards, aoc::Grid2D<char> const& t_map, std::vector<std::size_t> const& t_row,
                std::vector<std::size_t> const& t_col) {
   Coor init_pos;
   Coor exit_pos;
 
-  for (std::size_t i = 0; i < t_map.size(); ++i) {
-    auto const& row = t_map[i];
+  for (std::size_t i = 0; i < t_map.height(); ++i) {
+    auto const row = t_map.row(i);
     for (std::size_t j = 0; j < row.size(); ++j) {
       auto const current_coor = Coor(j, i);
       if (char const v = row[j]; v == 'E') [[unlikely]] {
@@ -119,7 +122,7 @@ auto parse_map(Blizzards& t_blizzards, std::vector<std::string> const& t_map, st
           default:
             std::unreachable();
         }
-      } else if (v == '.' and i + 1 == t_map.size()) {
+      } else if (v == '.' and i + 1 == t_map.height()) {
         exit_pos = current_coor;
       }
     }
@@ -128,87 +131,6 @@ auto parse_map(Blizzards& t_blizzards, std::vector<std::string> const& t_map, st
   return std::pair(init_pos, exit_pos);
 }
 
-inline constexpr std::array<std::pair<bool (*)(Coor, std::vector<std::string> const&), Coor (*)(Coor)>, 5> MOVE{
-  // right
-  std::pair{[](Coor t_current, std::vector<std::string> const& t_map) {
-              auto [x, y] = t_current;
-              return x + 1 < t_map[y].size() and t_map[y][x + 1] == '.';
-            },
-            [](Coor t_coor) { return ++t_coor.first, t_coor; }},
-  // left
-  std::pair{[](Coor t_current, std::vector<std::string> const& t_map) {
-              auto [x, y] = t_current;
-              return x >= 1 and t_map[y][x - 1] == '.';
-            },
-            [](Coor t_coor) { return --t_coor.first, t_coor; }},
-  // down
-  std::pair{[](Coor t_current, std::vector<std::string> const& t_map) {
-              auto [x, y] = t_current;
-              return y + 1 < t_map.size() and t_map[y + 1][x] == '.';
-            },
-            [](Coor t_coor) { return ++t_coor.second, t_coor; }},
-  // up
-  std::pair{[](Coor t_current, std::vector<std::string> const& t_map) {
-              auto [x, y] = t_current;
-              return y >= 1 and t_map[y - 1][x] == '.';
-            },
-            [](Coor t_coor) { return --t_coor.second, t_coor; }},
-  // wait
-  std::pair{[](Coor t_current, std::vector<std::string> const& t_map) {
-              auto [x, y] = t_current;
-              return t_map[y][x] == '.';
-            },
-            [](Coor t_coor) { return t_coor; }},
-};
-
-void print_blizzard(std::vector<std::string> t_map, std::vector<Coor> const& t_blizzards_pos,
-                    std::vector<char> const& t_blizzards_dir, std::size_t const t_current_time,
-                    Coor const& t_current_pos = {1, 0}) {
-  fmt::println("-- {} minutes ----", t_current_time);
-
-  for (std::size_t i = 1; i < t_map.size() - 1; ++i) {
-    for (std::size_t j = 1; j < t_map[i].size() - 1; ++j) {
-      t_map[i][j] = '.';
-    }
-  }
-
-  for (std::size_t i = 0; i < t_blizzards_pos.size(); ++i) {
-    auto&& [x, y] = t_blizzards_pos[i];
-    auto&& dir    = t_blizzards_dir[i];
-
-    if (t_map[y][x] != '.') {
-      if (t_map[y][x] == '>' or t_map[y][x] == '^' or t_map[y][x] == '<' or t_map[y][x] == 'v') {
-        t_map[y][x] = '2';
-      } else {
-        ++t_map[y][x];
-      }
-    } else {
-      t_map[y][x] = dir;
-    }
-  }
-
-  auto&& [c_x, c_y] = t_current_pos;
-  t_map[c_y][c_x]   = 'E';
-
-  for (auto&& row : t_map) {
-    fmt::println("{}", row);
-  }
-}
-
-auto get_blizzards_dir(Blizzards const& t_blizzards) {
-  auto blizzard_dir_helper = [&]<std::size_t... I>(std::index_sequence<I...>) {
-    using ranges::views::concat, ranges::views::cache1, ranges::to_vector, ranges::views::transform;
-
-    return concat((std::get<I>(t_blizzards)                                                //
-                   | transform(&std::tuple_element_t<I, Blizzards>::value_type::get_sign)  //
-                   | cache1)                                                               //
-                  ...) |
-           to_vector;
-  };
-
-  return blizzard_dir_helper(std::make_index_sequence<std::tuple_size_v<Blizzards>>{});
-}
-
 auto get_blizzards_pos(Blizzards const& t_blizzards) {
   auto blizzard_pos_helper = [&]<std::size_t... I>(std::index_sequence<I...>) {
     using ranges::views::concat, ranges::to_vector, ranges::views::transform, ranges::views::cache1;
@@ -233,147 +155,149 @@ auto move_blizzards(Blizzards& t_blizzards) {
 }
 
 class MoveSimulator {
-  std::vector<std::string> map_;
+  aoc::Grid2D<char> map_;  // the walls, without the blizzards
 
   std::reference_wrapper<Blizzards> blizzards_;
 
-  std::size_t cycle_       = 0;
-  std::size_t current_min_ = std::numeric_limits<std::size_t>::max();
+  // the tiles covered by a blizzard at every minute, computed as the search gets there until they cycle (see
+  // cycle.hpp), every minute is then one of those. The positions of the blizzards are too many to be kept for every
+  // minute, only their fingerprint is
+  aoc::CycleDetector<std::uint64_t> detector_;
+  std::optional<aoc::Cycle> cycle_;
+  std::vector<aoc::BitGrid> blizzard_map_;
 
-  Coor map_size_{map_.front().size(), map_.size()};
-  std::vector<std::vector<Coor>> blizzard_pos_;
-  std::vector<MapState> history_;
+  [[nodiscard]] aoc::BitGrid to_blizzard_map(std::vector<Coor> const& t_blizzards_pos) const {
+    aoc::BitGrid ret_val{this->map_.width(), this->map_.height()};
+    for (auto&& [x, y] : t_blizzards_pos) {
+      ret_val.set(x, y);
+    }
 
-  void update_map(std::vector<Coor> const& t_blizzards_pos, Coor const t_exit_pos) {
-    using ranges::subrange;
+    return ret_val;
+  }
 
-    this->map_[t_exit_pos.second][t_exit_pos.first] = '.';
-    for (auto&& row : subrange{this->map_.begin() + 1, this->map_.end() - 1}) {
-      for (auto&& elem : subrange{row.begin() + 1, row.end() - 1}) {
-        elem = '.';
-      }
+  // the blizzards of the next minute, the cycle closes if they were there at an earlier one
+  void record_blizzards() {
+    auto const pos = get_blizzards_pos(this->blizzards_);
+    this->cycle_   = this->detector_.push(aoc::fingerprint(pos));
+    if (not this->cycle_) {
+      this->blizzard_map_.push_back(this->to_blizzard_map(pos));
     }
+  }
 
-    for (auto&& [x, y] : t_blizzards_pos) {
-      this->map_[y][x] = 'x';
+  // the tiles covered by a blizzard at t_time
+  [[nodiscard]] aoc::BitGrid const& blizzards_at(std::size_t const t_time) {
+    while (not this->cycle_ and this->blizzard_map_.size() <= t_time) {
+      move_blizzards(this->blizzards_);
+      this->record_blizzards();
     }
+
+    return this->blizzard_map_[this->cycle_ ? this->cycle_->index(t_time) : t_time];
   }
 
  public:
-  MoveSimulator(std::vector<std::string> t_map, Blizzards& t_blizzards)
-    : map_{std::move(t_map)}, blizzards_{t_blizzards}, blizzard_pos_{get_blizzards_pos(blizzards_)} {}
+  MoveSimulator(aoc::Grid2D<char> t_map, Blizzards& t_blizzards) : map_{std::move(t_map)}, blizzards_{t_blizzards} {
+    for (std::size_t y = 1; y + 1 < this->map_.height(); ++y) {
+      std::ranges::fill(this->map_.row(y).subspan(1, this->map_.width() - 2), '.');
+    }
 
-  void reset() noexcept {
-    this->current_min_ = std::numeric_limits<std::size_t>::max();
-    this->history_.clear();
+    this->record_blizzards();
   }
 
-  [[nodiscard]] auto get_result() const noexcept { return this->current_min_; }
-
-  void simulate(Coor const t_current_pos, Coor const t_exit_pos, std::size_t const t_current_time = 1) {
-    using ranges::views::transform, ranges::views::filter, ranges::to_vector, ranges::find_if, ranges::actions::sort;
-
-    if (this->blizzard_pos_.size() <= t_current_time and this->cycle_ == 0) {
-      // move blizzard first, then decide where we can go
-      move_blizzards(this->blizzards_);
-
-      if (auto pos = get_blizzards_pos(this->blizzards_);
-          this->blizzard_pos_.empty() or this->blizzard_pos_.front() != pos) {
-        this->blizzard_pos_.emplace_back(std::move(pos));
-      } else {
-        this->cycle_ = t_current_time;
-        fmt::println("found cycle: {}", this->cycle_);
-      }
+  // the minutes before the blizzards repeat themselves, and how often they do
+  [[nodiscard]] aoc::Cycle cycle() {
+    while (not this->cycle_) {
+      static_cast<void>(this->blizzards_at(this->blizzard_map_.size()));
     }
 
-    auto const blizzard_idx = this->cycle_ == 0 ? t_current_time : t_current_time % this->cycle_;
-    if (auto current_state = MapState{t_current_pos, blizzard_idx, t_current_time};
-        t_current_time >= this->current_min_ or find_if(this->history_, [&](auto&& t_state) {
-                                                  return t_state.my_pos_ == current_state.my_pos_ and
-                                                         t_state.cycle_idx_ == current_state.cycle_idx_ and
-                                                         t_state.time_ <= current_state.time_;
-                                                }) != this->history_.end()) {
-      return;
-    }
+    return *this->cycle_;
+  }
 
-    this->history_.emplace_back(t_current_pos, blizzard_idx, t_current_time);
-    this->update_map(this->blizzard_pos_[blizzard_idx], t_exit_pos);
-    auto const candidates =
-      MOVE                                                                                //
-      | filter([&](auto&& t_mover) { return t_mover.first(t_current_pos, this->map_); })  //
-      | transform([&](auto&& t_mover) { return t_mover.second(t_current_pos); })          //
-      | to_vector                                                                         //
-      | sort(std::less<>{}, [&](auto&& t_coor) {
-          return std::max(t_coor.first, t_exit_pos.first) - std::min(t_coor.first, t_exit_pos.first) +
-                 std::max(t_coor.second, t_exit_pos.second) - std::min(t_coor.second, t_exit_pos.second);
-        });
-
-    for (auto&& pos : candidates) {
-      if (pos == t_exit_pos) {
-        this->current_min_ = t_current_time;
-        return;
+  // The earliest minute t_exit_pos can be reached from t_init_pos, leaving at t_init_time. An A* over the tiles at
+  // every minute of the cycle of the blizzards (see shortest_path.hpp), a tile at a minute is settled once: getting
+  // there a cycle later doesn't lead anywhere new. Every move takes a minute and the manhattan distance to the exit is
+  // what is left at the very least, the tiles closer to the exit are tried first
+  [[nodiscard]] std::size_t simulate(Coor const t_init_pos, Coor const t_exit_pos, std::size_t const t_init_time = 1) {
+    // the walls around the exit open up, the start is the exit of the way back
+    auto map = this->map_;
+    map[t_exit_pos.first, t_exit_pos.second] = '.';
+
+    auto const cells      = map.cells().size();
+    auto const cycle      = this->cycle();
+    auto const start_time = t_init_time - 1;
+    auto const exit       = map.index(t_exit_pos.first, t_exit_pos.second);
+
+    // a tile at a minute of the cycle
+    auto const node = [&](std::size_t const t_idx, std::size_t const t_time) {
+      return cycle.index(t_time) * cells + t_idx;
+    };
+
+    // the key of a move is the same, one more (waiting) or two more (moving away from the exit)
+    aoc::ShortestPath<aoc::BucketQueue<std::size_t>> search{
+      cells * (cycle.start_ + cycle.length_),
+      std::array{node(map.index(t_init_pos.first, t_init_pos.second), start_time)}, aoc::BucketQueue<std::size_t>{2}};
+
+    // right, left, down, up or wait. The border of the map is '#', the moves never leave it
+    auto const moves = [&](std::size_t const t_node, auto&& t_relax) {
+      auto const idx        = t_node % cells;
+      auto const time       = start_time + search.distance(t_node) + 1;
+      auto const& blizzards = this->blizzards_at(time);
+      for (auto const to : {idx + 1, idx - 1, idx + map.stride(), idx - map.stride(), idx}) {
+        auto const [x, y] = map.coordinates(to);
+        if (map[to] == '.' and not blizzards.test(static_cast<std::size_t>(x), static_cast<std::size_t>(y))) {
+          t_relax(node(to, time), 1);
+        }
       }
+    };
 
-      this->simulate(pos, t_exit_pos, t_current_time + 1);
-    }
+    auto const manhattan = aoc::manhattan_to(map, exit);
+    auto const minutes   = search.find(
+      moves, [&](std::size_t const t_node) { return manhattan(t_node % cells); },
+      [&](std::size_t const t_node) { return t_node % cells == exit; });
+
+    return start_time + minutes.value();
   }
 };
 
-void debug_blizzard(std::vector<std::string> const& t_map, Blizzards& t_blizzards, std::size_t const t_turns) {
-  for (std::size_t k = 0; k < t_turns; ++k) {
-    print_blizzard(t_map, get_blizzards_pos(t_blizzards), get_blizzards_dir(t_blizzards), k);
-    move_blizzards(t_blizzards);
+// blizzards keep views into the row / col vectors and move while simulating, so every part builds its own set from the
+// parsed map
+struct Valley {
+  std::vector<std::size_t> row_vector_;
+  std::vector<std::size_t> col_vector_;
+  Blizzards blizzards_;
+  Coor init_pos_;
+  Coor exit_pos_;
+
+  explicit Valley(aoc::Grid2D<char> const& t_map)
+    : row_vector_{ranges::views::iota(1UL, t_map.width() - 1) | ranges::to_vector},
+      col_vector_{ranges::views::iota(1UL, t_map.height() - 1) | ranges::to_vector} {
+    std::tie(this->init_pos_, this->exit_pos_) =
+      parse_map(this->blizzards_, t_map, this->row_vector_, this->col_vector_);
   }
+};
 
-  print_blizzard(t_map, get_blizzards_pos(t_blizzards), get_blizzards_dir(t_blizzards), t_turns);
-}
-
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::views::iota;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in) | to_vector;
-
-  Blizzards blizzards;
-  auto const row_vector                        = iota(1UL, rng.front().size() - 1) | to_vector;
-  auto const col_vector                        = iota(1UL, rng.size() - 1) | to_vector;
-  [[maybe_unused]] auto&& [init_pos, exit_pos] = parse_map(blizzards, rng, row_vector, col_vector);
-
-  MoveSimulator simulator{rng, blizzards};
-  simulator.simulate(init_pos, exit_pos);
-
-  fmt::println("init -> exit: {}", simulator.get_result());
-}
-
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::views::iota;
+struct Day24 {
+  using Parsed = aoc::Grid2D<char>;
 
-  std::fstream in((INPUT_FILE));
-  auto const rng = getlines(in) | to_vector;
+  static Parsed parse(aoc::MappedInput const& t_in) { return aoc::Grid2D<char>::from_lines(t_in.lines(), 1, '#'); }
 
-  Blizzards blizzards;
-  auto const row_vector       = iota(1UL, rng.front().size() - 1) | to_vector;
-  auto const col_vector       = iota(1UL, rng.size() - 1) | to_vector;
-  auto&& [init_pos, exit_pos] = parse_map(blizzards, rng, row_vector, col_vector);
+  static std::size_t part1(Parsed const& t_map) {
+    Valley valley{t_map};
 
-  MoveSimulator simulator{rng, blizzards};
-  simulator.simulate(init_pos, exit_pos);
-  auto total = simulator.get_result();
-  fmt::println("init -> exit: {}", total);
-  simulator.reset();
+    MoveSimulator simulator{t_map, valley.blizzards_};
+    return simulator.simulate(valley.init_pos_, valley.exit_pos_);
+  }
 
-  simulator.simulate(exit_pos, init_pos, total + 1);
-  fmt::println("exit -> init: {}", simulator.get_result());
-  total = simulator.get_result();
-  simulator.reset();
+  static std::size_t part2(Parsed const& t_map) {
+    Valley valley{t_map};
+    auto const [init_pos, exit_pos] = std::pair{valley.init_pos_, valley.exit_pos_};
 
-  simulator.simulate(init_pos, exit_pos, total + 1);
-  fmt::println("init -> exit: {}", simulator.get_result());
-}
+    MoveSimulator simulator{t_map, valley.blizzards_};
+    auto total = simulator.simulate(init_pos, exit_pos);
+    total      = simulator.simulate(exit_pos, init_pos, total + 1);
+    return simulator.simulate(init_pos, exit_pos, total + 1);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  // part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 24, Day24);
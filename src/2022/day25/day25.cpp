@@ -1,14 +1,19 @@
+#include "registry.hpp"
+
 #include <array>
 #include <cmath>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <range/v3/algorithm/max.hpp>
 #include <range/v3/algorithm/reverse.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/transform.hpp>
+#include <string>
 #include <utility>
+#include <vector>
+
+namespace {
 
 inline constexpr std::array NUMBER_FORMAT{'=', '-', '0', '1', '2'};
 inline constexpr auto POWER = 5;
@@ -65,61 +70,67 @@ auto carry(int const t_value) {
 
 auto to_snafu(int const t_value) { return NUMBER_FORMAT[static_cast<std::size_t>(t_value) + 2]; }
 
-void part1() {
-  using ranges::getlines, ranges::views::transform, ranges::reverse, ranges::to_vector, ranges::max,
-    ranges::views::filter, ranges::to;
-
-  std::fstream in((INPUT_FILE));
-  auto const rng = getlines(in) | transform([](auto&& t_str) {
-                     reverse(t_str);
-                     return t_str;
-                   }) |
-                   to_vector;
-
-  auto const max_digit = max(rng, std::less<>{}, [](auto&& t_str) { return t_str.size(); }).size();
-
-  std::vector<int> res(max_digit, 0);
-  for (std::size_t i = 0; i < max_digit; ++i) {
-    auto& current_digit = res[i];
-    for (auto&& str : rng | filter([=](auto&& t_str) { return t_str.size() > i; })) {
-      switch (str[i]) {
-        case '1':
-          current_digit += 1;
-          break;
-        case '2':
-          current_digit += 2;
-          break;
-        case '0':
-          break;
-        case '-':
-          current_digit -= 1;
-          break;
-        case '=':
-          current_digit -= 2;
-          break;
-        default:
-          std::unreachable();
+struct Day25 {
+  // the digits are stored least significant first
+  using Parsed = std::vector<std::string>;
+
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::views::transform, ranges::reverse, ranges::to_vector;
+
+    return getlines(t_in) | transform([](auto&& t_str) {
+             reverse(t_str);
+             return t_str;
+           }) |
+           to_vector;
+  }
+
+  static std::string part1(Parsed const& t_numbers) {
+    using ranges::views::transform, ranges::reverse, ranges::max, ranges::views::filter, ranges::to;
+
+    auto const max_digit = max(t_numbers, std::less<>{}, [](auto&& t_str) { return t_str.size(); }).size();
+
+    std::vector<int> res(max_digit, 0);
+    for (std::size_t i = 0; i < max_digit; ++i) {
+      auto& current_digit = res[i];
+      for (auto&& str : t_numbers | filter([=](auto&& t_str) { return t_str.size() > i; })) {
+        switch (str[i]) {
+          case '1':
+            current_digit += 1;
+            break;
+          case '2':
+            current_digit += 2;
+            break;
+          case '0':
+            break;
+          case '-':
+            current_digit -= 1;
+            break;
+          case '=':
+            current_digit -= 2;
+            break;
+          default:
+            std::unreachable();
+        }
       }
     }
-  }
 
-  for (std::size_t i = 0; i + 1 < res.size(); ++i) {
-    auto&& [next, curr] = carry(res[i]);
-    if (i + 1 == res.size() and next != 0) {  // is last digit
-      res.push_back(next);
-    } else {
-      res[i + 1] += next;
+    // a carry out of the top digit is a new digit, carried in turn until it fits
+    for (std::size_t i = 0; i < res.size(); ++i) {
+      auto&& [next, curr] = carry(res[i]);
+      if (i + 1 < res.size()) {
+        res[i + 1] += next;
+      } else if (next != 0) {
+        res.push_back(next);
+      }
+
+      res[i] = curr;
     }
 
-    res[i] = curr;
+    reverse(res);
+    return res | transform(to_snafu) | to<std::string>;
   }
+};
 
-  reverse(res);
-  fmt::println("{}", res | transform(to_snafu) | to<std::string>);
-}
-
-int main(int /**/, char** /**/) {
-  part1();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2022, 25, Day25);
@@ -1,75 +1,54 @@
-#include <charconv>
-#include <fmt/format.h>
-#include <fstream>
+#include "mapped_input.hpp"
+#include "registry.hpp"
+#include "string_util.hpp"
+
+#include <array>
 #include <range/v3/algorithm/count_if.hpp>
-#include <range/v3/view/getlines.hpp>
-#include <ranges>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/transform.hpp>
+#include <string_view>
 #include <vector>
 
-auto const to_ids = [](auto&& t_sections) {
-  using std::views::split, std::views::transform, std::views::common;
+namespace {
 
-  std::vector<int> ret_val;
-  ret_val.reserve(4);  // hard code 4 because every assignment always contain 4 integers
+// every assignment is "a-b,c-d", the '-' are separators, not signs
+auto const to_ids = [](std::string_view const t_sections) { return scan_n<4>(t_sections); };
 
-  for (auto&& sections : t_sections | split(',')) {
-    auto tf_view = sections      //
-                   | split('-')  //
-                   | transform([](auto&& t_sec) {
-                       int section = 0;
-                       std::from_chars(&*t_sec.begin(), &*t_sec.end(), section);
+struct Day4 {
+  using Parsed = std::vector<std::array<int, 4>>;
 
-                       return section;
-                     })  //
-                   | common;
-    ret_val.insert(ret_val.end(), tf_view.begin(), tf_view.end());
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    using ranges::views::transform, ranges::to_vector;
+    return t_in | transform(to_ids) | to_vector;
   }
 
-  return ret_val;
-};
-
-void part1() {
-  using ranges::getlines, ranges::count_if;
+  static auto part1(Parsed const& t_assignments) {
+    using ranges::count_if;
 
-  std::ifstream assignment_list((INPUT_FILE));
-
-  auto amount = count_if(
-    getlines(assignment_list),
-    [](auto&& result) {
+    return count_if(t_assignments, [](auto&& result) {
       auto const first_start = result[0];
       auto const first_end   = result[1];
       auto const sec_start   = result[2];
       auto const sec_end     = result[3];
 
       return (first_start <= sec_start and sec_end <= first_end) or (sec_start <= first_start and first_end <= sec_end);
-    },
-    to_ids);
-
-  fmt::println("fully contain amount: {}", amount);
-}
-
-void part2() {
-  using ranges::getlines, ranges::count_if;
+    });
+  }
 
-  std::ifstream assignment_list((INPUT_FILE));
+  static auto part2(Parsed const& t_assignments) {
+    using ranges::count_if;
 
-  auto amount = count_if(
-    getlines(assignment_list),
-    [](auto&& result) {
+    return count_if(t_assignments, [](auto&& result) {
       auto const first_start = result[0];
       auto const first_end   = result[1];
       auto const sec_start   = result[2];
       auto const sec_end     = result[3];
 
       return first_start <= sec_end and sec_start <= first_end;
-    },
-    to_ids);
+    });
+  }
+};
 
-  fmt::println("overlapped amount: {}", amount);
-}
+}  // namespace
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 4, Day4);
@@ -1,8 +1,9 @@
+#include "registry.hpp"
+#include "string_util.hpp"
+
 #include <array>
-#include <ctre.hpp>
 #include <deque>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/drop_last.hpp>
 #include <range/v3/view/enumerate.hpp>
@@ -12,9 +13,12 @@
 #include <range/v3/view/split.hpp>
 #include <range/v3/view/stride.hpp>
 #include <range/v3/view/transform.hpp>
+#include <string>
 #include <utility>
 #include <vector>
 
+namespace {
+
 auto get_crate_stack(auto&& t_initial_cond) {
   using ranges::views::drop_last, ranges::views::reverse, ranges::views::enumerate, ranges::views::filter,
     ranges::views::stride;
@@ -38,73 +42,71 @@ auto get_crate_stack(auto&& t_initial_cond) {
   return stacks;
 }
 
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::views::split, ranges::views::transform;
-
-  std::ifstream assignment_list((INPUT_FILE));
+struct Move {
+  std::size_t quantity_;
+  std::size_t from_;
+  std::size_t to_;
+};
 
-  auto lines = getlines(assignment_list) | to_vector;
-  auto rng   = lines | split("");
+struct Day5 {
+  struct Parsed {
+    std::vector<std::deque<char>> stacks_;
+    std::vector<Move> moves_;
+  };
 
-  auto initial_cond = *begin(rng) | to_vector;
-  auto stacks       = get_crate_stack(initial_cond);
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::split;
 
-  auto commands = *next(begin(rng));
-  for (auto cmd : commands) {
-    auto moves = ctre::match<"move ([0-9]+) from ([0-9]+) to ([0-9]+)">(cmd);
+    auto lines = getlines(t_in) | to_vector;
+    auto rng   = lines | split("");
 
-    auto const quantity = std::stoi(moves.get<1>().to_string());
-    auto const from     = std::stoi(moves.get<2>().to_string());
-    auto const to       = std::stoi(moves.get<3>().to_string());
+    auto initial_cond = *begin(rng) | to_vector;
 
-    auto& from_stack = stacks[static_cast<std::size_t>(from - 1)];
-    auto& to_stack   = stacks[static_cast<std::size_t>(to - 1)];
-
-    for (int i = 0; i < quantity; ++i) {
-      to_stack.push_back(from_stack.back());
-      from_stack.pop_back();
+    Parsed ret_val{.stacks_ = get_crate_stack(initial_cond), .moves_ = {}};
+    for (auto cmd : *next(begin(rng))) {
+      auto const [quantity, from, to] = scan_n<3, std::size_t>(cmd);  // "move <quantity> from <from> to <to>"
+      ret_val.moves_.push_back(Move{.quantity_ = quantity, .from_ = from - 1, .to_ = to - 1});
     }
-  }
 
-  auto const top_crates = stacks | transform([](auto&& t_v) { return t_v.back(); }) | ranges::to<std::string>;
-  fmt::println("top crates with CrateMover 9000: {}", top_crates);
-}
+    return ret_val;
+  }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::views::split, ranges::views::transform;
+  static std::string part1(Parsed const& t_crates) {
+    using ranges::views::transform;
 
-  std::ifstream assignment_list((INPUT_FILE));
+    auto stacks = t_crates.stacks_;
+    for (auto const [quantity, from, to] : t_crates.moves_) {
+      auto& from_stack = stacks[from];
+      auto& to_stack   = stacks[to];
 
-  auto lines = getlines(assignment_list) | to_vector;
-  auto rng   = lines | split("");
+      for (std::size_t i = 0; i < quantity; ++i) {
+        to_stack.push_back(from_stack.back());
+        from_stack.pop_back();
+      }
+    }
 
-  auto initial_cond = *begin(rng) | to_vector;
-  auto stacks       = get_crate_stack(initial_cond);
+    return stacks | transform([](auto&& t_v) { return t_v.back(); }) | ranges::to<std::string>;
+  }
 
-  auto commands = *next(begin(rng));
-  for (auto cmd : commands) {
-    auto moves = ctre::match<"move ([0-9]+) from ([0-9]+) to ([0-9]+)">(cmd);
+  static std::string part2(Parsed const& t_crates) {
+    using ranges::views::transform;
 
-    auto const quantity = std::stoi(moves.get<1>().to_string());
-    auto const from     = std::stoi(moves.get<2>().to_string());
-    auto const to       = std::stoi(moves.get<3>().to_string());
+    auto stacks = t_crates.stacks_;
+    for (auto const [quantity, from, to] : t_crates.moves_) {
+      auto& from_stack = stacks[from];
+      auto& to_stack   = stacks[to];
 
-    auto& from_stack = stacks[static_cast<std::size_t>(from - 1)];
-    auto& to_stack   = stacks[static_cast<std::size_t>(to - 1)];
+      auto const begin_idx  = from_stack.size() - quantity;
+      auto from_stack_begin = next(from_stack.begin(), static_cast<std::ptrdiff_t>(begin_idx));
+      auto from_stack_end   = from_stack.end();
+      to_stack.insert(to_stack.end(), from_stack_begin, from_stack_end);
+      from_stack.erase(from_stack_begin, from_stack_end);
+    }
 
-    auto const begin_idx  = from_stack.size() - static_cast<std::size_t>(quantity);
-    auto from_stack_begin = next(from_stack.begin(), static_cast<std::ptrdiff_t>(begin_idx));
-    auto from_stack_end   = from_stack.end();
-    to_stack.insert(to_stack.end(), from_stack_begin, from_stack_end);
-    from_stack.erase(from_stack_begin, from_stack_end);
+    return stacks | transform([](auto&& t_v) { return t_v.back(); }) | ranges::to<std::string>;
   }
+};
 
-  auto const top_crates = stacks | transform([](auto&& t_v) { return t_v.back(); }) | ranges::to<std::string>;
-  fmt::println("top crates with CrateMover 9001: {}", top_crates);
-}
+}  // namespace
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 5, Day5);
@@ -1,47 +1,62 @@
+#include "registry.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
 #include <bit>
-#include <fmt/format.h>
-#include <fstream>
-#include <functional>
-#include <range/v3/algorithm/find_if.hpp>
-#include <range/v3/iterator/operations.hpp>
-#include <range/v3/numeric/accumulate.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
-#include <range/v3/view/sliding.hpp>
-
-void detect_packet(std::string_view sv, std::size_t t_number_of_unique_chr) {
-  using ranges::views::sliding, ranges::find_if, ranges::distance, ranges::accumulate;
-  auto rng = sv | sliding(t_number_of_unique_chr);
-
-  auto start = find_if(rng, [=](auto t_group) {
-    static constexpr auto char_to_bit = [](auto&& t_chr) { return 1UL << static_cast<std::size_t>(t_chr - 'a'); };
-    auto const flag                   = accumulate(t_group, 0UL, std::bit_or<>{}, char_to_bit);
-    return static_cast<std::size_t>(std::popcount(flag)) == t_number_of_unique_chr;
-  });
-
-  fmt::println("packet start: {}", static_cast<std::size_t>(distance(rng.begin(), start)) + t_number_of_unique_chr);
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// The marker ends the first window of t_size distinct characters. A window holds a character twice when it holds a
+// pair t_signal[j] == t_signal[j + distance] with distance < t_size: the simd kernels (see simd.hpp) find the pairs of
+// every distance as bit masks, which are then smeared over the windows that contain them
+std::size_t detect_packet(std::string_view const t_signal, std::size_t const t_size) {
+  auto const words = aoc::simd::mask_words(t_signal.size());
+
+  std::vector<std::uint64_t> pairs(words);
+  std::vector<std::uint64_t> repeating(words);  // bit i is set when the window starting at i holds a character twice
+  for (std::size_t distance = 1; distance < t_size; ++distance) {
+    aoc::simd::equal_at_distance(t_signal, distance, pairs);
+
+    // a pair starting at j is in the windows starting at j - shift
+    for (std::size_t shift = 0; shift + distance < t_size; ++shift) {
+      for (std::size_t word = 0; word < words; ++word) {
+        auto const next = word + 1 < words ? pairs[word + 1] : 0;
+        repeating[word] |= shift == 0 ? pairs[word] : (pairs[word] >> shift) | (next << (64 - shift));
+      }
+    }
+  }
+
+  for (std::size_t word = 0; word < words; ++word) {
+    if (auto const distinct = ~repeating[word]; distinct != 0) {
+      auto const start = word * 64 + static_cast<std::size_t>(std::countr_zero(distinct));
+      return std::min(start + t_size, t_signal.size());  // past the end, there is no marker
+    }
+  }
+
+  return t_signal.size();
 }
 
-void part1() {
-  using ranges::getlines;
+struct Day6 {
+  using Parsed = std::string;
 
-  std::ifstream assignment_list((INPUT_FILE));
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines;
+    return getlines(t_in).cached();
+  }
 
-  auto const& line = getlines(assignment_list).cached();
-  detect_packet(line, 4);
-}
-
-void part2() {
-  using ranges::getlines;
+  static std::size_t part1(Parsed const& t_signal) { return detect_packet(t_signal, 4); }
 
-  std::ifstream assignment_list((INPUT_FILE));
+  static std::size_t part2(Parsed const& t_signal) { return detect_packet(t_signal, 14); }
+};
 
-  auto const& line = getlines(assignment_list).cached();
-  detect_packet(line, 14);
-}
+}  // namespace
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 6, Day6);
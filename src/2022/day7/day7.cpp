@@ -1,9 +1,9 @@
+#include "registry.hpp"
 #include "string_util.hpp"
 
 #include <charconv>
 #include <cstddef>
-#include <fmt/format.h>
-#include <fstream>
+#include <istream>
 #include <limits>
 #include <memory>
 #include <range/v3/algorithm/find_if.hpp>
@@ -12,8 +12,11 @@
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/split_when.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
 struct Node {
   std::string name_ = "/";
   Node* parent_     = nullptr;
@@ -63,8 +66,8 @@ struct FileSystem {
   void parse_ls_output(auto&& t_outputs) {
     auto* cwd = this->current_dir_;
     for (auto&& output : t_outputs) {
-      auto const content = split_string(output);
-      auto& node         = cwd->children_.emplace_back(std::make_unique<Node>(content[1], cwd));
+      auto const content = split_n<2>(output, ' ');  // "dir <name>" or "<size> <name>"
+      auto& node         = cwd->children_.emplace_back(std::make_unique<Node>(std::string{content[1]}, cwd));
       if (content[0] != "dir") {
         std::size_t result = 0;
         std::from_chars(content[0].data(), content[0].data() + content[0].length(), result);
@@ -104,50 +107,45 @@ struct FileSystem {
   }
 };
 
-FileSystem parse_file_system() {
-  using ranges::getlines, ranges::to_vector, ranges::views::split_when, ranges::views::drop, ranges::views::split;
+struct Day7 {
+  // FileSystem refers to its own root node, keep it on the heap so that it never moves
+  using Parsed = std::unique_ptr<FileSystem>;
 
-  std::ifstream command_output((INPUT_FILE));
-  auto rng = getlines(command_output) | to_vector;
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::split_when, ranges::views::drop;
 
-  FileSystem fs;
+    auto rng = getlines(t_in) | to_vector;
 
-  auto const group_cmd_and_result = [](auto&& t_str, auto&& /**/) { return std::pair{t_str->front() == '$', t_str}; };
+    auto fs = std::make_unique<FileSystem>();
 
-  for (auto cmd_and_output : rng | split_when(group_cmd_and_result)) {
-    auto cmd = split_string(*begin(cmd_and_output));
+    auto const group_cmd_and_result = [](auto&& t_str, auto&& /**/) { return std::pair{t_str->front() == '$', t_str}; };
 
-    if (cmd[1] == "cd") {
-      fs.cd(cmd[2]);
-    } else if (cmd[1] == "ls") {
-      fs.parse_ls_output(cmd_and_output | drop(1));
-    }
-  }
+    for (auto cmd_and_output : rng | split_when(group_cmd_and_result)) {
+      auto const cmd = split_n<3>(*begin(cmd_and_output), ' ');  // "$ cd <path>" or "$ ls"
 
-  return fs;
-}
+      if (cmd[1] == "cd") {
+        fs->cd(cmd[2]);
+      } else if (cmd[1] == "ls") {
+        fs->parse_ls_output(cmd_and_output | drop(1));
+      }
+    }
 
-void part1() {
-  auto fs = parse_file_system();
+    return fs;
+  }
 
-  fmt::println("total size: {}", fs.get_dir_size_sum_within_size(100'000));
-}
+  static std::size_t part1(Parsed const& t_fs) { return t_fs->get_dir_size_sum_within_size(100'000); }
 
-void part2() {
-  static constexpr auto TOTAL_DISK_SPACE    = 70'000'000;
-  static constexpr auto UNUSED_SPACE_NEEDED = 30'000'000;
+  static std::size_t part2(Parsed const& t_fs) {
+    static constexpr auto TOTAL_DISK_SPACE    = 70'000'000;
+    static constexpr auto UNUSED_SPACE_NEEDED = 30'000'000;
 
-  auto const fs = parse_file_system();
+    auto const used_disk_space = t_fs->get_used_disk_space();
+    auto const space_needed    = used_disk_space - (TOTAL_DISK_SPACE - UNUSED_SPACE_NEEDED);
 
-  auto const used_disk_space = fs.get_used_disk_space();
-  auto const space_needed    = used_disk_space - (TOTAL_DISK_SPACE - UNUSED_SPACE_NEEDED);
+    return t_fs->size_ceil(space_needed);
+  }
+};
 
-  fmt::println("space needed: {}", space_needed);
-  fmt::println("size of dir to delete: {}", fs.size_ceil(space_needed));
-}
+}  // namespace
 
-int main(int /*unused*/, char** /*unused*/) {
-  part1();
-  part2();
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 7, Day7);
@@ -1,55 +1,48 @@
-#include <fmt/format.h>
-#include <fmt/ranges.h>
-#include <fstream>
+#include "grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
+#include "thread_pool.hpp"
+
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <range/v3/algorithm/count_if.hpp>
 #include <range/v3/algorithm/max.hpp>
 #include <range/v3/iterator/operations.hpp>
-#include <range/v3/range/conversion.hpp>
 #include <range/v3/view.hpp>
 #include <range/v3/view/any_view.hpp>
-#include <span>
 #include <stack>
-#include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-template <>
-struct std::hash<std::pair<std::size_t, std::size_t>> {
-  std::size_t operator()(std::pair<std::size_t, std::size_t> const& t_pair) const noexcept {
-    std::size_t h1 = std::hash<std::size_t>{}(t_pair.first);
-    std::size_t h2 = std::hash<std::size_t>{}(t_pair.second);
-    return h1 ^ (h2 << 1U);
-  }
-};
+namespace {
 
 struct VisibilityChecker {
   using LineView               = ranges::any_view<std::pair<std::size_t, std::size_t>>;
-  using HeightMap              = std::vector<std::vector<std::size_t>>;
+  using HeightMap              = aoc::Grid2D<std::size_t>;
   using SceneryCalculationAlgo = void (VisibilityChecker::*)(LineView, HeightMap&) const;
-  using VisibleSet             = std::unordered_set<std::pair<std::size_t, std::size_t>>;
+  using VisibleMap             = aoc::Grid2D<char>;  // not bool, the threads mark their own trees
 
-  auto count_visible_tree(auto t_eyesight, VisibleSet& t_visible_trees) const {
+  auto count_visible_tree(auto t_eyesight, VisibleMap& t_visible_trees) const {
     using ranges::count_if, ranges::views::drop_last;
 
     auto max_height = [&]() {
       auto&& [x, y] = *ranges::begin(t_eyesight);
-      return this->view_[y][x];
+      return this->view_[x, y];
     }();
 
     auto const res = count_if(t_eyesight | drop_last(1), [&](auto&& t_pair) {
       auto const [x, y] = t_pair;
-      if (max_height >= this->view_[y][x]) {
+      if (max_height >= this->view_[x, y]) {
         return false;
       }
 
-      max_height = this->view_[y][x];
-      if (t_visible_trees.contains(std::pair{x, y})) {
+      max_height = this->view_[x, y];
+      if (t_visible_trees[x, y] != 0) {
         return false;
       }
 
-      t_visible_trees.emplace(x, y);
+      t_visible_trees[x, y] = 1;
       return true;
     });
 
@@ -65,9 +58,9 @@ struct VisibilityChecker {
 
     for (auto const [idx, coor] : t_eyesight | enumerate) {
       auto const [x, y]               = coor;
-      auto const height               = static_cast<std::size_t>(this->view_[y][x] - '0');
+      auto const height               = static_cast<std::size_t>(this->view_[x, y] - '0');
       auto const cannot_reach_to_edge = static_cast<std::size_t>(viewable_height_count[height] != idx);
-      t_height_map[y][x] *= (viewable_height_count[height] + cannot_reach_to_edge);
+      t_height_map[x, y] *= (viewable_height_count[height] + cannot_reach_to_edge);
 
       for (std::size_t i = 0; i < TREE_HEIGHT_COUNT; ++i) {
         if (i > height) {
@@ -90,17 +83,17 @@ struct VisibilityChecker {
     std::stack<Coor> monotonic;
     for (auto&& [idx, coor] : enumerate(t_eyesight)) {
       auto const [x, y]         = coor;
-      auto const current_height = this->view_[y][x];
+      auto const current_height = this->view_[x, y];
 
       while (not monotonic.empty()) {
         auto const [top_idx, top_coor] = monotonic.top();
         auto const [top_x, top_y]      = top_coor;
-        if (this->view_[top_y][top_x] > current_height) {
+        if (this->view_[top_x, top_y] > current_height) {
           break;
         }
 
         monotonic.pop();
-        t_height_map[top_y][top_x] *= (idx - top_idx);
+        t_height_map[top_x, top_y] *= (idx - top_idx);
       }
 
       monotonic.push(Coor{.idx_ = static_cast<std::size_t>(idx), .coor_ = coor});
@@ -109,85 +102,78 @@ struct VisibilityChecker {
     while (not monotonic.empty()) {  // those that are still on the stack are not blocked in this eyesight
       auto const [idx, coor] = monotonic.top();
       auto const [x, y]      = coor;
-      t_height_map[y][x] *= (static_cast<std::size_t>(distance(t_eyesight)) - (idx + 1));
+      t_height_map[x, y] *= (static_cast<std::size_t>(distance(t_eyesight)) - (idx + 1));
       monotonic.pop();
     }
   }
 
-  std::span<std::string const> view_;
+  aoc::Grid2D<char> const& view_;
 
-  explicit VisibilityChecker(std::vector<std::string> const& t_map) : view_(t_map) {}
+  explicit VisibilityChecker(aoc::Grid2D<char> const& t_map) : view_(t_map) {}
 
+  // A row only touches the trees of its own row, and a column those of its own column: the rows are scanned in
+  // parallel, then the columns. Which trees end up marked doesn't depend on the order of the scans
   [[nodiscard]] auto get_visible_tree_count() const {
-    VisibleSet visible_tree;
-    std::size_t ret_val = 0;
+    using ranges::views::zip, ranges::views::repeat, ranges::views::indices, ranges::views::reverse;
 
-    for (std::size_t i = 1; i + 1 < this->view_.size(); ++i) {
-      using ranges::views::zip, ranges::views::repeat, ranges::views::indices, ranges::views::reverse;
+    VisibleMap visible_tree{this->view_.width(), this->view_.height(), char{0}};
 
-      auto row_idx_view = zip(indices(this->view_[i].size()), repeat(i));
-      auto col_idx_view = zip(repeat(i), indices(this->view_.size()));
-
-      ret_val += this->count_visible_tree(row_idx_view, visible_tree);
-      ret_val += this->count_visible_tree(row_idx_view | reverse, visible_tree);
+    // the edges are counted by the scans across them
+    auto const inner_rows = indices(1UL, this->view_.height() - 1);
+    auto const inner_cols = indices(1UL, this->view_.width() - 1);
+    auto const rows       = aoc::parallel_reduce(inner_rows, 0UL, std::plus<>{}, [&](std::size_t const t_i) {
+      auto row_idx_view = zip(indices(this->view_.width()), repeat(t_i));
+      return this->count_visible_tree(row_idx_view, visible_tree) +
+             this->count_visible_tree(row_idx_view | reverse, visible_tree);
+    });
 
-      ret_val += this->count_visible_tree(col_idx_view, visible_tree);
-      ret_val += this->count_visible_tree(col_idx_view | reverse, visible_tree);
-    }
+    auto const cols = aoc::parallel_reduce(inner_cols, 0UL, std::plus<>{}, [&](std::size_t const t_i) {
+      auto col_idx_view = zip(repeat(t_i), indices(this->view_.height()));
+      return this->count_visible_tree(col_idx_view, visible_tree) +
+             this->count_visible_tree(col_idx_view | reverse, visible_tree);
+    });
 
-    return ret_val + 4;
+    return rows + cols + 4;
   }
 
+  // same as above, the rows in parallel then the columns
   [[nodiscard]] auto get_highest_scenery_value(SceneryCalculationAlgo t_ptr) const {
-    using ranges::max, ranges::views::join;
-
-    std::vector height_map(this->view_.size(), std::vector(this->view_[0].size(), 1UL));
+    using ranges::max, ranges::views::zip, ranges::views::repeat, ranges::views::indices, ranges::views::reverse;
 
-    for (std::size_t i = 0; i + 1 < this->view_.size(); ++i) {
-      using ranges::views::zip, ranges::views::repeat, ranges::views::indices, ranges::views::reverse;
-
-      auto row_idx_view = zip(indices(this->view_[i].size()), repeat(i));
-      auto col_idx_view = zip(repeat(i), indices(this->view_.size()));
+    HeightMap height_map{this->view_.width(), this->view_.height(), 1UL};
 
+    aoc::parallel_for(indices(this->view_.height() - 1), [&](std::size_t const t_i) {
+      auto row_idx_view = zip(indices(this->view_.width()), repeat(t_i));
       (this->*t_ptr)(row_idx_view, height_map);
       (this->*t_ptr)(row_idx_view | reverse, height_map);
+    });
+
+    aoc::parallel_for(indices(this->view_.width() - 1), [&](std::size_t const t_i) {
+      auto col_idx_view = zip(repeat(t_i), indices(this->view_.height()));
       (this->*t_ptr)(col_idx_view, height_map);
       (this->*t_ptr)(col_idx_view | reverse, height_map);
-    }
+    });
 
-    return max(height_map | join);
+    return max(height_map.cells());
   }
 };
 
-void part1() {
-  using ranges::getlines, ranges::to_vector;
-
-  std::fstream map((INPUT_FILE));
-
-  auto const map_str = getlines(map) | to_vector;
-  auto const checker = VisibilityChecker{map_str};
+struct Day8 {
+  using Parsed = aoc::Grid2D<char>;
 
-  fmt::println("visible tree count: {}", checker.get_visible_tree_count());
-}
+  static Parsed parse(aoc::MappedInput const& t_in) { return aoc::Grid2D<char>::from_lines(t_in.lines()); }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector;
+  static std::size_t part1(Parsed const& t_map) { return VisibilityChecker{t_map}.get_visible_tree_count(); }
 
-  std::fstream map((INPUT_FILE));
-
-  auto const map_str = getlines(map) | to_vector;
-  auto const checker = VisibilityChecker{map_str};
-
-  fmt::println("highest scenic score by count_viewable_height: {}",
-               checker.get_highest_scenery_value(&VisibilityChecker::count_viewable_height));
+  static std::size_t part2(Parsed const& t_map) {
+    return VisibilityChecker{t_map}.get_highest_scenery_value(&VisibilityChecker::count_viewable_height);
+  }
 
-  fmt::println("highest scenic score by next_greater_element: {}",
-               checker.get_highest_scenery_value(&VisibilityChecker::next_greater_element));
-}
+  static std::size_t part2_next_greater_element(Parsed const& t_map) {
+    return VisibilityChecker{t_map}.get_highest_scenery_value(&VisibilityChecker::next_greater_element);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 8, Day8, aoc::part<&Day8::part2_next_greater_element>("2_next_greater"));
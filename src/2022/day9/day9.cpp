@@ -1,4 +1,6 @@
+#include "flat_hash.hpp"
 #include "pairview.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
 
 #include <array>
@@ -6,21 +8,21 @@
 #include <cstdlib>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
-#include <fstream>
 #include <functional>
+#include <istream>
 #include <range/v3/action/action.hpp>
-#include <range/v3/action/insert.hpp>
 #include <range/v3/algorithm/minmax.hpp>
 #include <range/v3/functional/bind_back.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/join.hpp>
-#include <range/v3/view/take_last.hpp>
-#include <set>
+#include <range/v3/view/transform.hpp>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+namespace {
+
 using Coor = std::pair<int, int>;
 
 template <std::size_t KnotNum>
@@ -49,8 +51,6 @@ void print_knot(std::array<std::vector<Coor>, KnotNum> const& t_footprint) {
   }
 }
 
-namespace {
-
 template <typename T>
 concept structure_bindable_pair = requires(T t_v) {
   std::get<0>(t_v);
@@ -112,8 +112,6 @@ struct RopeMoverFn {
 
 inline constexpr RopeMoverFn move_rope{};
 
-}  // namespace
-
 void move(char const t_dir, auto&& t_ropes) {
   using ranges::for_each;
 
@@ -157,61 +155,51 @@ void move(char const t_dir, auto&& t_ropes) {
   }
 }
 
-void part1() {
-  using ranges::getlines;
+struct Day9 {
+  using Parsed = std::vector<std::pair<char, int>>;
 
-  std::ifstream in((INPUT_FILE));
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::views::transform, ranges::to_vector;
 
-  auto rng = getlines(in);
+    return getlines(t_in) | transform([](auto&& t_instruction) {
+             auto const [direction, amount_str] = split_n<2>(t_instruction, ' ');
 
-  std::array<Coor, 2> rope;
-  std::set<Coor> visited;
-  visited.emplace(0, 0);
-
-  for (auto&& instruction : rng) {
-    auto const cmd       = split_string(instruction);
-    auto const direction = cmd[0][0];
-    auto const amount    = std::stoi(cmd[1]);
-
-    for (int i = 0; i < amount; ++i) {
-      ranges::actions::insert(visited, (rope |= ::move_rope(direction)) | ranges::views::take_last(1));
-    }
+             int amount = 0;
+             ranges_from_chars(amount_str, amount);
+             return std::pair{direction[0], amount};
+           }) |
+           to_vector;
   }
 
-  fmt::println("position visited: {}", visited.size());
-}
-
-void part2() {
-  using ranges::getlines;
+  static std::size_t part1(Parsed const& t_instructions) {
+    std::array<Coor, 2> rope;
+    aoc::FlatHashSet<Coor> visited;
+    visited.emplace(0, 0);
 
-  std::ifstream in((INPUT_FILE));
-
-  auto rng = getlines(in);
+    for (auto const& [direction, amount] : t_instructions) {
+      for (int i = 0; i < amount; ++i) {
+        visited.insert((rope |= ::move_rope(direction)).back());
+      }
+    }
 
-  std::array<Coor, 10> rope;
-  std::array<std::vector<Coor>, 10> footprint;
-  std::set<Coor> visited;
-  visited.emplace(0, 0);
+    return visited.size();
+  }
 
-  for (auto&& instruction : rng) {
-    auto const cmd       = split_string(instruction);
-    auto const direction = cmd[0][0];
-    auto const amount    = std::stoi(cmd[1]);
+  static std::size_t part2(Parsed const& t_instructions) {
+    std::array<Coor, 10> rope;
+    aoc::FlatHashSet<Coor> visited;
+    visited.emplace(0, 0);
 
-    for (int i = 0; i < amount; ++i) {
-      ranges::actions::insert(visited, (rope |= ::move_rope(direction)) | ranges::views::take_last(1));
-      // for (std::size_t j = 0; j < rope.size(); ++j) {
-      //   footprint[j].push_back(rope[j]);
-      // }
+    for (auto const& [direction, amount] : t_instructions) {
+      for (int i = 0; i < amount; ++i) {
+        visited.insert((rope |= ::move_rope(direction)).back());
+      }
     }
-  }
 
-  fmt::println("position visited: {}", visited.size());
-}
+    return visited.size();
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER(2022, 9, Day9);
@@ -1,35 +1,23 @@
+#include "registry.hpp"
+#include "thread_pool.hpp"
+
 #include <algorithm>
 #include <array>
 #include <cctype>
-#include <fmt/format.h>
-#include <fstream>
+#include <functional>
+#include <istream>
 #include <numeric>
 #include <range/v3/algorithm/transform.hpp>
-#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/cache1.hpp>
 #include <range/v3/view/getlines.hpp>
 #include <range/v3/view/indices.hpp>
-#include <range/v3/view/transform.hpp>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
 
-void part1() {
-  using ranges::getlines;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
-
-  // assume there must be a number in the string
-  constexpr auto isdigit_pred   = [](auto const& t_chr) { return std::isdigit(t_chr); };
-  constexpr auto extract_number = [=](auto&& t_str) {
-    auto const first_num  = static_cast<int>(*std::ranges::find_if(t_str, isdigit_pred) - '0');
-    auto const second_num = static_cast<int>(*std::ranges::find_if(t_str | std::views::reverse, isdigit_pred) - '0');
-
-    return first_num * 10 + second_num;
-  };
-
-  fmt::println("Sum of the callibration value: {}",
-               ranges::accumulate(rng | ranges::views::transform(extract_number), 0));
-}
+namespace {
 
 using namespace std::string_view_literals;
 
@@ -66,55 +54,68 @@ struct WordNumber {
   }
 };
 
-void part2() {
-  using ranges::getlines;
+struct Day1 {
+  using Parsed = std::vector<std::string>;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector;
+    return getlines(t_in) | to_vector;
+  }
 
-  constexpr auto create_word_numbers = []() {
-    std::array<WordNumber, 9> ret_val;
-    ranges::transform(ranges::views::closed_indices(1UL, 9UL), ret_val.begin(),
-                      [](auto t_v) { return WordNumber(t_v); });
+  static int part1(Parsed const& t_document) {
+    // assume there must be a number in the string
+    constexpr auto isdigit_pred   = [](auto const& t_chr) { return std::isdigit(t_chr); };
+    constexpr auto extract_number = [=](auto&& t_str) {
+      auto const first_num  = static_cast<int>(*std::ranges::find_if(t_str, isdigit_pred) - '0');
+      auto const second_num = static_cast<int>(*std::ranges::find_if(t_str | std::views::reverse, isdigit_pred) - '0');
 
-    return ret_val;
-  };
+      return first_num * 10 + second_num;
+    };
 
-  auto extract_number = [=](auto&& t_str) {
-    auto words = create_word_numbers();
+    return aoc::parallel_reduce(t_document, 0, std::plus<>{}, extract_number);
+  }
 
-    int first_num = -1;
-    int last_num  = -1;
-    for (auto const chr : t_str) {
-      if (std::isdigit(chr) != 0) {
-        if (first_num == -1) {
-          first_num = static_cast<int>(chr - '0');
-        }
+  static int part2(Parsed const& t_document) {
+    constexpr auto create_word_numbers = []() {
+      std::array<WordNumber, 9> ret_val;
+      ranges::transform(ranges::views::closed_indices(1UL, 9UL), ret_val.begin(),
+                        [](auto t_v) { return WordNumber(t_v); });
 
-        last_num = static_cast<int>(chr - '0');
-      }
+      return ret_val;
+    };
+
+    auto extract_number = [=](auto&& t_str) {
+      auto words = create_word_numbers();
 
-      for (auto& word : words) {
-        if (word.check_character(chr)) {
+      int first_num = -1;
+      int last_num  = -1;
+      for (auto const chr : t_str) {
+        if (std::isdigit(chr) != 0) {
           if (first_num == -1) {
-            first_num = static_cast<int>(word.number_);
+            first_num = static_cast<int>(chr - '0');
           }
 
-          last_num = static_cast<int>(word.number_);
+          last_num = static_cast<int>(chr - '0');
+        }
+
+        for (auto& word : words) {
+          if (word.check_character(chr)) {
+            if (first_num == -1) {
+              first_num = static_cast<int>(word.number_);
+            }
+
+            last_num = static_cast<int>(word.number_);
+          }
         }
       }
-    }
 
-    return first_num * 10 + last_num;
-  };
+      return first_num * 10 + last_num;
+    };
 
-  fmt::println("Sum of the callibration value: {}",
-               ranges::accumulate(rng | ranges::views::transform(extract_number), 0));
-}
+    return aoc::parallel_reduce(t_document, 0, std::plus<>{}, extract_number);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2023, 1, Day1);
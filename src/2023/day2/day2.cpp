@@ -1,107 +1,94 @@
+#include "registry.hpp"
 #include "string_util.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
 #include <array>
-#include <fmt/format.h>
-#include <fmt/ranges.h>
-#include <fstream>
+#include <cstddef>
+#include <functional>
+#include <istream>
 #include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/view/enumerate.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
-#include <range/v3/view/transform.hpp>
-#include <range/v3/view/trim.hpp>
+#include <range/v3/view/indices.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
 
 using namespace std::string_view_literals;
 
-void part1() {
-  using ranges::getlines, ranges::views::transform, ranges::accumulate, ranges::views::enumerate, ranges::views::trim;
+struct Game {
+  int id_;
+  std::array<int, 3> max_cubes_;  // RED, GREEN, BLUE
+};
+
+// e.g. "Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green"
+Game to_game(std::string_view const t_str) {
+  auto const [game, sets] = split_n<2>(t_str, ": ");
+
+  Game ret_val{.id_ = 0, .max_cubes_ = {0, 0, 0}};
+  ranges_from_chars(game.substr(std::size("Game "sv)), ret_val.id_);
+
+  for (auto const set : tokenize(sets, "; ")) {
+    for (auto const ball : tokenize(set, ", ")) {
+      int quantity         = 0;
+      auto const [rest, _] = ranges_from_chars(ball, quantity);
+      auto const idx       = [=]() {
+        switch (rest[1]) {
+          case 'r':
+            return 0UL;
+          case 'g':
+            return 1UL;
+          case 'b':
+            return 2UL;
+        }
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+        std::unreachable();
+      }();
 
-  static constexpr auto CUBES_COUNT = std::array{12, 13, 14};  // RED, GREEN, BLUE
+      ret_val.max_cubes_[idx] = std::max(ret_val.max_cubes_[idx], quantity);
+    }
+  }
 
-  constexpr auto get_cubes_grabbed = [](auto const& t_str) {
-    auto const game = split_string(t_str, ':');
-    auto const sets = split_string(game[1], ';');
+  return ret_val;
+}
 
-    for (auto const& set : sets | transform([](auto const& t_str) { return split_string(t_str, ','); })) {
-      for (auto const& ball : set) {
-        int quantity           = 0;
-        auto trimmed           = ball | trim([](auto&& t_str) { return std::isspace(t_str); });
-        auto const [rest, err] = ranges_from_chars(trimmed, quantity);
-        if (err != std::errc() or rest.empty()) {
-          return 0;
-        }
+struct Day2 {
+  using Parsed = std::vector<Game>;
 
-        auto const idx = [=]() {
-          switch (rest[1]) {
-            case 'r':
-              return 0UL;
-            case 'g':
-              return 1UL;
-            case 'b':
-              return 2UL;
-          }
-
-          std::unreachable();
-        }();
-
-        if (quantity > CUBES_COUNT[idx]) {
-          return 0;
-        }
-      }
-    }
+  // the lines are read first, then parsed in parallel
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::indices;
+
+    auto const lines = getlines(t_in) | to_vector;
 
-    int ret_val = 0;
-    ranges_from_chars(std::string_view(game[0]).substr(std::size("Game "sv)), ret_val);
+    Parsed ret_val(lines.size());
+    aoc::parallel_for(indices(lines.size()), [&](std::size_t const t_idx) { ret_val[t_idx] = to_game(lines[t_idx]); });
     return ret_val;
-  };
+  }
 
-  fmt::println("id sum: {}", accumulate(rng | transform(get_cubes_grabbed), 0));
-}
+  static int part1(Parsed const& t_games) {
+    using ranges::accumulate;
 
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::accumulate, ranges::views::enumerate, ranges::views::trim;
-
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
-
-  constexpr auto get_cubes_power = [](auto const& t_str) {
-    auto const game = split_string(t_str, ':');
-    auto const sets = split_string(game[1], ';');
-
-    std::array<int, 3> result{0, 0, 0};
-
-    for (auto const& set : sets | transform([](auto const& t_str) { return split_string(t_str, ','); })) {
-      for (auto const& ball : set) {
-        int quantity         = 0;
-        auto trimmed         = ball | trim([](auto&& t_str) { return std::isspace(t_str); });
-        auto const [rest, _] = ranges_from_chars(trimmed, quantity);
-        auto const idx       = [=]() {
-          switch (rest[1]) {
-            case 'r':
-              return 0UL;
-            case 'g':
-              return 1UL;
-            case 'b':
-              return 2UL;
-          }
-
-          std::unreachable();
-        }();
-
-        result[idx] = std::max(result[idx], quantity);
-      }
-    }
+    static constexpr auto CUBES_COUNT = std::array{12, 13, 14};  // RED, GREEN, BLUE
 
-    return accumulate(result, 1, std::multiplies<>{});
-  };
+    return accumulate(t_games, 0, std::plus<>{}, [](auto const& t_game) {
+      auto const possible = t_game.max_cubes_[0] <= CUBES_COUNT[0] and t_game.max_cubes_[1] <= CUBES_COUNT[1] and
+                            t_game.max_cubes_[2] <= CUBES_COUNT[2];
+      return possible ? t_game.id_ : 0;
+    });
+  }
 
-  fmt::println("power sum: {}", accumulate(rng | transform(get_cubes_power), 0));
-}
+  static int part2(Parsed const& t_games) {
+    using ranges::accumulate;
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+    return accumulate(t_games, 0, std::plus<>{},
+                      [](auto const& t_game) { return accumulate(t_game.max_cubes_, 1, std::multiplies<>{}); });
+  }
+};
 
-  return EXIT_SUCCESS;
-}
+}  // namespace
+
+AOC_REGISTER(2023, 2, Day2);
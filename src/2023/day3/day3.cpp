@@ -1,36 +1,43 @@
+#include "flat_hash.hpp"
+#include "grid.hpp"
+#include "mapped_input.hpp"
+#include "registry.hpp"
 #include "string_util.hpp"
-#include <fmt/format.h>
-#include <fstream>
-#include <map>
+#include "thread_pool.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <functional>
 #include <range/v3/algorithm/find_if.hpp>
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/cartesian_product.hpp>
 #include <range/v3/view/filter.hpp>
-#include <range/v3/view/getlines.hpp>
 #include <range/v3/view/indices.hpp>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
 
+// the schematic is bordered by '.', the neighbours of a number can be looked at without checking the bounds
 struct Schemtaic {
-  std::vector<std::string> schematic_;
+  aoc::Grid2D<char> schematic_;
 
-  [[nodiscard]] int size() const noexcept { return static_cast<int>(this->schematic_.size()); }
+  [[nodiscard]] int size() const noexcept { return static_cast<int>(this->schematic_.height()); }
+  [[nodiscard]] int width() const noexcept { return static_cast<int>(this->schematic_.width()); }
 
   [[nodiscard]] std::string_view operator[](int t_y) const noexcept {
-    return this->schematic_[static_cast<std::size_t>(t_y)];
+    auto const row = this->schematic_.row(static_cast<std::size_t>(t_y));
+    return std::string_view{row.data(), row.size()};
   }
 
-  [[nodiscard]] std::optional<char> operator[](int t_x, int t_y) const noexcept {
-    int const size          = static_cast<int>(this->schematic_.size());
-    bool const out_of_bound = t_x < 0 or t_x >= size or t_y < 0 or t_y >= size;
-    if (out_of_bound) {
-      return std::nullopt;
-    }
-
-    return this->schematic_[static_cast<std::size_t>(t_y)][static_cast<std::size_t>(t_x)];
-  }
+  [[nodiscard]] char operator[](int t_x, int t_y) const noexcept { return this->schematic_[t_x, t_y]; }
 };
 
+// the coordinates of a '*' and the numbers next to it
+using GearMap = aoc::FlatHashMap<std::pair<int, int>, std::vector<int>>;
+
 std::pair<int, int> parse_part_num(Schemtaic const& t_schematic, int const t_curr_x, int const t_curr_y) {
   using ranges::views::closed_indices, ranges::views::cartesian_product, ranges::find_if;
 
@@ -44,7 +51,7 @@ std::pair<int, int> parse_part_num(Schemtaic const& t_schematic, int const t_cur
   auto const res   = find_if(cross, [&](auto const t_coor) {
     auto const [x, y] = t_coor;
     auto const v      = t_schematic[x, y];
-    return v and *v != '.' and std::isdigit(*v) == 0;
+    return v != '.' and std::isdigit(v) == 0;
   });
 
   if (res != cross.end()) {
@@ -54,32 +61,7 @@ std::pair<int, int> parse_part_num(Schemtaic const& t_schematic, int const t_cur
   return std::pair{0, 0};
 }
 
-void part1() {
-  using ranges::getlines, ranges::to_vector, ranges::views::cartesian_product, ranges::views::indices,
-    ranges::views::transform, ranges::accumulate;
-
-  std::fstream in((INPUT_FILE));
-  auto const rng = Schemtaic{.schematic_ = getlines(in) | to_vector};
-
-  int const sum = accumulate(cartesian_product(indices(rng.size()), indices(rng.size())) |
-                               transform([&, to_skip = 0](auto const t_coor) mutable {
-                                 auto const [y, x] = t_coor;
-                                 if (std::isdigit(*rng[x, y]) == 0 or --to_skip > 0) {
-                                   return 0;
-                                 }
-
-                                 auto const [num, size] = parse_part_num(rng, x, y);
-
-                                 to_skip = size;
-                                 return num;
-                               }),
-                             0);
-
-  fmt::println("Total sum: {}", sum);
-}
-
-int parse_gear(std::map<std::pair<int, int>, std::vector<int>>& t_map, Schemtaic const& t_schematic, int const t_curr_x,
-               int const t_curr_y) {
+int parse_gear(GearMap& t_map, Schemtaic const& t_schematic, int const t_curr_x, int const t_curr_y) {
   using ranges::views::closed_indices, ranges::views::cartesian_product, ranges::for_each;
 
   int ret_val             = 0;
@@ -91,7 +73,7 @@ int parse_gear(std::map<std::pair<int, int>, std::vector<int>>& t_map, Schemtaic
                                        closed_indices(t_curr_y - 1, t_curr_y + 1));
   for_each(cross, [&](auto const t_coor) {
     auto const [x, y] = t_coor;
-    if (auto const v = t_schematic[x, y]; v and *v == '*') {
+    if (t_schematic[x, y] == '*') {
       t_map[std::make_pair(x, y)].push_back(ret_val);
     }
   });
@@ -99,32 +81,66 @@ int parse_gear(std::map<std::pair<int, int>, std::vector<int>>& t_map, Schemtaic
   return static_cast<int>(digits);
 }
 
-void part2() {
-  using ranges::getlines, ranges::to_vector, ranges::views::cartesian_product, ranges::views::indices,
-    ranges::views::transform, ranges::accumulate, ranges::for_each, ranges::views::filter;
+struct Day3 {
+  using Parsed = Schemtaic;
 
-  std::fstream in((INPUT_FILE));
-  auto const rng = Schemtaic{.schematic_ = getlines(in) | to_vector};
+  static Parsed parse(aoc::MappedInput const& t_in) {
+    return Schemtaic{.schematic_ = aoc::Grid2D<char>::from_lines(t_in.lines(), 1, '.')};
+  }
 
-  std::map<std::pair<int, int>, std::vector<int>> map;
-  for_each(cartesian_product(indices(rng.size()), indices(rng.size())), [&, to_skip = 0](auto const t_coor) mutable {
-    auto const [y, x] = t_coor;
-    if (std::isdigit(*rng[x, y]) == 0 or --to_skip > 0) {
-      return;
-    }
+  // a number never spans two rows, the rows are scanned in parallel
+  static int part1(Parsed const& t_schematic) {
+    using ranges::views::indices;
 
-    // map store coordinate of '*', and the number around it
-    to_skip = parse_gear(map, rng, x, y);
-  });
+    return aoc::parallel_reduce(indices(t_schematic.size()), 0, std::plus<>{}, [&](int const t_y) {
+      int sum = 0;
+      for (int x = 0, to_skip = 0; x < t_schematic.width(); ++x) {
+        if (std::isdigit(t_schematic[x, t_y]) == 0 or --to_skip > 0) {
+          continue;
+        }
 
-  fmt::println("Total sum: {}",
-               accumulate(map | filter([](auto&& t_kv) { return t_kv.second.size() == 2; }), 0, ranges::plus{},
-                          [](auto&& t_kv) { return t_kv.second[0] * t_kv.second[1]; }));
-}
+        auto const [num, size] = parse_part_num(t_schematic, x, t_y);
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+        to_skip = size;
+        sum += num;
+      }
 
-  return EXIT_SUCCESS;
-}
+      return sum;
+    });
+  }
+
+  static int part2(Parsed const& t_schematic) {
+    using ranges::views::indices, ranges::accumulate, ranges::views::filter;
+
+    // every row collects the gears around its numbers, the maps of the rows are merged afterward
+    auto const merge = [](GearMap t_lhs, GearMap t_rhs) {
+      for (auto& [coor, numbers] : t_rhs) {
+        auto& merged = t_lhs[coor];
+        merged.insert(merged.end(), numbers.begin(), numbers.end());
+      }
+
+      return t_lhs;
+    };
+
+    auto const map = aoc::parallel_reduce(indices(t_schematic.size()), GearMap{}, merge, [&](int const t_y) {
+      GearMap row_map;
+      for (int x = 0, to_skip = 0; x < t_schematic.width(); ++x) {
+        if (std::isdigit(t_schematic[x, t_y]) == 0 or --to_skip > 0) {
+          continue;
+        }
+
+        // map store coordinate of '*', and the number around it
+        to_skip = parse_gear(row_map, t_schematic, x, t_y);
+      }
+
+      return row_map;
+    });
+
+    return accumulate(map | filter([](auto&& t_kv) { return t_kv.second.size() == 2; }), 0, ranges::plus{},
+                      [](auto&& t_kv) { return t_kv.second[0] * t_kv.second[1]; });
+  }
+};
+
+}  // namespace
+
+AOC_REGISTER(2023, 3, Day3);
@@ -1,23 +1,31 @@
+#include "registry.hpp"
 #include "string_util.hpp"
-#include <fmt/format.h>
-#include <fstream>
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <istream>
 #include <range/v3/algorithm/count_if.hpp>
 #include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/getlines.hpp>
+#include <range/v3/view/indices.hpp>
+#include <range/v3/view/transform.hpp>
 #include <set>
+#include <string_view>
+#include <vector>
+
+namespace {
 
 auto get_matching_number(std::string_view t_str) {
-  using ranges::views::transform, ranges::to, ranges::count_if, ranges::views::split, ranges::distance,
-    ranges::views::filter;
+  using ranges::views::transform, ranges::to, ranges::count_if, ranges::views::filter;
 
   auto const delim           = t_str.find('|');
   auto const start           = t_str.find(':');
   auto const winning_str     = t_str.substr(start + 1, delim - 1 - start);
   auto const numbers_i_have  = t_str.substr(delim + 1);
-  auto const splitted        = split_string(winning_str);
-  auto const winning_numbers = splitted | filter([](auto const t_str) { return not t_str.empty(); }) |
+  auto const winning_numbers = tokenize(winning_str) | filter([](auto const t_str) { return not t_str.empty(); }) |
                                transform([](auto const t_str) {
                                  int ret_val = 0;
                                  ranges_from_chars(t_str, ret_val);
@@ -25,50 +33,53 @@ auto get_matching_number(std::string_view t_str) {
                                }) |
                                to<std::set>;
 
-  auto matching_num = count_if(numbers_i_have | split(' '), [&](auto const t_view) {
+  auto matching_num = count_if(tokenize(numbers_i_have), [&](std::string_view const t_view) {
     int ret_val = 0;
-    std::string_view view{&*t_view.begin(), static_cast<std::size_t>(distance(t_view))};
-    ranges_from_chars(view, ret_val);
+    ranges_from_chars(t_view, ret_val);
     return winning_numbers.contains(ret_val);
   });
 
   return matching_num;
 }
 
-void part1() {
-  using ranges::getlines, ranges::accumulate;
+struct Day4 {
+  // number of matching numbers on each card
+  using Parsed = std::vector<long>;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+  // the lines are read first, then the cards are checked in parallel
+  static Parsed parse(std::istream& t_in) {
+    using ranges::getlines, ranges::to_vector, ranges::views::indices;
 
-  auto const res = accumulate(rng, 0, ranges::plus{}, [](std::string_view t_str) {
-    auto const matching_num = get_matching_number(t_str);
-    return matching_num == 0 ? 0 : 1UL << static_cast<std::size_t>(matching_num - 1);
-  });
+    auto const lines = getlines(t_in) | to_vector;
 
-  fmt::println("sum: {}", res);
-}
+    Parsed ret_val(lines.size());
+    aoc::parallel_for(indices(lines.size()),
+                      [&](std::size_t const t_idx) { ret_val[t_idx] = get_matching_number(lines[t_idx]); });
+    return ret_val;
+  }
 
-void part2() {
-  using ranges::getlines, ranges::views::transform, ranges::to_vector, ranges::accumulate, ranges::views::enumerate;
+  static std::size_t part1(Parsed const& t_matching) {
+    using ranges::accumulate;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
+    return accumulate(t_matching, 0UL, ranges::plus{}, [](auto const t_matching_num) {
+      return t_matching_num == 0 ? 0 : 1UL << static_cast<std::size_t>(t_matching_num - 1);
+    });
+  }
 
-  auto const winning_card_num = rng | transform(get_matching_number) | to_vector;
-  std::vector<int> number_for_each_card(winning_card_num.size(), 1);
-  for (auto const [idx, val] : enumerate(winning_card_num)) {
-    for (int i = 0; i < val; ++i) {
-      number_for_each_card[idx + static_cast<std::size_t>(i) + 1] += number_for_each_card[idx];
+  static int part2(Parsed const& t_matching) {
+    using ranges::accumulate, ranges::views::enumerate;
+
+    std::vector<int> number_for_each_card(t_matching.size(), 1);
+    for (auto const [idx, val] : enumerate(t_matching)) {
+      for (long i = 0; i < val; ++i) {
+        number_for_each_card[idx + static_cast<std::size_t>(i) + 1] += number_for_each_card[idx];
+      }
     }
-  }
 
-  fmt::println("total scratchcards: {}", accumulate(number_for_each_card, 0));
-}
+    return accumulate(number_for_each_card, 0);
+  }
+};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER(2023, 4, Day4);
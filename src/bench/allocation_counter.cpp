@@ -0,0 +1,226 @@
+#include "allocations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Every block carries its size in a header in front of it, delete doesn't always get the size and the live bytes need
+// it. The header is as large as the alignment of the block so that the block keeps it
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+std::atomic<std::size_t> allocated_bytes{0};
+std::atomic<std::size_t> live_bytes{0};
+std::atomic<std::size_t> peak_live_bytes{0};
+std::atomic<std::size_t> reset_live_bytes{0};
+
+constexpr std::size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+[[nodiscard]] constexpr std::size_t header_size(std::size_t const t_alignment) noexcept {
+  return std::max(t_alignment, DEFAULT_ALIGNMENT);
+}
+
+void record_allocation(std::size_t const t_size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(t_size, std::memory_order_relaxed);
+
+  auto const live = live_bytes.fetch_add(t_size, std::memory_order_relaxed) + t_size;
+  auto peak       = peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > peak and not peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+[[nodiscard]] void* allocate(std::size_t const t_size, std::size_t const t_alignment) noexcept {
+  auto const header = header_size(t_alignment);
+  auto const total  = header + t_size;
+
+  void* const base = t_alignment > DEFAULT_ALIGNMENT
+                       ? std::aligned_alloc(t_alignment, (total + t_alignment - 1) / t_alignment * t_alignment)
+                       : std::malloc(total);
+  if (base == nullptr) {
+    return nullptr;
+  }
+
+  auto* const block = static_cast<std::byte*>(base) + header;
+  std::memcpy(block - sizeof(std::size_t), &t_size, sizeof(std::size_t));
+  record_allocation(t_size);
+  return block;
+}
+
+void deallocate(void* const t_block, std::size_t const t_alignment) noexcept {
+  if (t_block == nullptr) {
+    return;
+  }
+
+  auto* const block = static_cast<std::byte*>(t_block);
+  std::size_t size  = 0;
+  std::memcpy(&size, block - sizeof(std::size_t), sizeof(std::size_t));
+  live_bytes.fetch_sub(size, std::memory_order_relaxed);
+  std::free(block - header_size(t_alignment));
+}
+
+// like the default operator new: call the new handler until there is memory or none is installed
+[[nodiscard]] void* allocate_or_throw(std::size_t const t_size, std::size_t const t_alignment) {
+  for (;;) {
+    if (auto* const block = allocate(t_size, t_alignment); block != nullptr) {
+      return block;
+    }
+
+    auto* const handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc{};
+    }
+
+    handler();
+  }
+}
+
+// VmHWM of /proc/self/status, the peak resident set size that /proc/self/clear_refs resets
+[[nodiscard]] std::size_t peak_rss_bytes() noexcept {
+#if defined(__linux__)
+  if (auto* const status = std::fopen("/proc/self/status", "r"); status != nullptr) {
+    char line[256];
+    std::size_t kilobytes = 0;
+    while (std::fgets(line, sizeof(line), status) != nullptr) {
+      if (std::sscanf(line, "VmHWM: %zu kB", &kilobytes) == 1) {
+        break;
+      }
+    }
+
+    std::fclose(status);
+    if (kilobytes != 0) {
+      return kilobytes * 1024;
+    }
+  }
+#endif
+
+#if defined(__unix__) or defined(__APPLE__)
+  rusage usage{};
+  if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);  // bytes on macOS, kilobytes elsewhere
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+
+  return 0;
+}
+
+void reset_peak_rss() noexcept {
+#if defined(__linux__)
+  if (auto const clear_refs = ::open("/proc/self/clear_refs", O_WRONLY); clear_refs >= 0) {
+    [[maybe_unused]] auto const written = ::write(clear_refs, "5", 1);
+    ::close(clear_refs);
+  }
+#endif
+}
+
+}  // namespace
+
+namespace aoc::bench {
+
+void reset_allocation_stats() noexcept {
+  allocations.store(0, std::memory_order_relaxed);
+  allocated_bytes.store(0, std::memory_order_relaxed);
+
+  auto const live = live_bytes.load(std::memory_order_relaxed);
+  reset_live_bytes.store(live, std::memory_order_relaxed);
+  peak_live_bytes.store(live, std::memory_order_relaxed);
+  reset_peak_rss();
+}
+
+AllocationStats allocation_stats() noexcept {
+  auto const peak  = peak_live_bytes.load(std::memory_order_relaxed);
+  auto const reset = reset_live_bytes.load(std::memory_order_relaxed);
+  return AllocationStats{.allocations_     = allocations.load(std::memory_order_relaxed),
+                         .allocated_bytes_ = allocated_bytes.load(std::memory_order_relaxed),
+                         .peak_live_bytes_ = peak > reset ? peak - reset : 0,
+                         .peak_rss_bytes_  = peak_rss_bytes()};
+}
+
+}  // namespace aoc::bench
+
+void* operator new(std::size_t const t_size) { return allocate_or_throw(t_size, DEFAULT_ALIGNMENT); }
+void* operator new[](std::size_t const t_size) { return allocate_or_throw(t_size, DEFAULT_ALIGNMENT); }
+
+void* operator new(std::size_t const t_size, std::align_val_t const t_alignment) {
+  return allocate_or_throw(t_size, static_cast<std::size_t>(t_alignment));
+}
+
+void* operator new[](std::size_t const t_size, std::align_val_t const t_alignment) {
+  return allocate_or_throw(t_size, static_cast<std::size_t>(t_alignment));
+}
+
+void* operator new(std::size_t const t_size, std::nothrow_t const& /*t_tag*/) noexcept {
+  return allocate(t_size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t const t_size, std::nothrow_t const& /*t_tag*/) noexcept {
+  return allocate(t_size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t const t_size, std::align_val_t const t_alignment,
+                   std::nothrow_t const& /*t_tag*/) noexcept {
+  return allocate(t_size, static_cast<std::size_t>(t_alignment));
+}
+
+void* operator new[](std::size_t const t_size, std::align_val_t const t_alignment,
+                     std::nothrow_t const& /*t_tag*/) noexcept {
+  return allocate(t_size, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete(void* const t_block) noexcept { deallocate(t_block, DEFAULT_ALIGNMENT); }
+void operator delete[](void* const t_block) noexcept { deallocate(t_block, DEFAULT_ALIGNMENT); }
+void operator delete(void* const t_block, std::size_t /*t_size*/) noexcept { deallocate(t_block, DEFAULT_ALIGNMENT); }
+void operator delete[](void* const t_block, std::size_t /*t_size*/) noexcept {
+  deallocate(t_block, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* const t_block, std::align_val_t const t_alignment) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete[](void* const t_block, std::align_val_t const t_alignment) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete(void* const t_block, std::size_t /*t_size*/, std::align_val_t const t_alignment) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete[](void* const t_block, std::size_t /*t_size*/, std::align_val_t const t_alignment) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete(void* const t_block, std::nothrow_t const& /*t_tag*/) noexcept {
+  deallocate(t_block, DEFAULT_ALIGNMENT);
+}
+
+void operator delete[](void* const t_block, std::nothrow_t const& /*t_tag*/) noexcept {
+  deallocate(t_block, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* const t_block, std::align_val_t const t_alignment,
+                     std::nothrow_t const& /*t_tag*/) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
+
+void operator delete[](void* const t_block, std::align_val_t const t_alignment,
+                       std::nothrow_t const& /*t_tag*/) noexcept {
+  deallocate(t_block, static_cast<std::size_t>(t_alignment));
+}
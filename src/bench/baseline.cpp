@@ -0,0 +1,330 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Keeps one benchmark baseline per machine and compares new bench_<year>_dayN --json runs against it
+//
+//    bench_baseline save <run.json> [--store <dir>] [--machine <name>]
+//        merge the days of the run into the baseline of the machine (a day already in it is replaced, the days run on
+//        a generated input are kept per size)
+//
+//    bench_baseline compare <run.json> [--store <dir>] [--machine <name>] [--threshold <percent>] [--alpha <p>]
+//        compare every measurement of the run with the baseline and exit with a failure when one of them regressed
+//
+// The baseline of a machine is <store>/<machine>.json, <store> defaults to BASELINE_DIR and <machine> to the host name.
+// A measurement regressed when its median time is more than <threshold> percent (default 5) slower than the baseline
+// and the difference is significant: a two sided Mann-Whitney U test on the samples of both runs gives p < <alpha>
+// (default 0.01). Allocation counts, allocated bytes and peak live bytes are deterministic, any increase over
+// <threshold> percent is a regression
+namespace {
+
+enum class Command { save, compare };
+
+struct Options {
+  Command command_;
+  std::string run_;
+  std::filesystem::path store_ = BASELINE_DIR;
+  std::string machine_;
+  double threshold_ = 5;
+  double alpha_     = 0.01;
+};
+
+constexpr std::string_view USAGE = "(save|compare) <run.json> [--store <dir>] [--machine <name>] "
+                                   "[--threshold <percent>] [--alpha <p>]";
+
+[[nodiscard]] std::string host_name() {
+  std::array<char, 256> name{};
+  if (::gethostname(name.data(), name.size() - 1) != 0 or name[0] == '\0') {
+    return "default";
+  }
+
+  return name.data();
+}
+
+[[nodiscard]] std::optional<double> to_double(std::string_view const t_str) noexcept {
+  double ret_val = 0;
+  auto const* const end = t_str.data() + t_str.size();
+  if (auto const [ptr, ec] = std::from_chars(t_str.data(), end, ret_val); ec != std::errc() or ptr != end) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+[[nodiscard]] std::optional<Options> parse_options(std::span<char* const> const t_args) {
+  using namespace std::string_view_literals;
+
+  if (t_args.size() < 3) {
+    return std::nullopt;
+  }
+
+  Options ret_val{.command_ = Command::save, .run_ = t_args[2], .machine_ = host_name()};
+  if (auto const command = std::string_view{t_args[1]}; command == "compare"sv) {
+    ret_val.command_ = Command::compare;
+  } else if (command != "save"sv) {
+    return std::nullopt;
+  }
+
+  for (std::size_t i = 3; i < t_args.size(); ++i) {
+    auto const arg = std::string_view{t_args[i]};
+    if (i + 1 == t_args.size()) {
+      return std::nullopt;
+    }
+
+    auto const value = std::string_view{t_args[++i]};
+    if (arg == "--store"sv) {
+      ret_val.store_ = value;
+    } else if (arg == "--machine"sv) {
+      ret_val.machine_ = value;
+    } else if (arg == "--threshold"sv or arg == "--alpha"sv) {
+      auto const number = to_double(value);
+      if (not number or *number < 0) {
+        return std::nullopt;
+      }
+
+      (arg == "--threshold"sv ? ret_val.threshold_ : ret_val.alpha_) = *number;
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  return ret_val;
+}
+
+// throws std::system_error when the file can't be read, std::nullopt when it isn't a benchmark run
+[[nodiscard]] std::optional<aoc::bench::Run> read_run(std::filesystem::path const& t_path) {
+  std::ifstream in{t_path};
+  if (not in.is_open()) {
+    throw std::system_error(errno, std::generic_category(), t_path.string());
+  }
+
+  std::ostringstream content;
+  content << in.rdbuf();
+  return aoc::bench::from_json(content.str());
+}
+
+// two sided p-value of the Mann-Whitney U test (normal approximation, ties get their average rank), i.e. how likely it
+// is to see samples this different if both runs had the same distribution
+[[nodiscard]] double mann_whitney_p(std::span<double const> const t_first, std::span<double const> const t_second) {
+  std::vector<std::pair<double, bool>> all;  // sample, is from t_first
+  all.reserve(t_first.size() + t_second.size());
+  std::ranges::transform(t_first, std::back_inserter(all), [](double t_sample) { return std::pair{t_sample, true}; });
+  std::ranges::transform(t_second, std::back_inserter(all), [](double t_sample) { return std::pair{t_sample, false}; });
+  std::ranges::sort(all);
+
+  double first_rank_sum = 0;
+  double tie_term       = 0;  // sum of t^3 - t over the groups of t tied samples
+  for (std::size_t i = 0; i < all.size();) {
+    auto j = i;
+    while (j < all.size() and all[j].first == all[i].first) {
+      ++j;
+    }
+
+    auto const average_rank = static_cast<double>(i + j + 1) / 2;
+    auto const tied         = static_cast<double>(j - i);
+    tie_term += tied * tied * tied - tied;
+    for (; i < j; ++i) {
+      first_rank_sum += all[i].second ? average_rank : 0;
+    }
+  }
+
+  auto const n1       = static_cast<double>(t_first.size());
+  auto const n2       = static_cast<double>(t_second.size());
+  auto const n        = n1 + n2;
+  auto const u        = first_rank_sum - n1 * (n1 + 1) / 2;
+  auto const variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+  if (variance <= 0) {
+    return 1;
+  }
+
+  auto const z = (u - n1 * n2 / 2) / std::sqrt(variance);
+  return std::erfc(std::abs(z) / std::sqrt(2.0));
+}
+
+// whether the difference of the medians is more than noise. Without samples (or too few of them) the difference has to
+// be larger than 3 times the larger median absolute deviation
+[[nodiscard]] bool is_significant(aoc::bench::Stats const& t_baseline, aoc::bench::Stats const& t_current,
+                                  double const t_alpha) {
+  static constexpr std::size_t MIN_SAMPLES = 5;
+  if (t_baseline.samples_ns_.size() >= MIN_SAMPLES and t_current.samples_ns_.size() >= MIN_SAMPLES) {
+    return mann_whitney_p(t_baseline.samples_ns_, t_current.samples_ns_) < t_alpha;
+  }
+
+  return std::abs(t_current.median_ns_ - t_baseline.median_ns_) > 3 * std::max(t_baseline.mad_ns_, t_current.mad_ns_);
+}
+
+constexpr std::array<std::pair<std::string_view, std::size_t aoc::bench::AllocationStats::*>, 3> MEMORY_COUNTS{{
+  {"allocations", &aoc::bench::AllocationStats::allocations_},
+  {"allocated bytes", &aoc::bench::AllocationStats::allocated_bytes_},
+  {"peak live bytes", &aoc::bench::AllocationStats::peak_live_bytes_},
+}};
+
+[[nodiscard]] double percent_change(double const t_baseline, double const t_current) noexcept {
+  return t_baseline == 0 ? (t_current == 0 ? 0 : 100) : (t_current - t_baseline) / t_baseline * 100;
+}
+
+// prints one line per measurement, returns the number of regressions
+[[nodiscard]] std::size_t compare(aoc::bench::Run const& t_baseline, aoc::bench::Run const& t_current,
+                                  Options const& t_options) {
+  std::size_t regressions = 0;
+  for (auto const& day : t_current.days_) {
+    auto const baseline_day = std::ranges::find_if(t_baseline.days_, [&](auto const& t_day) {
+      return t_day.year_ == day.year_ and t_day.day_ == day.day_ and t_day.size_ == day.size_;
+    });
+
+    for (auto const& [name, stats, memory, counters, metrics] : day.measurements_) {
+      auto const size   = day.size_ ? fmt::format(" size {}", *day.size_) : "";
+      auto const prefix = fmt::format("[{} day {}{}] {:<8}", day.year_, day.day_, size, name);
+
+      aoc::bench::Measurement const* baseline = nullptr;
+      if (baseline_day != t_baseline.days_.end()) {
+        auto const found = std::ranges::find(baseline_day->measurements_, name, &aoc::bench::Measurement::name_);
+        baseline         = found == baseline_day->measurements_.end() ? nullptr : &*found;
+      }
+
+      if (baseline == nullptr) {
+        fmt::println("{} no baseline", prefix);
+        continue;
+      }
+
+      auto const change      = percent_change(baseline->stats_.median_ns_, stats.median_ns_);
+      auto const significant = is_significant(baseline->stats_, stats, t_options.alpha_);
+
+      std::string_view verdict = "~";
+      if (significant and change > t_options.threshold_) {
+        verdict = "REGRESSION";
+        ++regressions;
+      } else if (significant and change < -t_options.threshold_) {
+        verdict = "improvement";
+      }
+
+      fmt::println("{} median {:>12.1f} us -> {:>12.1f} us  {:>+8.1f}%  {}", prefix,
+                   baseline->stats_.median_ns_ / 1000, stats.median_ns_ / 1000, change, verdict);
+
+      // the retired instructions explain a change of the time, they don't decide whether it regressed
+      if (counters and baseline->counters_ and counters->instructions_ and baseline->counters_->instructions_) {
+        auto const before = *baseline->counters_->instructions_;
+        auto const after  = *counters->instructions_;
+        fmt::println("{} {:<15} {:>12.0f} -> {:>12.0f}  {:>+8.1f}%", prefix, "instructions", before, after,
+                     percent_change(before, after));
+      }
+
+      // the work of the searches, to tell whether a pruning change removed some
+      if (metrics and baseline->metrics_) {
+        for (auto const& [metric, after] : *metrics) {
+          auto const found = std::ranges::find(*baseline->metrics_, metric, &aoc::bench::Metrics::value_type::first);
+          if (found != baseline->metrics_->end()) {
+            fmt::println("{} {:<36} {:>14.2f} -> {:>14.2f}  {:>+8.1f}%", prefix, metric, found->second, after,
+                         percent_change(found->second, after));
+          }
+        }
+      }
+
+      if (not memory or not baseline->memory_) {
+        continue;
+      }
+
+      // the peak resident set size depends on the rest of the process, only the deterministic counts are compared
+      for (auto const& [label, member] : MEMORY_COUNTS) {
+        auto const before    = (*baseline->memory_).*member;
+        auto const after     = (*memory).*member;
+        auto const growth    = percent_change(static_cast<double>(before), static_cast<double>(after));
+        auto const regressed = growth > t_options.threshold_;
+        regressions += regressed ? 1 : 0;
+        fmt::println("{} {:<15} {:>12} -> {:>12}  {:>+8.1f}%  {}", prefix, label, before, after, growth,
+                     regressed ? "REGRESSION" : "~");
+      }
+    }
+  }
+
+  return regressions;
+}
+
+[[nodiscard]] aoc::bench::Run merge(aoc::bench::Run t_baseline, aoc::bench::Run const& t_current) {
+  for (auto const& day : t_current.days_) {
+    std::erase_if(t_baseline.days_, [&](auto const& t_day) {
+      return t_day.year_ == day.year_ and t_day.day_ == day.day_ and t_day.size_ == day.size_;
+    });
+    t_baseline.days_.push_back(day);
+  }
+
+  std::ranges::sort(t_baseline.days_, {},
+                    [](auto const& t_day) { return std::tuple{t_day.year_, t_day.day_, t_day.size_}; });
+  t_baseline.config_ = t_current.config_;
+  return t_baseline;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto const args    = std::span(argv, static_cast<std::size_t>(argc));
+  auto const options = parse_options(args);
+  if (not options) {
+    fmt::println(stderr, "usage: {} {}", args[0], USAGE);
+    return EXIT_FAILURE;
+  }
+
+  auto const baseline_path = options->store_ / (options->machine_ + ".json");
+  try {
+    auto const current = read_run(options->run_);
+    if (not current) {
+      fmt::println(stderr, "{} is not a benchmark run (bench_<year>_dayN --json)", options->run_);
+      return EXIT_FAILURE;
+    }
+
+    auto const has_baseline = std::filesystem::exists(baseline_path);
+    auto const baseline     = has_baseline ? read_run(baseline_path) : std::optional{aoc::bench::Run{}};
+    if (not baseline) {
+      fmt::println(stderr, "{} is not a benchmark run", baseline_path.string());
+      return EXIT_FAILURE;
+    }
+
+    if (options->command_ == Command::save) {
+      std::filesystem::create_directories(options->store_);
+      auto const merged = merge(*baseline, *current);
+      std::ofstream out{baseline_path};
+      out << aoc::bench::to_json(merged.days_, merged.config_);
+      out.close();  // flushed before checking, a full disk only shows then
+      if (not out) {
+        fmt::println(stderr, "unable to write {}", baseline_path.string());
+        return EXIT_FAILURE;
+      }
+
+      fmt::println("saved {} day(s) to {}", current->days_.size(), baseline_path.string());
+      return EXIT_SUCCESS;
+    }
+
+    if (not has_baseline) {
+      fmt::println(stderr, "no baseline for {} in {}, run save first", options->machine_, options->store_.string());
+      return EXIT_FAILURE;
+    }
+
+    auto const regressions = compare(*baseline, *current, *options);
+    fmt::println("{} regression(s) over {}% (alpha {})", regressions, options->threshold_, options->alpha_);
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (std::system_error const& t_error) {
+    fmt::println(stderr, "{}", t_error.what());
+    return EXIT_FAILURE;
+  }
+}
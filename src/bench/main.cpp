@@ -0,0 +1,394 @@
+#include "arguments.hpp"
+#include "bench.hpp"
+#include "input_gen.hpp"
+#include "registry.hpp"
+#include "scaling.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fmt/os.h>
+#include <functional>
+#include <optional>
+#include <range/v3/algorithm/none_of.hpp>
+#include <range/v3/algorithm/sort.hpp>
+#include <range/v3/view/filter.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// options of the benchmark on top of the ones shared with the runner (see arguments.hpp)
+//
+//    --warmup <n>        runs before measuring (default 3)
+//    --repeats <n>       measured runs (default 20)
+//    --json <path|->     also write the results as json to path ("-" for stdout, the table then goes to stderr)
+//    --size <n>          run on a generated input of this size instead of a file (see input_gen.hpp)
+//    --sweep <min>:<max>[:<ratio>]
+//                        run on generated inputs of the sizes min, min * ratio, ... up to max (ratio 2 by default)
+//                        and fit the times of every part to a complexity (see scaling.hpp)
+//    --seed <s>          seed of the generated inputs (default 0)
+struct BenchOptions {
+  aoc::bench::Config config_;
+  std::optional<std::string_view> json_;
+  std::vector<std::size_t> sizes_;  // of the generated inputs, none to run on the input files
+  bool sweep_         = false;
+  std::uint64_t seed_ = 0;
+  std::vector<char*> remaining_;  // everything else, for aoc::parse_arguments
+
+  // where the results are printed as a table, not where the json goes
+  [[nodiscard]] std::FILE* table_output() const noexcept { return this->json_ == "-" ? stderr : stdout; }
+};
+
+[[nodiscard]] std::optional<std::size_t> to_size(std::string_view const t_str) noexcept {
+  std::size_t ret_val = 0;
+  auto const* const end = t_str.data() + t_str.size();
+  if (auto const [ptr, ec] = std::from_chars(t_str.data(), end, ret_val); ec != std::errc() or ptr != end) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+// "<min>:<max>[:<ratio>]", a fit needs at least 3 sizes
+[[nodiscard]] std::optional<std::vector<std::size_t>> parse_sweep(std::string_view const t_str) {
+  static constexpr std::size_t MIN_SIZES = 3;
+
+  auto const first  = t_str.find(':');
+  auto const second = first == std::string_view::npos ? first : t_str.find(':', first + 1);
+  if (first == std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  auto const min = to_size(t_str.substr(0, first));
+  auto const max = to_size(t_str.substr(first + 1, second == std::string_view::npos ? second : second - first - 1));
+
+  double ratio = 2;
+  if (second != std::string_view::npos) {
+    auto const ratio_str = t_str.substr(second + 1);
+    auto const* const ratio_end = ratio_str.data() + ratio_str.size();
+    if (auto const [ptr, ec] = std::from_chars(ratio_str.data(), ratio_end, ratio);
+        ec != std::errc() or ptr != ratio_end) {
+      return std::nullopt;
+    }
+  }
+
+  if (not min or not max or ratio <= 1) {
+    return std::nullopt;
+  }
+
+  auto ret_val = aoc::bench::geometric_sizes(*min, *max, ratio);
+  return ret_val.size() < MIN_SIZES ? std::nullopt : std::optional{std::move(ret_val)};
+}
+
+[[nodiscard]] std::optional<BenchOptions> parse_bench_options(std::span<char* const> const t_args) {
+  using namespace std::string_view_literals;
+
+  BenchOptions ret_val;
+  auto has_seed = false;
+  ret_val.remaining_.push_back(t_args[0]);
+  for (std::size_t i = 1; i < t_args.size(); ++i) {
+    auto const arg = std::string_view{t_args[i]};
+    if (arg != "--warmup"sv and arg != "--repeats"sv and arg != "--json"sv and arg != "--size"sv and
+        arg != "--sweep"sv and arg != "--seed"sv) {
+      ret_val.remaining_.push_back(t_args[i]);
+      continue;
+    }
+
+    if (i + 1 == t_args.size()) {
+      return std::nullopt;
+    }
+
+    auto const value = std::string_view{t_args[++i]};
+    if (arg == "--json"sv) {
+      ret_val.json_ = value;
+      continue;
+    }
+
+    if (not ret_val.sizes_.empty() and (arg == "--size"sv or arg == "--sweep"sv)) {
+      return std::nullopt;  // only one of them
+    }
+
+    if (arg == "--sweep"sv) {
+      auto sizes = parse_sweep(value);
+      if (not sizes) {
+        return std::nullopt;
+      }
+
+      ret_val.sizes_ = std::move(*sizes);
+      ret_val.sweep_ = true;
+      continue;
+    }
+
+    auto const count = to_size(value);
+    if (not count) {
+      return std::nullopt;
+    }
+
+    if (arg == "--size"sv) {
+      ret_val.sizes_ = {*count};
+    } else if (arg == "--seed"sv) {
+      ret_val.seed_ = *count;
+      has_seed      = true;
+    } else {
+      (arg == "--warmup"sv ? ret_val.config_.warmup_ : ret_val.config_.repeats_) = *count;
+    }
+  }
+
+  if (ret_val.config_.repeats_ == 0 or (has_seed and ret_val.sizes_.empty())) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+void print_usage(std::string_view const t_program) {
+  fmt::println(stderr,
+               "usage: {} {} [--warmup <n>] [--repeats <n>] [--json <path|->] "
+               "[(--size <n> | --sweep <min>:<max>[:<ratio>]) [--seed <s>]]",
+               t_program, aoc::ARGUMENTS_USAGE);
+}
+
+void print_measurement(std::FILE* const t_out, aoc::bench::DayReport const& t_report,
+                       aoc::bench::Measurement const& t_measurement) {
+  auto const& stats = t_measurement.stats_;
+  auto const to_us  = [](double const t_ns) { return t_ns / 1000; };
+  auto const size   = t_report.size_ ? fmt::format(" size {}", *t_report.size_) : "";
+  fmt::println(t_out,
+               "[{} day {}{}] {:<8} median {:>12.1f} us  mad {:>10.1f} us  min {:>12.1f} us  {:>10} cycles/byte",
+               t_report.year_, t_report.day_, size, t_measurement.name_, to_us(stats.median_ns_),
+               to_us(stats.mad_ns_), to_us(stats.min_ns_), aoc::bench::cycles_per_byte(stats, t_report.input_bytes_));
+
+  if (auto const& memory = t_measurement.memory_; memory) {
+    auto const to_kib = [](std::size_t const t_bytes) { return static_cast<double>(t_bytes) / 1024; };
+    fmt::println(t_out,
+                 "[{} day {}{}] {:<8} {:>10} allocs {:>12.1f} KiB allocated  peak live {:>10.1f} KiB  rss {:>9.1f} KiB",
+                 t_report.year_, t_report.day_, size, t_measurement.name_, memory->allocations_,
+                 to_kib(memory->allocated_bytes_), to_kib(memory->peak_live_bytes_), to_kib(memory->peak_rss_bytes_));
+  }
+
+  if (auto const& counters = t_measurement.counters_; counters) {
+    auto const bytes    = static_cast<double>(t_report.input_bytes_);
+    auto const per_byte = [&](std::optional<double> const t_count) {
+      return t_count and bytes > 0 ? std::optional{*t_count / bytes} : std::nullopt;
+    };
+    auto const show = [](std::optional<double> const t_value) {
+      return t_value ? fmt::format("{:.3f}", *t_value) : std::string{"-"};
+    };
+
+    fmt::println(t_out, "[{} day {}{}] {:<8} ipc {:>6}  misses per byte: L1d {:>8}  LLC {:>8}  branch {:>8}",
+                 t_report.year_, t_report.day_, size, t_measurement.name_, show(counters->ipc()),
+                 show(per_byte(counters->l1d_misses_)), show(per_byte(counters->llc_misses_)),
+                 show(per_byte(counters->branch_misses_)));
+  }
+
+  if (auto const& metrics = t_measurement.metrics_; metrics) {
+    for (auto const& [name, value] : *metrics) {
+      auto const is_count = value == std::floor(value);
+      fmt::println(t_out, "[{} day {}{}] {:<8} {:<36} {:>16}", t_report.year_, t_report.day_, size,
+                   t_measurement.name_, name, is_count ? fmt::format("{:.0f}", value) : fmt::format("{:.2f}", value));
+    }
+  }
+}
+
+[[nodiscard]] bool is_selected(aoc::Arguments const& t_options, aoc::Part const& t_part) {
+  return not t_options.part_ or *t_options.part_ == t_part.name_;
+}
+
+// Measures the parse and the selected parts of t_day, on a generated input of t_size if there is one and on its input
+// file otherwise. std::nullopt, once the reason is printed, when there is no such input
+[[nodiscard]] std::optional<aoc::bench::DayReport> bench_day(aoc::Day const& t_day, aoc::Arguments const& t_options,
+                                                             BenchOptions const& t_bench_options,
+                                                             std::optional<std::size_t> const t_size,
+                                                             aoc::bench::PerfCounters& t_counters) {
+  using ranges::views::filter;
+
+  auto const* const generator = t_size ? aoc::gen::find_generator(t_day.year_, t_day.day_) : nullptr;
+  if (t_size and generator == nullptr) {
+    fmt::println(stderr, "[{} day {}] has no input generator", t_day.year_, t_day.day_);
+    return std::nullopt;
+  }
+
+  auto const input = aoc::input_path(t_options, t_day.year_, t_day.day_, t_day.input_);
+  auto report      = aoc::bench::DayReport{.year_         = t_day.year_,
+                                           .day_          = t_day.day_,
+                                           .input_        = input,
+                                           .input_bytes_  = 0,
+                                           .size_         = t_size,
+                                           .measurements_ = {}};
+
+  aoc::ParsedInput parsed;
+  try {
+    if (generator != nullptr) {
+      // the generated inputs only depend on their parameters, runs with the same ones just overwrite them
+      auto const params = aoc::gen::Params{.size_ = *t_size, .seed_ = t_bench_options.seed_};
+      report.input_     = aoc::gen::write_input(*generator, params,
+                                                std::filesystem::temp_directory_path() / "aoc_bench" /
+                                                  fmt::format("size{}_seed{}", params.size_, params.seed_))
+                        .string();
+    }
+
+    report.input_bytes_ = std::filesystem::file_size(report.input_);
+    parsed              = t_day.parse_(report.input_);
+  } catch (std::system_error const& t_error) {
+    fmt::println(stderr, "[{} day {}] unable to read input: {}", t_day.year_, t_day.day_, t_error.what());
+    return std::nullopt;
+  }
+
+  // timed runs first, then the untimed ones counting the allocations, the hardware events and the metrics
+  auto const measure = [&](std::string t_name, auto const& t_fn) {
+    auto const& config = t_bench_options.config_;
+    auto stats         = aoc::bench::measure(t_fn, config);
+    auto memory        = aoc::bench::measure_memory(t_fn);
+    auto counters      = aoc::bench::measure_counters(t_counters, t_fn, config);
+    auto metrics       = aoc::bench::measure_metrics(t_fn);
+    print_measurement(t_bench_options.table_output(), report,
+                      report.measurements_.emplace_back(std::move(t_name), std::move(stats), memory, counters,
+                                                        std::move(metrics)));
+  };
+
+  measure("parse", [&] { return t_day.parse_(report.input_); });
+  for (auto const& part :
+       t_day.parts_ | filter([&](aoc::Part const& t_part) { return is_selected(t_options, t_part); })) {
+    measure(std::string{part.name_}, [&] { return part.solve_(parsed.get()); });
+  }
+
+  return report;
+}
+
+// One line per measurement of every day, fitting its median time over the sizes of the sweep. n is the size of the
+// input in bytes rather than the size given to the generator, which means something different for every day
+void print_scaling(std::FILE* const t_out, std::span<aoc::bench::DayReport const> const t_reports) {
+  fmt::println(t_out, "\nscaling, n is the size of the input in bytes:");
+  for (auto first = t_reports.begin(); first != t_reports.end();) {
+    auto const last = std::find_if(first, t_reports.end(), [&](aoc::bench::DayReport const& t_report) {
+      return t_report.year_ != first->year_ or t_report.day_ != first->day_;
+    });
+
+    for (auto const& measurement : first->measurements_) {
+      std::vector<double> sizes;
+      std::vector<double> times;
+      for (auto const& report : std::ranges::subrange(first, last)) {
+        if (auto const found = std::ranges::find(report.measurements_, measurement.name_,
+                                                 &aoc::bench::Measurement::name_);
+            found != report.measurements_.end()) {
+          sizes.push_back(static_cast<double>(report.input_bytes_));
+          times.push_back(found->stats_.median_ns_);
+        }
+      }
+
+      auto const fit      = aoc::bench::best_fit(sizes, times);
+      auto const exponent = aoc::bench::empirical_exponent(sizes, times);
+      fmt::println(t_out, "[{} day {}] {:<8} {:<10} rms {:>6.1f}%  n^{:<5.2f} over {} sizes{}", first->year_,
+                   first->day_, measurement.name_, aoc::bench::to_string(fit.complexity_), fit.rms_ * 100, exponent,
+                   sizes.size(), fit.complexity_ > aoc::bench::Complexity::n_log_n ? "  <- superlinear" : "");
+    }
+
+    first = last;
+  }
+}
+
+}  // namespace
+
+// Every bench_<year>_dayN binary only links its own day, but this works the same with several days linked in
+int main(int argc, char** argv) {
+  using ranges::sort, ranges::none_of;
+
+  auto const args          = std::span(argv, static_cast<std::size_t>(argc));
+  auto const bench_options = parse_bench_options(args);
+  auto const options       = bench_options ? aoc::parse_arguments(bench_options->remaining_) : std::nullopt;
+  if (not options) {
+    print_usage(args[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (options->threads_) {
+    aoc::set_thread_count(static_cast<std::size_t>(*options->threads_));
+  }
+
+  if (options->reads_stdin()) {
+    fmt::println(stderr, "the input is read once per run, it has to be a file");
+    return EXIT_FAILURE;
+  }
+
+  auto const& sizes = bench_options->sizes_;
+  if (not sizes.empty() and (options->input_ or options->input_dir_)) {
+    fmt::println(stderr, "--size and --sweep generate the input, they can't be combined with --input or --input-dir");
+    return EXIT_FAILURE;
+  }
+
+  // the benchmarks still run without them, e.g. in a container not allowed to use perf_event_open
+  aoc::bench::PerfCounters counters;
+  if (not counters.available()) {
+    fmt::println(stderr, "no hardware counters ({}), see /proc/sys/kernel/perf_event_paranoid",
+                 std::generic_category().message(counters.error()));
+  }
+
+  // the workers of the pool start now that the counters are open, they inherit them and the work of the parallel days
+  // is counted as well
+  static_cast<void>(aoc::thread_pool());
+
+  auto& days = aoc::registry();
+  sort(days, std::less<>{}, [](auto const& t_day) { return std::pair{t_day.year_, t_day.day_}; });
+
+  std::vector<aoc::bench::DayReport> reports;
+  for (auto const& day : days) {
+    if ((options->year_ and *options->year_ != day.year_) or (options->day_ and *options->day_ != day.day_) or
+        none_of(day.parts_, [&](aoc::Part const& t_part) { return is_selected(*options, t_part); })) {
+      continue;
+    }
+
+    if (sizes.empty()) {
+      auto report = bench_day(day, *options, *bench_options, std::nullopt, counters);
+      if (not report) {
+        return EXIT_FAILURE;
+      }
+
+      reports.push_back(std::move(*report));
+    }
+
+    for (auto const size : sizes) {
+      auto report = bench_day(day, *options, *bench_options, size, counters);
+      if (not report) {
+        return EXIT_FAILURE;
+      }
+
+      reports.push_back(std::move(*report));
+    }
+  }
+
+  if (reports.empty()) {
+    fmt::println(stderr, "no solution matches the given selectors");
+    return EXIT_FAILURE;
+  }
+
+  if (bench_options->sweep_) {
+    print_scaling(bench_options->table_output(), reports);
+  }
+
+  if (bench_options->json_) {
+    auto const json = aoc::bench::to_json(reports, bench_options->config_);
+    if (*bench_options->json_ == "-") {
+      fmt::print("{}", json);
+    } else {
+      try {
+        fmt::output_file(std::string{*bench_options->json_}).print("{}", json);
+      } catch (std::system_error const& t_error) {
+        fmt::println(stderr, "unable to write {}: {}", *bench_options->json_, t_error.what());
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
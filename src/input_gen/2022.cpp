@@ -0,0 +1,913 @@
+#include "input_gen.hpp"
+#include "years.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using aoc::gen::Params;
+using aoc::gen::Rng;
+
+constexpr std::string_view LOWERCASE = "abcdefghijklmnopqrstuvwxyz";
+constexpr std::string_view UPPERCASE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+[[nodiscard]] double density_or(Params const& t_params, double const t_default) noexcept {
+  return t_params.density_ > 0 ? std::min(t_params.density_, 1.0) : t_default;
+}
+
+// a unique lowercase name per index: a, b, ..., z, ba, bb, ...
+[[nodiscard]] std::string to_letters(std::size_t t_idx) {
+  std::string ret_val;
+  do {
+    ret_val.push_back(LOWERCASE[t_idx % LOWERCASE.size()]);
+    t_idx /= LOWERCASE.size();
+  } while (t_idx != 0);
+
+  std::ranges::reverse(ret_val);
+  return ret_val;
+}
+
+// size: number of elves
+std::string day1(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t elf = 0; elf < std::max<std::size_t>(t_params.size_, 3); ++elf) {  // part 2 sums the top 3
+    ret_val += elf == 0 ? "" : "\n";
+    for (auto items = rng.uniform(1, 15); items > 0; --items) {
+      fmt::format_to(std::back_inserter(ret_val), "{}\n", rng.uniform(1000, 60000));
+    }
+  }
+
+  return ret_val;
+}
+
+// size: number of rounds
+std::string day2(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    ret_val += {rng.pick("ABC"), ' ', rng.pick("XYZ"), '\n'};
+  }
+
+  return ret_val;
+}
+
+// size: number of groups of three rucksacks. Every rucksack has exactly one item in both compartments and every group
+// exactly one badge: the 51 other item types are split in 3 disjoint pools of 17, one per rucksack, and the two
+// compartments of a rucksack draw from disjoint halves of its pool but its common item
+std::string day3(Params const& t_params) {
+  static constexpr std::size_t POOL_SIZE = 17;
+  static constexpr std::size_t HALF_POOL = POOL_SIZE / 2;
+
+  Rng rng{t_params.seed_};
+  std::string items = fmt::format("{}{}", LOWERCASE, UPPERCASE);
+  std::string ret_val;
+  for (std::size_t group = 0; group < t_params.size_; ++group) {
+    rng.shuffle(std::span{items});
+    auto const badge = items[0];
+    for (std::size_t elf = 0; elf < 3; ++elf) {
+      auto const pool      = std::string_view{items}.substr(1 + elf * POOL_SIZE, POOL_SIZE);
+      auto const half_size = rng.uniform<std::size_t>(4, 16);
+
+      std::string first{badge, pool[0]};
+      std::string second{pool[0]};
+      while (first.size() < half_size) {
+        first.push_back(pool[rng.uniform<std::size_t>(1, HALF_POOL)]);
+      }
+      while (second.size() < half_size) {
+        second.push_back(pool[rng.uniform<std::size_t>(HALF_POOL + 1, POOL_SIZE - 1)]);
+      }
+
+      rng.shuffle(std::span{first});
+      rng.shuffle(std::span{second});
+      ret_val += first + second + '\n';
+    }
+  }
+
+  return ret_val;
+}
+
+// size: number of pairs
+std::string day4(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    auto const first_start  = rng.uniform(1, 99);
+    auto const first_end    = rng.uniform(first_start, 99);
+    auto const second_start = rng.uniform(1, 99);
+    auto const second_end   = rng.uniform(second_start, 99);
+    fmt::format_to(std::back_inserter(ret_val), "{}-{},{}-{}\n", first_start, first_end, second_start, second_end);
+  }
+
+  return ret_val;
+}
+
+// size: number of moves. The drawing is parsed by its label line, which has to end with stack 9, and a move never
+// empties a stack
+std::string day5(Params const& t_params) {
+  static constexpr std::size_t STACKS = 9;
+
+  Rng rng{t_params.seed_};
+  std::array<std::string, STACKS> stacks;  // bottom to top
+  for (auto& stack : stacks) {
+    for (auto height = rng.uniform(2, 8); height > 0; --height) {
+      stack.push_back(rng.pick(UPPERCASE));
+    }
+  }
+
+  std::string ret_val;
+  auto const max_height = std::ranges::max(stacks, {}, &std::string::size).size();
+  for (auto level = max_height; level > 0; --level) {
+    std::string row;
+    for (auto const& stack : stacks) {
+      row += row.empty() ? "" : " ";
+      row += level <= stack.size() ? std::string{'[', stack[level - 1], ']'} : "   ";
+    }
+
+    ret_val += row + '\n';
+  }
+
+  ret_val += " 1   2   3   4   5   6   7   8   9\n\n";
+
+  // there are always 18 crates or more, hence always a stack with 2 of them
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    auto from = rng.uniform<std::size_t>(0, STACKS - 1);
+    while (stacks[from].size() < 2) {
+      from = rng.uniform<std::size_t>(0, STACKS - 1);
+    }
+
+    auto const to       = (from + rng.uniform<std::size_t>(1, STACKS - 1)) % STACKS;
+    auto const quantity = rng.uniform<std::size_t>(1, std::min<std::size_t>(stacks[from].size() - 1, 20));
+    stacks[to] += stacks[from].substr(stacks[from].size() - quantity);
+    stacks[from].resize(stacks[from].size() - quantity);
+    fmt::format_to(std::back_inserter(ret_val), "move {} from {} to {}\n", quantity, from + 1, to + 1);
+  }
+
+  return ret_val;
+}
+
+// size: length of the signal. Both markers are at the very end: the signal only uses 3 letters before the 14 distinct
+// ones ending it
+std::string day6(Params const& t_params) {
+  static constexpr std::size_t MARKER = 14;
+
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = MARKER; i < t_params.size_; ++i) {
+    ret_val.push_back(rng.pick("abc"));
+  }
+
+  std::string marker{LOWERCASE};
+  rng.shuffle(std::span{marker});
+  ret_val += marker.substr(0, MARKER) + '\n';
+  return ret_val;
+}
+
+// size: number of directories. Every directory hangs from a random earlier one (a random recursive tree, logarithmic
+// depth on average) and the file sizes add up to about 50M, more than the 40M part 2 has to get under
+std::string day7(Params const& t_params) {
+  static constexpr std::size_t TOTAL_SIZE    = 50'000'000;
+  static constexpr std::size_t MIN_SIZE      = 45'000'000;
+  static constexpr std::size_t MAX_SIZE      = 60'000'000;
+  static constexpr std::size_t FILES_PER_DIR = 5;  // 0 to 5, 2.5 on average
+
+  static constexpr std::array<std::string_view, 5> EXTENSIONS{"txt", "dat", "log", "bin", "cfg"};
+
+  Rng rng{t_params.seed_};
+  auto const dirs = std::max<std::size_t>(t_params.size_, 1);
+
+  std::vector<std::vector<std::size_t>> children(dirs);
+  std::vector<std::vector<std::size_t>> files(dirs);  // sizes
+  for (std::size_t dir = 1; dir < dirs; ++dir) {
+    children[rng.uniform<std::size_t>(0, dir - 1)].push_back(dir);
+  }
+
+  auto const mean_size = std::max<std::size_t>(TOTAL_SIZE * 2 / (FILES_PER_DIR * dirs), 1);
+  std::size_t total    = 0;
+  for (auto& dir_files : files) {
+    for (auto count = rng.uniform<std::size_t>(0, FILES_PER_DIR); count > 0; --count) {
+      auto const size = rng.uniform<std::size_t>(1, 2 * mean_size);
+      if (total + size <= MAX_SIZE) {
+        dir_files.push_back(size);
+        total += size;
+      }
+    }
+  }
+
+  if (total < MIN_SIZE) {
+    files[0].push_back(MIN_SIZE - total);
+  }
+
+  std::string ret_val = "$ cd /\n";
+  auto out            = std::back_inserter(ret_val);
+
+  std::vector<std::pair<std::size_t, std::size_t>> stack{{0, 0}};  // directory, next child to enter
+  while (not stack.empty()) {
+    auto& [dir, next_child] = stack.back();
+    if (next_child == 0) {
+      ret_val += "$ ls\n";
+      for (auto const child : children[dir]) {
+        fmt::format_to(out, "dir {}\n", to_letters(child));
+      }
+      for (std::size_t i = 0; i < files[dir].size(); ++i) {
+        fmt::format_to(out, "{} {}.{}\n", files[dir][i], to_letters(i), rng.pick(std::span{EXTENSIONS}));
+      }
+    }
+
+    if (next_child == children[dir].size()) {
+      ret_val += stack.size() == 1 ? "" : "$ cd ..\n";
+      stack.pop_back();
+      continue;
+    }
+
+    auto const child = children[dir][next_child++];
+    fmt::format_to(out, "$ cd {}\n", to_letters(child));
+    stack.emplace_back(child, 0);
+  }
+
+  return ret_val;
+}
+
+// size: side of the square forest
+std::string day8(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t row = 0; row < t_params.size_; ++row) {
+    for (std::size_t col = 0; col < t_params.size_; ++col) {
+      ret_val.push_back(rng.pick("0123456789"));
+    }
+
+    ret_val.push_back('\n');
+  }
+
+  return ret_val;
+}
+
+// size: number of motions
+std::string day9(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    auto const direction = rng.pick("UDLR");
+    fmt::format_to(std::back_inserter(ret_val), "{} {}\n", direction, rng.uniform(1, 20));
+  }
+
+  return ret_val;
+}
+
+// size: number of instructions, at least as many as needed to cover the 240 cycles of the screen
+std::string day10(Params const& t_params) {
+  static constexpr std::size_t CYCLES = 240;
+
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  std::size_t cycles = 0;
+  for (std::size_t i = 0; i < t_params.size_ or cycles < CYCLES; ++i) {
+    if (rng.chance(0.3)) {
+      ret_val += "noop\n";
+      ++cycles;
+    } else {
+      fmt::format_to(std::back_inserter(ret_val), "addx {}\n", rng.uniform(-10, 10));
+      cycles += 2;
+    }
+  }
+
+  return ret_val;
+}
+
+// size: number of items. Always 8 monkeys testing distinct primes (their product has to fit the 64 bit worry levels
+// of part 2). There is no "old * old": part 1 doesn't reduce the worry levels and squaring them overflows
+std::string day11(Params const& t_params) {
+  static constexpr std::size_t MONKEYS = 8;
+
+  Rng rng{t_params.seed_};
+  std::array primes{2, 3, 5, 7, 11, 13, 17, 19, 23};
+  rng.shuffle(std::span{primes});
+
+  std::array<std::vector<int>, MONKEYS> items;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    items[rng.uniform<std::size_t>(0, MONKEYS - 1)].push_back(rng.uniform(50, 99));
+  }
+
+  std::array<bool, MONKEYS> multiplies{true, true, true};  // the others add
+  rng.shuffle(std::span{multiplies});
+
+  std::string ret_val;
+  auto out = std::back_inserter(ret_val);
+  for (std::size_t monkey = 0; monkey < MONKEYS; ++monkey) {
+    auto const if_true  = (monkey + rng.uniform<std::size_t>(1, MONKEYS - 1)) % MONKEYS;
+    auto if_false       = (monkey + rng.uniform<std::size_t>(1, MONKEYS - 1)) % MONKEYS;
+    while (if_false == if_true) {
+      if_false = (monkey + rng.uniform<std::size_t>(1, MONKEYS - 1)) % MONKEYS;
+    }
+
+    fmt::format_to(out, "{}Monkey {}:\n", monkey == 0 ? "" : "\n", monkey);
+    fmt::format_to(out, "  Starting items: {}\n", fmt::join(items[monkey], ", "));
+    fmt::format_to(out, "  Operation: new = old {} {}\n", multiplies[monkey] ? '*' : '+',
+                   multiplies[monkey] ? rng.uniform(2, 7) : rng.uniform(1, 8));
+    fmt::format_to(out, "  Test: divisible by {}\n", primes[monkey]);
+    fmt::format_to(out, "    If true: throw to monkey {}\n", if_true);
+    fmt::format_to(out, "    If false: throw to monkey {}\n", if_false);
+  }
+
+  return ret_val;
+}
+
+// size: number of rows, width: number of columns (default 4 times the rows). S is the top left corner, E the bottom
+// right one and a random staircase between them climbs from a to z, hence there is always a path
+std::string day12(Params const& t_params) {
+  static constexpr std::size_t CLIMB = 'z' - 'a';
+
+  Rng rng{t_params.seed_};
+  auto const rows = std::max<std::size_t>(t_params.size_, 2);
+  auto const cols = std::max({t_params.width_ == 0 ? 4 * rows : t_params.width_, CLIMB + 2 - rows, std::size_t{2}});
+
+  std::vector<std::string> map(rows, std::string(cols, 'a'));
+  for (auto& row : map) {
+    for (auto& cell : row) {
+      cell = rng.chance(0.6) ? rng.pick("abc") : rng.pick(LOWERCASE);
+    }
+  }
+
+  auto const length = rows + cols - 2;
+  std::size_t row   = 0;
+  std::size_t col   = 0;
+  for (std::size_t step = 0; step <= length; ++step) {
+    map[row][col] = static_cast<char>('a' + step * CLIMB / length);
+    if (row + 1 < rows and (col + 1 == cols or rng.chance(0.5))) {
+      ++row;
+    } else {
+      ++col;
+    }
+  }
+
+  map.front().front() = 'S';
+  map.back().back()   = 'E';
+
+  std::string ret_val;
+  for (auto const& line : map) {
+    ret_val += line + '\n';
+  }
+
+  return ret_val;
+}
+
+void append_packet(Rng& t_rng, std::string& t_out, int const t_depth) {
+  t_out.push_back('[');
+  for (auto i = t_rng.uniform(0, 4); i > 0; --i) {
+    if (t_depth < 4 and t_rng.chance(0.3)) {
+      append_packet(t_rng, t_out, t_depth + 1);
+    } else {
+      t_out += std::to_string(t_rng.uniform(0, 10));
+    }
+
+    t_out += i == 1 ? "" : ",";
+  }
+
+  t_out.push_back(']');
+}
+
+// size: number of pairs of packets
+std::string day13(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    ret_val += i == 0 ? "" : "\n";
+    for (auto j = 0; j < 2; ++j) {
+      append_packet(rng, ret_val, 0);
+      ret_val.push_back('\n');
+    }
+  }
+
+  return ret_val;
+}
+
+// size: number of rock paths, spread over a cave as deep as 20 + size and twice as wide around the source of the sand.
+// The first one is the deepest, right under the source, so that the cave spans it
+std::string day14(Params const& t_params) {
+  static constexpr int SOURCE = 500;
+
+  Rng rng{t_params.seed_};
+  auto const depth = 20 + static_cast<int>(std::min<std::size_t>(t_params.size_, 100'000));
+
+  std::string ret_val = fmt::format("{},{} -> {},{}\n", SOURCE - 3, depth, SOURCE + 3, depth);
+  auto out            = std::back_inserter(ret_val);
+  for (std::size_t i = 1; i < t_params.size_; ++i) {
+    auto x = rng.uniform(SOURCE - depth, SOURCE + depth);
+    auto y = rng.uniform(10, depth);
+    fmt::format_to(out, "{},{}", x, y);
+    for (auto [points, horizontal] = std::pair{rng.uniform(1, 4), rng.chance(0.5)}; points > 0;
+         --points, horizontal = not horizontal) {
+      auto const length = rng.uniform(1, 6);
+      (horizontal ? x : y) += rng.chance(0.5) ? length : -length;
+      y = std::clamp(y, 10, depth);
+      fmt::format_to(out, " -> {},{}", x, y);
+    }
+
+    ret_val.push_back('\n');
+  }
+
+  return ret_val;
+}
+
+struct Diamond {
+  std::int64_t x_;
+  std::int64_t y_;
+  std::int64_t radius_;
+};
+
+// the cells of [0, t_limit]^2 no diamond covers, as many as there are (the last of them in t_last). Row after row, but
+// the rows the diamonds still cover once shrunk by m (each of their rows is one cell narrower than the one before at
+// most) are the m next ones, which are skipped, so that it only looks at a few rows per diamond
+std::int64_t count_uncovered(std::vector<Diamond> const& t_diamonds, std::int64_t const t_limit,
+                             std::pair<std::int64_t, std::int64_t>& t_last) {
+  std::vector<std::pair<std::int64_t, std::int64_t>> row_ranges;
+
+  // the cells of [0, t_limit] the ranges shrunk by t_shrink leave out, the last of them in t_gap
+  auto const uncovered = [&](std::int64_t const t_shrink, std::int64_t& t_gap) {
+    std::int64_t ret_val = 0;
+    std::int64_t reach   = -1;
+    for (auto const& [min_x, max_x] : row_ranges) {
+      if (min_x + t_shrink > max_x - t_shrink) {
+        continue;
+      }
+
+      if (auto const gap_end = std::min(min_x + t_shrink - 1, t_limit); gap_end > reach) {
+        ret_val += gap_end - reach;
+        t_gap = gap_end;
+      }
+
+      reach = std::max(reach, max_x - t_shrink);
+    }
+
+    if (reach < t_limit) {
+      ret_val += t_limit - reach;
+      t_gap = t_limit;
+    }
+
+    return ret_val;
+  };
+
+  std::int64_t ret_val = 0;
+  for (std::int64_t y = 0; y <= t_limit;) {
+    row_ranges.clear();
+    for (auto const& [x, sensor_y, radius] : t_diamonds) {
+      if (auto const half = radius - std::abs(y - sensor_y); half >= 0) {
+        row_ranges.emplace_back(x - half, x + half);
+      }
+    }
+
+    std::ranges::sort(row_ranges);
+
+    std::int64_t gap = 0;
+    if (auto const cells = uncovered(0, gap); cells != 0) {
+      ret_val += cells;
+      t_last = {gap, y};
+      ++y;
+      continue;
+    }
+
+    // the largest shrink that still covers the row
+    std::int64_t shrink = 0;
+    for (auto step = std::bit_floor(static_cast<std::uint64_t>(t_limit) + 1); step != 0; step /= 2) {
+      if (uncovered(shrink + static_cast<std::int64_t>(step), gap) == 0) {
+        shrink += static_cast<std::int64_t>(step);
+      }
+    }
+
+    y += shrink + 1;
+  }
+
+  return ret_val;
+}
+
+// size: number of sensors, about. A grid of sensors covers the 4M square, each a diamond around a tile of the grid, but
+// the hidden beacon: the tiles whose sensor would reach it are left out, and 4 sensors around it, one in every
+// diagonal direction, reach right next to it and cover the tiles left out. It is then the only cell of the square no
+// sensor covers, which is checked
+std::string day15(Params const& t_params) {
+  static constexpr std::int64_t LIMIT = 4'000'000;
+
+  Rng rng{t_params.seed_};
+  auto const hidden_x = rng.uniform<std::int64_t>(0, LIMIT);
+  auto const hidden_y = rng.uniform<std::int64_t>(0, LIMIT);
+
+  // tiles of an even side, the sensor in the middle of one covers it whole with a radius of side
+  auto tiles = std::int64_t{1};
+  while ((tiles + 1) * (tiles + 1) + 4 <= static_cast<std::int64_t>(t_params.size_)) {
+    ++tiles;
+  }
+
+  auto const side = ((LIMIT + tiles) / tiles + 1) / 2 * 2;
+
+  std::vector<Diamond> sensors;
+  std::vector<std::pair<std::int64_t, std::int64_t>> beacons;
+  for (std::int64_t i = 0; i < tiles; ++i) {
+    for (std::int64_t j = 0; j < tiles; ++j) {
+      auto const x = i * side + side / 2;
+      auto const y = j * side + side / 2;
+      if (std::abs(x - hidden_x) + std::abs(y - hidden_y) > side) {
+        sensors.push_back({.x_ = x, .y_ = y, .radius_ = side});
+        auto const corner_x = rng.chance(0.5) ? side / 2 : -side / 2;
+        auto const corner_y = rng.chance(0.5) ? side / 2 : -side / 2;
+        beacons.emplace_back(x + corner_x, y + corner_y);  // a corner of the tile
+      }
+    }
+  }
+
+  // the tiles left out are within side + side / 2 of the hidden beacon, every cell of that box but the beacon is within
+  // 2 * offset - 1 of one of the 4 sensors
+  auto const offset = side + side / 2 + 1;
+  auto const radius = 2 * offset - 1;
+  using Direction = std::pair<std::int64_t, std::int64_t>;
+  for (auto const& [dx, dy] : std::array<Direction, 4>{{{-1, -1}, {1, -1}, {-1, 1}, {1, 1}}}) {
+    auto const x = hidden_x + dx * offset;
+    auto const y = hidden_y + dy * offset;
+    sensors.push_back({.x_ = x, .y_ = y, .radius_ = radius});
+    beacons.emplace_back(x + dx * radius, y);
+  }
+
+  std::pair<std::int64_t, std::int64_t> uncovered;
+  if (count_uncovered(sensors, LIMIT, uncovered) != 1 or uncovered != std::pair{hidden_x, hidden_y}) {
+    throw std::logic_error("2022 day 15: the sensors don't leave exactly the hidden beacon uncovered");
+  }
+
+  std::vector<std::size_t> order(sensors.size());
+  std::iota(order.begin(), order.end(), 0);
+  rng.shuffle(std::span{order});
+
+  std::string ret_val;
+  for (auto const i : order) {
+    fmt::format_to(std::back_inserter(ret_val), "Sensor at x={}, y={}: closest beacon is at x={}, y={}\n",
+                   sensors[i].x_, sensors[i].y_, beacons[i].first, beacons[i].second);
+  }
+
+  return ret_val;
+}
+
+// size: number of valves, at most 64 (they are a bit set in a 64 bit word). density: ratio of valves with a flow rate
+// (default 0.25, about 15 of the real 60), part 2 pairs every plan of the two of them hence grows fast with it
+std::string day16(Params const& t_params) {
+  static constexpr std::size_t MAX_VALVES = 64;
+
+  Rng rng{t_params.seed_};
+  auto const valves = std::clamp<std::size_t>(t_params.size_, 2, MAX_VALVES);
+
+  std::set<std::string> used{"AA"};
+  std::vector<std::string> names{"AA"};
+  while (names.size() < valves) {
+    if (auto name = std::string{rng.pick(UPPERCASE), rng.pick(UPPERCASE)}; used.insert(name).second) {
+      names.push_back(std::move(name));
+    }
+  }
+
+  std::vector<std::set<std::size_t>> tunnels(valves);
+  auto const connect = [&](std::size_t const t_from, std::size_t const t_to) {
+    tunnels[t_from].insert(t_to);
+    tunnels[t_to].insert(t_from);
+  };
+
+  for (std::size_t valve = 1; valve < valves; ++valve) {  // a random tree, to be connected
+    connect(valve, rng.uniform<std::size_t>(0, valve - 1));
+  }
+  for (std::size_t i = 0; i < valves / 2; ++i) {
+    auto const from = rng.uniform<std::size_t>(0, valves - 1);
+    auto const to   = rng.uniform<std::size_t>(0, valves - 1);
+    if (from != to) {
+      connect(from, to);
+    }
+  }
+
+  std::vector<std::size_t> order(valves - 1);  // AA never has a flow rate
+  std::iota(order.begin(), order.end(), std::size_t{1});
+  rng.shuffle(std::span{order});
+
+  auto const with_flow = std::clamp<std::size_t>(
+    static_cast<std::size_t>(density_or(t_params, 0.25) * static_cast<double>(valves) + 0.5), 1, valves - 1);
+  std::vector<int> flow(valves, 0);
+  for (std::size_t i = 0; i < with_flow; ++i) {
+    flow[order[i]] = rng.uniform(3, 25);
+  }
+
+  std::string ret_val;
+  for (std::size_t valve = 0; valve < valves; ++valve) {
+    std::vector<std::string_view> next;
+    for (auto const other : tunnels[valve]) {
+      next.emplace_back(names[other]);
+    }
+    rng.shuffle(std::span{next});
+
+    auto const plural = next.size() > 1;
+    fmt::format_to(std::back_inserter(ret_val), "Valve {} has flow rate={}; {} {} to {} {}\n", names[valve],
+                   flow[valve], plural ? "tunnels" : "tunnel", plural ? "lead" : "leads",
+                   plural ? "valves" : "valve", fmt::join(next, ", "));
+  }
+
+  return ret_val;
+}
+
+// size: length of the jet pattern
+std::string day17(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < std::max<std::size_t>(t_params.size_, 1); ++i) {
+    ret_val.push_back(rng.pick("<>"));
+  }
+
+  return ret_val + '\n';
+}
+
+// size: side of the cube the droplet is in, density: ratio of filled cubes (default 0.35). The flood fill of part 2
+// starts at the smallest coordinates, (1, 1, 1) is kept empty and the cubes on the other corners pin them to 1
+std::string day18(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  auto const side    = static_cast<int>(std::clamp<std::size_t>(t_params.size_, 2, 1000));
+  auto const density = density_or(t_params, 0.35);
+
+  std::string ret_val;
+  auto out = std::back_inserter(ret_val);
+  fmt::format_to(out, "1,{0},{0}\n{0},1,{0}\n{0},{0},1\n", side);
+  for (auto x = 1; x <= side; ++x) {
+    for (auto y = 1; y <= side; ++y) {
+      for (auto z = 1; z <= side; ++z) {
+        auto const is_start  = x == 1 and y == 1 and z == 1;
+        auto const is_pinned = (x == 1 and y == side and z == side) or (x == side and y == 1 and z == side) or
+                               (x == side and y == side and z == 1);
+        if (not is_start and not is_pinned and rng.chance(density)) {
+          fmt::format_to(out, "{},{},{}\n", x, y, z);
+        }
+      }
+    }
+  }
+
+  return ret_val;
+}
+
+// size: number of blueprints, at least the 3 of part 2. The costs are in the ranges of the real ones
+std::string day19(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 1; i <= std::max<std::size_t>(t_params.size_, 3); ++i) {
+    std::array const costs{rng.uniform(2, 4), rng.uniform(2, 4), rng.uniform(2, 4),
+                           rng.uniform(5, 20), rng.uniform(2, 4), rng.uniform(5, 20)};
+    fmt::format_to(std::back_inserter(ret_val),
+                   "Blueprint {}: Each ore robot costs {} ore. Each clay robot costs {} ore. Each obsidian robot "
+                   "costs {} ore and {} clay. Each geode robot costs {} ore and {} obsidian.\n",
+                   i, costs[0], costs[1], costs[2], costs[3], costs[4], costs[5]);
+  }
+
+  return ret_val;
+}
+
+// size: number of numbers, exactly one of them is 0
+std::string day20(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  auto const count = std::max<std::size_t>(t_params.size_, 2);
+  auto const zero  = rng.uniform<std::size_t>(0, count - 1);
+
+  std::string ret_val;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto number = 0;
+    while (i != zero and number == 0) {
+      number = rng.uniform(-9999, 9999);
+    }
+
+    fmt::format_to(std::back_inserter(ret_val), "{}\n", number);
+  }
+
+  return ret_val;
+}
+
+// size: number of monkeys. The expression tree is grown top down from the value of root, so that every operation is
+// exact, and humn is a leaf that is never (part of) a divisor, hence root is linear in humn
+std::string day21(Params const& t_params) {
+  static constexpr std::int64_t MAX_DIVIDEND = 1'000'000'000;
+
+  struct Monkey {
+    std::int64_t value_;
+    char operation_ = 0;  // 0 for a number
+    std::size_t lhs_ = 0;
+    std::size_t rhs_ = 0;
+    bool in_divisor_ = false;
+  };
+
+  Rng rng{t_params.seed_};
+  std::vector<Monkey> monkeys{{.value_ = rng.uniform<std::int64_t>(1'000'000, MAX_DIVIDEND)}};
+  std::vector<std::size_t> leaves{0};
+  while (monkeys.size() + 2 <= std::max<std::size_t>(t_params.size_, 3)) {
+    auto const leaf_idx = rng.uniform<std::size_t>(0, leaves.size() - 1);
+    auto const parent   = leaves[leaf_idx];
+    auto const value    = monkeys[parent].value_;
+
+    std::int64_t lhs = 0;
+    std::int64_t rhs = 0;
+    auto operation   = rng.pick("+-*/");
+    if (auto const divisor = rng.uniform<std::int64_t>(2, 20); operation == '*' and value % divisor == 0) {
+      lhs = value / divisor;
+      rhs = divisor;
+    } else if (operation == '/' and value < MAX_DIVIDEND) {
+      lhs = value * divisor;
+      rhs = divisor;
+    } else if (operation != '-' and value >= 2) {
+      operation = '+';
+      lhs       = rng.uniform<std::int64_t>(1, value - 1);
+      rhs       = value - lhs;
+    } else {
+      operation = '-';
+      rhs       = rng.uniform<std::int64_t>(1, 100);
+      lhs       = value + rhs;
+    }
+
+    auto const in_divisor = monkeys[parent].in_divisor_;
+    monkeys[parent].operation_ = operation;
+    monkeys[parent].lhs_       = monkeys.size();
+    monkeys[parent].rhs_       = monkeys.size() + 1;
+    monkeys.push_back({.value_ = lhs, .in_divisor_ = in_divisor});
+    monkeys.push_back({.value_ = rhs, .in_divisor_ = in_divisor or operation == '/'});
+
+    leaves[leaf_idx] = monkeys.size() - 2;
+    leaves.push_back(monkeys.size() - 1);
+  }
+
+  // the left most leaf is never in a divisor, there is always a candidate
+  std::vector<std::size_t> candidates;
+  std::ranges::copy_if(leaves, std::back_inserter(candidates),
+                       [&](std::size_t const t_leaf) { return not monkeys[t_leaf].in_divisor_; });
+  auto const humn = candidates[rng.uniform<std::size_t>(0, candidates.size() - 1)];
+
+  std::set<std::string> used{"root", "humn"};
+  std::vector<std::string> names(monkeys.size());
+  for (std::size_t i = 0; i < monkeys.size(); ++i) {
+    while (i != 0 and i != humn and names[i].empty()) {
+      if (auto name = std::string{rng.pick(LOWERCASE), rng.pick(LOWERCASE), rng.pick(LOWERCASE), rng.pick(LOWERCASE)};
+          used.insert(name).second) {
+        names[i] = std::move(name);
+      }
+    }
+  }
+  names[0]    = "root";
+  names[humn] = "humn";
+
+  std::vector<std::string> lines;
+  lines.reserve(monkeys.size());
+  for (std::size_t i = 0; i < monkeys.size(); ++i) {
+    auto const& monkey = monkeys[i];
+    lines.push_back(monkey.operation_ == 0
+                      ? fmt::format("{}: {}\n", names[i], monkey.value_)
+                      : fmt::format("{}: {} {} {}\n", names[i], names[monkey.lhs_], monkey.operation_,
+                                    names[monkey.rhs_]));
+  }
+  rng.shuffle(std::span{lines});
+
+  std::string ret_val;
+  for (auto const& line : lines) {
+    ret_val += line;
+  }
+
+  return ret_val;
+}
+
+// size: length of a face of the cube (real one is 50). The net is the one the solution folds:
+//
+//      .AB
+//      .C.
+//      DE.
+//      F..
+//
+// about 10% of the tiles are walls and the path has about 40 moves per tile of a face side
+std::string day22(Params const& t_params) {
+  static constexpr std::array<std::string_view, 4> NET{".##", ".#.", "##.", "#.."};
+
+  Rng rng{t_params.seed_};
+  auto const face = std::clamp<std::size_t>(t_params.size_, 4, 10'000);
+
+  std::string ret_val;
+  for (std::size_t row = 0; row < NET.size() * face; ++row) {
+    auto const net_row = NET[row / face];
+    for (std::size_t col = 0; col < net_row.find_last_of('#') * face + face; ++col) {
+      if (net_row[col / face] == '.') {
+        ret_val.push_back(' ');
+      } else {
+        ret_val.push_back(row == 0 and col == face ? '.' : (rng.chance(0.1) ? '#' : '.'));  // the start is open
+      }
+    }
+
+    ret_val.push_back('\n');
+  }
+
+  ret_val += '\n' + std::to_string(rng.uniform(1, 50));
+  for (std::size_t i = 0; i < 40 * face; ++i) {
+    ret_val.push_back(rng.pick("LR"));
+    ret_val += std::to_string(rng.uniform(1, 50));
+  }
+
+  return ret_val + '\n';
+}
+
+// size: side of the square grove, density: ratio of elves (default 0.5)
+std::string day23(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  auto const density = density_or(t_params, 0.5);
+
+  std::string ret_val;
+  for (std::size_t row = 0; row < std::max<std::size_t>(t_params.size_, 1); ++row) {
+    for (std::size_t col = 0; col < std::max<std::size_t>(t_params.size_, 1); ++col) {
+      ret_val.push_back(rng.chance(density) ? '#' : '.');
+    }
+
+    ret_val.push_back('\n');
+  }
+
+  return ret_val;
+}
+
+// size: rows of the valley (without its walls), width: columns (default 3 times the rows), density: ratio of blizzards
+// (default 0.8, the real one is about 0.9). Like in the real one, no blizzard moves up or down in the columns of the
+// entrance and exit
+std::string day24(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  auto const rows    = std::max<std::size_t>(t_params.size_, 2);
+  auto const cols    = std::max<std::size_t>(t_params.width_ == 0 ? 3 * rows : t_params.width_, 3);
+  auto const density = density_or(t_params, 0.8);
+
+  std::string ret_val = "#." + std::string(cols, '#') + '\n';
+  for (std::size_t row = 0; row < rows; ++row) {
+    ret_val.push_back('#');
+    for (std::size_t col = 0; col < cols; ++col) {
+      auto const horizontal_only = col == 0 or col + 1 == cols;
+      ret_val.push_back(not rng.chance(density) ? '.' : (horizontal_only ? rng.pick("<>") : rng.pick("<>^v")));
+    }
+
+    ret_val += "#\n";
+  }
+
+  return ret_val + std::string(cols, '#') + ".#\n";
+}
+
+// size: number of SNAFU numbers, of at most 20 digits like the real ones
+std::string day25(Params const& t_params) {
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < std::max<std::size_t>(t_params.size_, 1); ++i) {
+    ret_val.push_back(rng.pick("12"));
+    for (auto digits = rng.uniform(0, 19); digits > 0; --digits) {
+      ret_val.push_back(rng.pick("=-012"));
+    }
+
+    ret_val.push_back('\n');
+  }
+
+  return ret_val;
+}
+
+constexpr std::array GENERATORS{
+  aoc::gen::Generator{2022, 1, "number of elves", day1},
+  aoc::gen::Generator{2022, 2, "number of rounds", day2},
+  aoc::gen::Generator{2022, 3, "number of groups of three rucksacks", day3},
+  aoc::gen::Generator{2022, 4, "number of pairs", day4},
+  aoc::gen::Generator{2022, 5, "number of moves", day5},
+  aoc::gen::Generator{2022, 6, "length of the signal", day6},
+  aoc::gen::Generator{2022, 7, "number of directories", day7},
+  aoc::gen::Generator{2022, 8, "side of the forest", day8},
+  aoc::gen::Generator{2022, 9, "number of motions", day9},
+  aoc::gen::Generator{2022, 10, "number of instructions", day10},
+  aoc::gen::Generator{2022, 11, "number of items", day11},
+  aoc::gen::Generator{2022, 12, "rows of the height map", day12},
+  aoc::gen::Generator{2022, 13, "number of pairs of packets", day13},
+  aoc::gen::Generator{2022, 14, "number of rock paths", day14},
+  aoc::gen::Generator{2022, 15, "number of sensors", day15},
+  aoc::gen::Generator{2022, 16, "number of valves", day16},
+  aoc::gen::Generator{2022, 17, "length of the jet pattern", day17},
+  aoc::gen::Generator{2022, 18, "side of the droplet", day18},
+  aoc::gen::Generator{2022, 19, "number of blueprints", day19},
+  aoc::gen::Generator{2022, 20, "number of numbers", day20},
+  aoc::gen::Generator{2022, 21, "number of monkeys", day21},
+  aoc::gen::Generator{2022, 22, "side of a face of the cube", day22},
+  aoc::gen::Generator{2022, 23, "side of the grove", day23},
+  aoc::gen::Generator{2022, 24, "rows of the valley", day24},
+  aoc::gen::Generator{2022, 25, "number of SNAFU numbers", day25},
+};
+
+}  // namespace
+
+namespace aoc::gen::detail {
+
+std::span<Generator const> generators_2022() noexcept { return GENERATORS; }
+
+}  // namespace aoc::gen::detail
@@ -0,0 +1,144 @@
+#include "input_gen.hpp"
+#include "years.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using aoc::gen::Params;
+using aoc::gen::Rng;
+
+// size: number of lines, every line has at least one digit
+std::string day1(Params const& t_params) {
+  static constexpr std::array<std::string_view, 9> SPELLED{"one", "two",   "three", "four", "five",
+                                                           "six", "seven", "eight", "nine"};
+
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  for (std::size_t i = 0; i < t_params.size_; ++i) {
+    std::string line;
+    for (auto tokens = rng.uniform(1, 12); tokens > 0; --tokens) {
+      if (rng.chance(0.2)) {
+        line.push_back(rng.pick("123456789"));
+      } else if (rng.chance(0.2)) {
+        line += rng.pick(std::span{SPELLED});
+      } else {
+        line.push_back(rng.pick("abcdefghijklmnopqrstuvwxyz"));
+      }
+    }
+
+    if (std::ranges::none_of(line, [](char const t_chr) { return t_chr >= '1' and t_chr <= '9'; })) {
+      line.insert(rng.uniform<std::size_t>(0, line.size()), 1, rng.pick("123456789"));
+    }
+
+    ret_val += line + '\n';
+  }
+
+  return ret_val;
+}
+
+// size: number of games
+std::string day2(Params const& t_params) {
+  static constexpr std::array<std::string_view, 3> COLORS{"red", "green", "blue"};
+
+  Rng rng{t_params.seed_};
+  std::string ret_val;
+  auto out = std::back_inserter(ret_val);
+  for (std::size_t game = 1; game <= t_params.size_; ++game) {
+    fmt::format_to(out, "Game {}: ", game);
+    for (auto sets = rng.uniform(1, 6); sets > 0; --sets) {
+      auto colors = COLORS;
+      rng.shuffle(std::span{colors});
+      for (auto count = rng.uniform<std::size_t>(1, colors.size()); count > 0; --count) {
+        fmt::format_to(out, "{} {}{}", rng.uniform(1, 20), colors[count - 1], count == 1 ? "" : ", ");
+      }
+
+      ret_val += sets == 1 ? "\n" : "; ";
+    }
+  }
+
+  return ret_val;
+}
+
+// size: side of the square schematic, with numbers of 1 to 3 digits, symbols and gears
+std::string day3(Params const& t_params) {
+  static constexpr std::array<std::pair<int, int>, 3> BOUNDS{{{1, 9}, {10, 99}, {100, 999}}};  // per number of digits
+
+  Rng rng{t_params.seed_};
+  auto const side = std::max<std::size_t>(t_params.size_, 3);
+
+  std::string ret_val;
+  for (std::size_t row = 0; row < side; ++row) {
+    std::string line;
+    while (line.size() < side) {
+      if (auto const digits = rng.uniform<std::size_t>(1, 3); rng.chance(0.25) and line.size() + digits <= side) {
+        auto const [low, high] = BOUNDS[digits - 1];
+        line += std::to_string(rng.uniform(low, high));
+        line += line.size() < side ? "." : "";
+      } else if (rng.chance(0.1)) {
+        line.push_back(rng.pick("**#+$/@%&="));
+      } else {
+        line.push_back('.');
+      }
+    }
+
+    ret_val += line + '\n';
+  }
+
+  return ret_val;
+}
+
+// size: number of cards. A card never wins more copies than there are cards after it
+std::string day4(Params const& t_params) {
+  static constexpr std::size_t WINNING = 10;
+  static constexpr std::size_t HAVE    = 25;
+
+  Rng rng{t_params.seed_};
+  std::array<int, 99> numbers{};
+  std::iota(numbers.begin(), numbers.end(), 1);
+
+  std::string ret_val;
+  auto out = std::back_inserter(ret_val);
+  for (std::size_t card = 1; card <= t_params.size_; ++card) {
+    rng.shuffle(std::span{numbers});
+    auto const matches = std::min(rng.uniform<std::size_t>(0, WINNING), t_params.size_ - card);
+
+    // the first numbers are the winning ones, a card has the first matches of them then only losing ones
+    auto const winning = std::span{numbers}.first(WINNING);
+    auto const losing  = std::span{numbers}.subspan(WINNING, HAVE - matches);
+
+    std::vector<int> have(winning.begin(), winning.begin() + static_cast<std::ptrdiff_t>(matches));
+    have.insert(have.end(), losing.begin(), losing.end());
+    rng.shuffle(std::span{have});
+
+    fmt::format_to(out, "Card {:>3}: {:>2} | {:>2}\n", card, fmt::join(winning, " "), fmt::join(have, " "));
+  }
+
+  return ret_val;
+}
+
+constexpr std::array GENERATORS{
+  aoc::gen::Generator{2023, 1, "number of lines", day1},
+  aoc::gen::Generator{2023, 2, "number of games", day2},
+  aoc::gen::Generator{2023, 3, "side of the schematic", day3},
+  aoc::gen::Generator{2023, 4, "number of cards", day4},
+};
+
+}  // namespace
+
+namespace aoc::gen::detail {
+
+std::span<Generator const> generators_2023() noexcept { return GENERATORS; }
+
+}  // namespace aoc::gen::detail
@@ -0,0 +1,49 @@
+#include "input_gen.hpp"
+#include "years.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace aoc::gen {
+
+std::span<Generator const> generators() noexcept {
+  static std::vector<Generator> const all = [] {
+    std::vector<Generator> ret_val;
+    for (auto const year : {detail::generators_2022(), detail::generators_2023()}) {
+      ret_val.insert(ret_val.end(), year.begin(), year.end());
+    }
+
+    return ret_val;
+  }();
+
+  return all;
+}
+
+Generator const* find_generator(int const t_year, int const t_day) noexcept {
+  auto const all   = generators();
+  auto const found = std::ranges::find_if(
+    all, [=](Generator const& t_generator) { return t_generator.year_ == t_year and t_generator.day_ == t_day; });
+  return found == all.end() ? nullptr : &*found;
+}
+
+std::filesystem::path write_input(Generator const& t_generator, Params const& t_params,
+                                  std::filesystem::path const& t_dir) {
+  auto ret_val = t_dir / std::to_string(t_generator.year_) / fmt::format("day{}.txt", t_generator.day_);
+  std::filesystem::create_directories(ret_val.parent_path());
+
+  std::ofstream out{ret_val, std::ios::binary};
+  out << t_generator.generate_(t_params);
+  if (not out.flush()) {
+    throw std::system_error(errno, std::generic_category(), ret_val.string());
+  }
+
+  return ret_val;
+}
+
+}  // namespace aoc::gen
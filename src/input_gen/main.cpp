@@ -0,0 +1,155 @@
+#include "input_gen.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Writes seeded, size parameterised inputs (see input_gen.hpp)
+//
+//    input_gen --list
+//        list the days with a generator and what their size is
+//
+//    input_gen [--year <year>] [--day <day>] --size <n> [--seed <s>] [--width <w>] [--density <d>]
+//              [--output-dir <dir>]
+//        without --output-dir, write the input of the single selected day to stdout. With it, write the input of every
+//        selected day to <dir>/<year>/day<day>.txt, for the --input-dir of the runner and of the benchmarks
+namespace {
+
+struct Options {
+  bool list_ = false;
+  std::optional<int> year_;
+  std::optional<int> day_;
+  std::optional<std::string_view> output_dir_;
+  aoc::gen::Params params_{.size_ = 0};
+  bool has_size_ = false;
+};
+
+constexpr std::string_view USAGE = "--list | [--year <year>] [--day <day>] --size <n> [--seed <s>] [--width <w>] "
+                                   "[--density <d>] [--output-dir <dir>]";
+
+template <typename T>
+[[nodiscard]] std::optional<T> to_number(std::string_view const t_str) noexcept {
+  T ret_val{};
+  auto const* const end = t_str.data() + t_str.size();
+  if (auto const [ptr, ec] = std::from_chars(t_str.data(), end, ret_val); ec != std::errc() or ptr != end) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+[[nodiscard]] std::optional<Options> parse_options(std::span<char* const> const t_args) {
+  using namespace std::string_view_literals;
+
+  Options ret_val;
+  for (std::size_t i = 1; i < t_args.size(); ++i) {
+    auto const arg = std::string_view{t_args[i]};
+    if (arg == "--list"sv) {
+      ret_val.list_ = true;
+      continue;
+    }
+
+    if (i + 1 == t_args.size()) {
+      return std::nullopt;
+    }
+
+    auto const value = std::string_view{t_args[++i]};
+    auto parsed      = true;
+    if (arg == "--year"sv) {
+      ret_val.year_ = to_number<int>(value);
+      parsed        = ret_val.year_.has_value();
+    } else if (arg == "--day"sv) {
+      ret_val.day_ = to_number<int>(value);
+      parsed       = ret_val.day_.has_value();
+    } else if (arg == "--size"sv) {
+      auto const size       = to_number<std::size_t>(value);
+      ret_val.params_.size_ = size.value_or(0);
+      ret_val.has_size_     = size.has_value();
+      parsed                = size.has_value();
+    } else if (arg == "--seed"sv) {
+      auto const seed       = to_number<std::uint64_t>(value);
+      ret_val.params_.seed_ = seed.value_or(0);
+      parsed                = seed.has_value();
+    } else if (arg == "--width"sv) {
+      auto const width       = to_number<std::size_t>(value);
+      ret_val.params_.width_ = width.value_or(0);
+      parsed                 = width.has_value();
+    } else if (arg == "--density"sv) {
+      auto const density       = to_number<double>(value);
+      ret_val.params_.density_ = density.value_or(0);
+      parsed                   = density.has_value() and *density >= 0 and *density <= 1;
+    } else if (arg == "--output-dir"sv) {
+      ret_val.output_dir_ = value;
+    } else {
+      return std::nullopt;
+    }
+
+    if (not parsed) {
+      return std::nullopt;
+    }
+  }
+
+  return ret_val.list_ or ret_val.has_size_ ? std::optional{ret_val} : std::nullopt;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto const args    = std::span(argv, static_cast<std::size_t>(argc));
+  auto const options = parse_options(args);
+  if (not options) {
+    fmt::println(stderr, "usage: {} {}", args[0], USAGE);
+    return EXIT_FAILURE;
+  }
+
+  if (options->list_) {
+    for (auto const& generator : aoc::gen::generators()) {
+      fmt::println("{} day {:>2}  size: {}", generator.year_, generator.day_, generator.size_);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  std::vector<aoc::gen::Generator const*> selected;
+  for (auto const& generator : aoc::gen::generators()) {
+    if ((not options->year_ or *options->year_ == generator.year_) and
+        (not options->day_ or *options->day_ == generator.day_)) {
+      selected.push_back(&generator);
+    }
+  }
+
+  if (selected.empty()) {
+    fmt::println(stderr, "no generator matches the given selectors");
+    return EXIT_FAILURE;
+  }
+
+  if (not options->output_dir_) {
+    if (selected.size() > 1) {
+      fmt::println(stderr, "{} days match, select a single one with --year and --day or use --output-dir",
+                   selected.size());
+      return EXIT_FAILURE;
+    }
+
+    fmt::print("{}", selected.front()->generate_(options->params_));
+    return EXIT_SUCCESS;
+  }
+
+  try {
+    for (auto const* const generator : selected) {
+      fmt::println("{}", aoc::gen::write_input(*generator, options->params_, *options->output_dir_).string());
+    }
+  } catch (std::system_error const& t_error) {
+    fmt::println(stderr, "unable to write the input: {}", t_error.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,16 @@
+#ifndef INPUT_GEN_YEARS_HPP_
+#define INPUT_GEN_YEARS_HPP_
+
+#include "input_gen.hpp"
+
+#include <span>
+
+// the generators of every year, each sorted by day, aggregated by aoc::gen::generators
+namespace aoc::gen::detail {
+
+[[nodiscard]] std::span<Generator const> generators_2022() noexcept;
+[[nodiscard]] std::span<Generator const> generators_2023() noexcept;
+
+}  // namespace aoc::gen::detail
+
+#endif
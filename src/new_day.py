@@ -8,36 +8,36 @@ PARSER = argparse.ArgumentParser()
 PARSER.add_argument('date')
 
 CMAKELIST_TEXT = '''\
-add_executable({date}_{day} {day}.cpp)
-target_link_libraries({date}_{day} PRIVATE advent_of_code project_option project_warning fmt::fmt)
-target_compile_definitions({date}_{day} PRIVATE INPUT_FILE="${{CMAKE_CURRENT_SOURCE_DIR}}/{day}.txt")
+add_solution(TARGET {date}_{day} YEAR {date} DAY {day_num} SOURCES {day}.cpp)
 '''
 
 TEMPLATE_CPP_FILE = '''\
-#include <fmt/format.h>
-#include <fstream>
+#include "registry.hpp"
+
+#include <istream>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/getlines.hpp>
+#include <string>
+#include <vector>
+
+namespace {{
 
-void part1() {
-  using ranges::getlines;
+struct Day{day_num} {{
+  using Parsed = std::vector<std::string>;
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
-}
+  static Parsed parse(std::istream& t_in) {{
+    using ranges::getlines, ranges::to_vector;
+    return getlines(t_in) | to_vector;
+  }}
 
-void part2() {
-  using ranges::getlines;
+  static int part1(Parsed const& /*t_input*/) {{ return 0; }}
 
-  std::fstream in((INPUT_FILE));
-  auto rng = getlines(in);
-}
+  static int part2(Parsed const& /*t_input*/) {{ return 0; }}
+}};
 
-int main(int /**/, char** /**/) {
-  part1();
-  part2();
+}}  // namespace
 
-  return EXIT_SUCCESS;
-}
+AOC_REGISTER({date}, {day_num}, Day{day_num});
 '''
 
 
@@ -49,7 +49,8 @@ def _main():
     days = [int(day[3:]) for day in dirs]
     days.sort()
 
-    new_day = 'day' + str((days[-1] if len(days) != 0 else 0) + 1)
+    new_day_num = (days[-1] if len(days) != 0 else 0) + 1
+    new_day = 'day' + str(new_day_num)
     new_day_dir = join(op_dir, new_day)
     makedirs(new_day_dir)
 
@@ -57,10 +58,10 @@ def _main():
         file.write(f'add_subdirectory({new_day})\n')
 
     with open(join(new_day_dir, 'CMakeLists.txt'), 'w', encoding='utf-8') as file:
-        file.write(CMAKELIST_TEXT.format(date=res.date, day=new_day))
+        file.write(CMAKELIST_TEXT.format(date=res.date, day=new_day, day_num=new_day_num))
 
     with open(join(new_day_dir, f'{new_day}.cpp'), 'w', encoding='utf-8') as file:
-        file.write(TEMPLATE_CPP_FILE)
+        file.write(TEMPLATE_CPP_FILE.format(date=res.date, day_num=new_day_num))
 
     with open(join(new_day_dir, f'{new_day}.txt'), 'w', encoding='utf-8') as file:
         file.write('')
@@ -0,0 +1,357 @@
+#include "arguments.hpp"
+#include "job_scheduler.hpp"
+#include "json.hpp"
+#include "registry.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <range/v3/algorithm/none_of.hpp>
+#include <range/v3/algorithm/sort.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/filter.hpp>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Ms    = std::chrono::duration<double, std::milli>;
+
+// options of the runner on top of the ones shared with the benchmarks (see arguments.hpp)
+//
+//    --all               run the selected days as independent jobs: the input of every day, then each of its parts,
+//                        on several threads and the longest first according to the timings of the previous runs, then
+//                        print a table of the results
+//    --jobs <n>          jobs running at the same time with --all (default: the hardware concurrency)
+//    --pin               pin the threads of the jobs to a core each
+//    --timings <path>    the timings of the previous --all runs, updated by every run (default aoc_timings.json)
+struct RunnerOptions {
+  bool all_ = false;
+  std::optional<std::size_t> jobs_;
+  bool pin_                 = false;
+  std::string_view timings_ = "aoc_timings.json";
+  std::vector<char*> remaining_;  // everything else, for aoc::parse_arguments
+};
+
+[[nodiscard]] std::optional<RunnerOptions> parse_runner_options(std::span<char* const> const t_args) {
+  using namespace std::string_view_literals;
+
+  RunnerOptions ret_val;
+  auto has_all_options = false;
+  ret_val.remaining_.push_back(t_args[0]);
+  for (std::size_t i = 1; i < t_args.size(); ++i) {
+    auto const arg = std::string_view{t_args[i]};
+    if (arg == "--all"sv) {
+      ret_val.all_ = true;
+      continue;
+    }
+
+    if (arg == "--pin"sv) {
+      ret_val.pin_ = has_all_options = true;
+      continue;
+    }
+
+    if (arg != "--jobs"sv and arg != "--timings"sv) {
+      ret_val.remaining_.push_back(t_args[i]);
+      continue;
+    }
+
+    if (i + 1 == t_args.size()) {
+      return std::nullopt;
+    }
+
+    has_all_options  = true;
+    auto const value = std::string_view{t_args[++i]};
+    if (arg == "--timings"sv) {
+      ret_val.timings_ = value;
+      continue;
+    }
+
+    std::size_t jobs = 0;
+    auto const* const value_end = value.data() + value.size();
+    if (auto const [ptr, ec] = std::from_chars(value.data(), value_end, jobs);
+        ec != std::errc() or ptr != value_end or jobs == 0) {
+      return std::nullopt;
+    }
+
+    ret_val.jobs_ = jobs;
+  }
+
+  if (has_all_options and not ret_val.all_) {
+    return std::nullopt;
+  }
+
+  return ret_val;
+}
+
+void print_usage(std::string_view const t_program) {
+  fmt::println(stderr, "usage: {} {} [--all [--jobs <n>] [--pin] [--timings <path>]]", t_program,
+               aoc::ARGUMENTS_USAGE);
+}
+
+// milliseconds by "<year>/<day>/parse" and "<year>/<day>/<part>"
+using Timings = std::map<std::string, double, std::less<>>;
+
+[[nodiscard]] std::string timing_key(aoc::Day const& t_day, std::string_view const t_step) {
+  return fmt::format("{}/{}/{}", t_day.year_, t_day.day_, t_step);
+}
+
+// none on the first run, or when the file isn't one of ours
+[[nodiscard]] Timings read_timings(std::string_view const t_path) {
+  std::ifstream in{std::string{t_path}};
+  if (not in.is_open()) {
+    return {};
+  }
+
+  std::ostringstream content;
+  content << in.rdbuf();
+
+  auto const json          = aoc::json::parse(content.str());
+  auto const* const object = json ? json->get_if<aoc::json::Value::Object>() : nullptr;
+  if (object == nullptr) {
+    return {};
+  }
+
+  Timings ret_val;
+  for (auto const& [key, value] : *object) {
+    if (auto const* const ms = value.get_if<double>(); ms != nullptr) {
+      ret_val.insert_or_assign(key, *ms);
+    }
+  }
+
+  return ret_val;
+}
+
+void write_timings(std::string_view const t_path, Timings const& t_timings) {
+  std::ofstream out{std::string{t_path}};
+  out << '{';
+  auto separator = "\n  ";
+  for (auto const& [key, ms] : t_timings) {
+    out << fmt::format(R"({}"{}": {:.3f})", std::exchange(separator, ",\n  "), key, ms);
+  }
+
+  out << "\n}\n";
+  if (not out) {
+    fmt::println(stderr, "unable to write the timings to {}", t_path);
+  }
+}
+
+struct PartResult {
+  aoc::Part const* part_;
+  std::string answer_;
+  Ms time_{};
+};
+
+struct DayResult {
+  aoc::Day const* day_;
+  Ms parse_{};
+  std::vector<PartResult> parts_;
+  std::optional<std::string> error_;  // why the input couldn't be read
+};
+
+// every day one after the other, printing the answers as they come
+int run_in_order(std::vector<aoc::Day> const& t_selected, aoc::Arguments const& t_options, auto const& t_is_selected) {
+  using ranges::views::filter;
+
+  Ms total_parse{};
+  Ms total_solve{};
+  std::size_t part_count = 0;
+  for (auto const& day : t_selected) {
+    auto const path = aoc::input_path(t_options, day.year_, day.day_, day.input_);
+
+    auto const parse_start = Clock::now();
+    aoc::ParsedInput parsed;
+    try {
+      parsed = day.parse_(path);
+    } catch (std::system_error const& t_error) {
+      fmt::println(stderr, "[{} day {}] unable to read input: {}", day.year_, day.day_, t_error.what());
+      return EXIT_FAILURE;
+    }
+
+    auto const parse_time = Ms{Clock::now() - parse_start};
+
+    fmt::println("[{} day {}] parse: {:.3f} ms", day.year_, day.day_, parse_time.count());
+    total_parse += parse_time;
+
+    for (auto const& part : day.parts_ | filter(t_is_selected)) {
+      auto const solve_start = Clock::now();
+      auto const answer      = part.solve_(parsed.get());
+      auto const solve_time  = Ms{Clock::now() - solve_start};
+
+      fmt::println("[{} day {} part {}] {} ({:.3f} ms)", day.year_, day.day_, part.name_, answer, solve_time.count());
+      total_solve += solve_time;
+      ++part_count;
+    }
+  }
+
+  if (part_count == 0) {
+    fmt::println(stderr, "no solution matches the given selectors");
+    return EXIT_FAILURE;
+  }
+
+  fmt::println("total: parse {:.3f} ms, solve {:.3f} ms ({} parts)", total_parse.count(), total_solve.count(),
+               part_count);
+  return EXIT_SUCCESS;
+}
+
+// Every day as jobs of a JobScheduler: the parse, then each part once the parse is done. A job is as expensive as the
+// longest chain it starts according to the previous runs (a parse is followed by its longest part), the jobs that never
+// ran yet are assumed to be the longest so that they start early
+int run_all(std::vector<aoc::Day> const& t_selected, aoc::Arguments const& t_options, RunnerOptions const& t_runner,
+            auto const& t_is_selected) {
+  using ranges::views::filter;
+
+  auto timings        = read_timings(t_runner.timings_);
+  auto const estimate = [&](std::string const& t_key) {
+    auto const iter = timings.find(t_key);
+    return iter == timings.end() ? std::numeric_limits<double>::infinity() : iter->second;
+  };
+
+  std::vector<DayResult> results;
+  for (auto const& day : t_selected) {
+    auto& result = results.emplace_back(DayResult{.day_ = &day, .parse_ = {}, .parts_ = {}, .error_ = {}});
+    for (auto const& part : day.parts_ | filter(t_is_selected)) {
+      result.parts_.push_back(PartResult{.part_ = &part, .answer_ = {}, .time_ = {}});
+    }
+  }
+
+  auto const jobs = t_runner.jobs_.value_or(std::max(std::thread::hardware_concurrency(), 1U));
+  aoc::JobScheduler scheduler{jobs, t_runner.pin_};
+  for (auto& result : results) {
+    auto const& day   = *result.day_;
+    auto longest_part = 0.0;
+    for (auto const& part : result.parts_) {
+      longest_part = std::max(longest_part, estimate(timing_key(day, part.part_->name_)));
+    }
+
+    scheduler.schedule(estimate(timing_key(day, "parse")) + longest_part, [&](aoc::JobScheduler& t_scheduler) {
+      auto const parse_start = Clock::now();
+      aoc::ParsedInput parsed;
+      try {
+        parsed = day.parse_(aoc::input_path(t_options, day.year_, day.day_, day.input_));
+      } catch (std::system_error const& t_error) {
+        result.error_ = t_error.what();
+        return;
+      }
+
+      result.parse_ = Ms{Clock::now() - parse_start};
+      for (auto& part : result.parts_) {
+        t_scheduler.schedule(estimate(timing_key(day, part.part_->name_)), [&part, parsed](aoc::JobScheduler&) {
+          auto const solve_start = Clock::now();
+          part.answer_           = part.part_->solve_(parsed.get());
+          part.time_             = Ms{Clock::now() - solve_start};
+        });
+      }
+    });
+  }
+
+  auto const start = Clock::now();
+  scheduler.run();
+  auto const wall_time = Ms{Clock::now() - start};
+
+  Ms total_parse{};
+  Ms total_solve{};
+  std::size_t part_count = 0;
+  auto failed            = false;
+  std::optional<std::pair<DayResult const*, Ms>> longest_day;  // parse and its longest part
+
+  fmt::println("{:>4} {:>3} {:<16} {:>12}  {}", "year", "day", "part", "time (ms)", "answer");
+  for (auto const& result : results) {
+    auto const& day = *result.day_;
+    if (result.error_) {
+      fmt::println(stderr, "[{} day {}] unable to read input: {}", day.year_, day.day_, *result.error_);
+      failed = true;
+      continue;
+    }
+
+    fmt::println("{:>4} {:>3} {:<16} {:>12.3f}", day.year_, day.day_, "parse", result.parse_.count());
+    timings.insert_or_assign(timing_key(day, "parse"), result.parse_.count());
+    total_parse += result.parse_;
+
+    Ms longest_part{};
+    for (auto const& part : result.parts_) {
+      fmt::println("{:>4} {:>3} {:<16} {:>12.3f}  {}", day.year_, day.day_, part.part_->name_, part.time_.count(),
+                   part.answer_);
+      timings.insert_or_assign(timing_key(day, part.part_->name_), part.time_.count());
+      total_solve += part.time_;
+      longest_part = std::max(longest_part, part.time_);
+      ++part_count;
+    }
+
+    if (not longest_day or result.parse_ + longest_part > longest_day->second) {
+      longest_day = std::pair{&result, result.parse_ + longest_part};
+    }
+  }
+
+  if (part_count == 0) {
+    if (not failed) {
+      fmt::println(stderr, "no solution matches the given selectors");
+    }
+
+    return EXIT_FAILURE;
+  }
+
+  fmt::println("total: parse {:.3f} ms, solve {:.3f} ms ({} parts), {:.3f} ms on {} jobs", total_parse.count(),
+               total_solve.count(), part_count, wall_time.count(), jobs);
+  fmt::println("longest day: {} day {} ({:.3f} ms)", longest_day->first->day_->year_, longest_day->first->day_->day_,
+               longest_day->second.count());
+
+  write_timings(t_runner.timings_, timings);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using ranges::sort, ranges::none_of, ranges::views::filter, ranges::to_vector;
+
+  auto const args    = std::span(argv, static_cast<std::size_t>(argc));
+  auto const runner  = parse_runner_options(args);
+  auto const options = runner ? aoc::parse_arguments(runner->remaining_) : std::nullopt;
+  if (not options) {
+    print_usage(args[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (options->threads_) {
+    aoc::set_thread_count(static_cast<std::size_t>(*options->threads_));
+  }
+
+  auto& days = aoc::registry();
+  sort(days, std::less<>{}, [](auto const& t_day) { return std::pair{t_day.year_, t_day.day_}; });
+
+  auto const is_selected = [&](aoc::Part const& t_part) {
+    return not options->part_ or *options->part_ == t_part.name_;
+  };
+
+  auto const selected = days | filter([&](aoc::Day const& t_day) {
+                          return (not options->year_ or *options->year_ == t_day.year_) and
+                                 (not options->day_ or *options->day_ == t_day.day_) and
+                                 not none_of(t_day.parts_, is_selected);
+                        }) |
+                        to_vector;
+
+  if (options->input_ and selected.size() > 1) {
+    fmt::println(stderr, "--input matches {} days, select a single one with --year and --day", selected.size());
+    return EXIT_FAILURE;
+  }
+
+  return runner->all_ ? run_all(selected, *options, *runner, is_selected)
+                      : run_in_order(selected, *options, is_selected);
+}